@@ -17,17 +17,22 @@
 #include "config.h"
 
 #include "sdbusplus.hpp"
+#include "telemetry.hpp"
 
 #include <CLI/CLI.hpp>
 #include <nlohmann/json.hpp>
 #include <sdbusplus/bus.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <filesystem>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <optional>
 
 using SDBusPlus = phosphor::fan::util::SDBusPlus;
+namespace telemetry = phosphor::fan::control::telemetry;
 
 constexpr auto systemdMgrIface = "org.freedesktop.systemd1.Manager";
 constexpr auto systemdPath = "/org/freedesktop/systemd1";
@@ -110,8 +115,13 @@ std::map<std::string, std::vector<std::string>>
 
 /**
  * @function consolidated function to load dbus paths and fan names
+ * @param[in] payload - The fan control telemetry, if available, which the
+ * fan names and control method are then taken from instead of D-Bus
+ * @param[in] inventory - Whether to load the fans' inventory paths
  */
-auto loadDBusData()
+auto loadDBusData(
+    const std::optional<telemetry::Payload>& payload = std::nullopt,
+    bool inventory = true)
 {
     auto& bus{SDBusPlus::getBus()};
 
@@ -135,14 +145,35 @@ auto loadDBusData()
          "/xyz/openbmc_project/inventory/system/chassis/motherboard"},
         {"tach", "/xyz/openbmc_project/sensors/fan_tach"}};
 
-    // build a list of all fans
-    for (auto& path : SDBusPlus::getSubTreePathsRaw(bus, paths["tach"],
-                                                    interfaces["FanSpeed"], 0))
+    if (payload && payload->numFans)
     {
-        // special case where we build the list of fans
-        auto fan = justFanName(path);
-        fan = fan.substr(0, fan.rfind("_"));
-        fanNames.push_back(fan);
+        // fan control already knows its fans and their configured sensors
+        for (uint32_t i = 0; i < payload->numFans; i++)
+        {
+            const auto& fan = payload->fans[i];
+            fanNames.emplace_back(fan.name);
+            if (fan.numSensors != 0)
+            {
+                auto& tachPaths = pathMap["tach"][fan.name];
+                tachPaths.assign(fan.sensors, fan.sensors + fan.numSensors);
+            }
+        }
+        if (payload->fans[0].pwm)
+        {
+            method = "PWM";
+        }
+    }
+    else
+    {
+        // build a list of all fans
+        for (auto& path : SDBusPlus::getSubTreePathsRaw(
+                 bus, paths["tach"], interfaces["FanSpeed"], 0))
+        {
+            // special case where we build the list of fans
+            auto fan = justFanName(path);
+            fan = fan.substr(0, fan.rfind("_"));
+            fanNames.push_back(fan);
+        }
     }
 
     // retry with PWM mode if none found
@@ -160,17 +191,29 @@ auto loadDBusData()
         }
     }
 
-    // load tach sensor paths for each fan
-    pathMap["tach"] =
-        getPathsFromIface(paths["tach"], interfaces["SensorValue"], fanNames);
+    // load tach sensor paths for each fan fan control didn't give them for,
+    // matching the sensor names against the fan names
+    std::vector<std::string> unmatched;
+    std::copy_if(fanNames.begin(), fanNames.end(),
+                 std::back_inserter(unmatched), [&pathMap](const auto& fan) {
+                     return !pathMap["tach"].contains(fan);
+                 });
+    if (!unmatched.empty())
+    {
+        pathMap["tach"].merge(getPathsFromIface(
+            paths["tach"], interfaces["SensorValue"], unmatched));
+    }
 
-    // load inventory Item data for each fan
-    pathMap["inventory"] = getPathsFromIface(
-        paths["motherboard"], interfaces["Item"], fanNames, true);
+    if (inventory)
+    {
+        // load inventory Item data for each fan
+        pathMap["inventory"] = getPathsFromIface(
+            paths["motherboard"], interfaces["Item"], fanNames, true);
 
-    // load operational status data for each fan
-    pathMap["opstatus"] = getPathsFromIface(
-        paths["motherboard"], interfaces["OpStatus"], fanNames, true);
+        // load operational status data for each fan
+        pathMap["opstatus"] = getPathsFromIface(
+            paths["motherboard"], interfaces["OpStatus"], fanNames, true);
+    }
 
     return std::make_tuple(fanNames, pathMap, interfaces, method);
 }
@@ -244,6 +287,65 @@ std::string ifaceTypeFromMethod(const std::string& method)
     return (method == "RPM" ? "FanSpeed" : "FanPwm");
 }
 
+/**
+ * @function gets a fan's target from the fan control telemetry, falling back
+ * to reading it off D-Bus when fan control isn't publishing the fan.
+ * @param[in] payload - The fan control telemetry, if available
+ * @param[in] fan - The fan name
+ * @param[in] path - D-Bus path of the fan's target sensor
+ * @param[in] iface - D-Bus interface of the target property
+ * @return the fan's target
+ */
+uint64_t getTarget(const std::optional<telemetry::Payload>& payload,
+                   const std::string& fan, const std::string& path,
+                   const std::string& iface)
+{
+    if (payload)
+    {
+        auto end = payload->fans + payload->numFans;
+        auto itFan = std::find_if(payload->fans, end, [&fan](const auto& f) {
+            return fan == f.name;
+        });
+        if (itFan != end)
+        {
+            return itFan->target;
+        }
+    }
+
+    return SDBusPlus::getProperty<uint64_t>(path, iface, "Target");
+}
+
+/**
+ * @function prints the zones' state from the fan control telemetry
+ * @param[in] payload - The fan control telemetry
+ */
+void printZones(const telemetry::Payload& payload)
+{
+    using std::cout;
+    using std::endl;
+    using std::setw;
+
+    cout << "ZONE      TARGET     FLOOR      CEILING    TARGET HOLDS"
+         << "   FLOOR HOLDS   ACTIVE" << endl;
+    cout << "====================================================="
+         << "=========================" << endl;
+
+    for (uint32_t i = 0; i < payload.numZones; i++)
+    {
+        const auto& zone = payload.zones[i];
+        cout << std::left << setw(10) << zone.name << setw(11) << zone.target
+             << setw(11) << zone.floor << setw(11) << zone.ceiling
+             << setw(15)
+             << (std::to_string(zone.numTargetHolds) + " (" +
+                 std::to_string(zone.targetHold) + ")")
+             << setw(14)
+             << (std::to_string(zone.numFloorHolds) + " (" +
+                 std::to_string(zone.floorHold) + ")")
+             << std::boolalpha << static_cast<bool>(zone.active) << std::right
+             << endl;
+    }
+}
+
 /**
  * @function performs the "status" command from the cmdline.
  * get states and sensor data and output to the console
@@ -254,7 +356,8 @@ void status()
     using std::endl;
     using std::setw;
 
-    auto busData = loadDBusData();
+    auto payload = telemetry::read();
+    auto busData = loadDBusData(payload);
     auto& method = std::get<METHOD>(busData);
 
     std::string property;
@@ -270,6 +373,11 @@ void status()
     cout << "CurrentPowerState   : " << states[4] << endl;
     cout << "CurrentHostState    : " << states[5] << endl;
     cout << endl;
+    if (payload)
+    {
+        printZones(*payload);
+        cout << endl;
+    }
     cout << "FAN       "
          << "TARGET(" << method << ")     FEEDBACKS(RPM)   PRESENT"
          << "   FUNCTIONAL" << endl;
@@ -282,13 +390,13 @@ void status()
 
     for (auto& fan : fanNames)
     {
+        if (pathMap["tach"][fan].size() == 0)
+            continue;
         cout << setw(8) << std::left << fan << std::right << setw(13);
 
         // get the target RPM
-        property = "Target";
-        cout << SDBusPlus::getProperty<uint64_t>(
-                    pathMap["tach"][fan][0],
-                    interfaces[ifaceTypeFromMethod(method)], property)
+        cout << getTarget(payload, fan, pathMap["tach"][fan][0],
+                          interfaces[ifaceTypeFromMethod(method)])
              << setw(19);
 
         // get the sensor RPM
@@ -371,7 +479,8 @@ void get()
     using std::endl;
     using std::setw;
 
-    auto busData = loadDBusData();
+    auto payload = telemetry::read();
+    auto busData = loadDBusData(payload, false);
 
     auto& fanNames{std::get<FAN_NAMES>(busData)};
     auto& pathMap{std::get<PATH_MAP>(busData)};
@@ -396,10 +505,8 @@ void get()
         cout << setw(13) << std::left << shortPath << std::right << setw(15);
 
         // print its target RPM/PWM
-        property = "Target";
-        cout << SDBusPlus::getProperty<uint64_t>(
-            pathMap["tach"][fan][0], interfaces[ifaceTypeFromMethod(method)],
-            property);
+        cout << getTarget(payload, fan, pathMap["tach"][fan][0],
+                          interfaces[ifaceTypeFromMethod(method)]);
 
         // print readings for each rotor
         property = "Value";
@@ -131,29 +131,31 @@ def convertToMap(listOfDict):
     return listOfDict
 
 
+# Dense group ids, by the groups' (object, interface, property) members
+group_ids = {}
+
+
+def getGroupId(groups):
+    """
+    Returns the id of the group made up of the given groups' members,
+    assigning it the next id when those members have not been seen before.
+    """
+    key = tuple((m['object'], m['interface'], m['property'])
+                for g in groups for m in g['members'])
+    return group_ids.setdefault(key, len(group_ids))
+
+
 def genEvent(event):
     """
     Generates the source code of an event and returns it as a string
     """
     e = "SetSpeedEvent{\n"
     e += "\"" + event['name'] + "\",\n"
-    e += "Group{\n"
-    for group in event['groups']:
-        for member in group['members']:
-            e += "{\"" + member['object'] + "\",\n"
-            e += "\"" + member['interface'] + "\",\n"
-            e += "\"" + member['property'] + "\"},\n"
-    e += "},\n"
+    e += "Group{GroupId{" + str(getGroupId(event['groups'])) + "}},\n"
 
     e += "ActionData{\n"
     for d in event['action']:
-        e += "{Group{\n"
-        for g in d['groups']:
-            for m in g['members']:
-                e += "{\"" + m['object'] + "\",\n"
-                e += "\"" + m['interface'] + "\",\n"
-                e += "\"" + m['property'] + "\"},\n"
-        e += "},\n"
+        e += "{Group{GroupId{" + str(getGroupId(d['groups'])) + "}},\n"
         e += "std::vector<Action>{\n"
         for a in d['actions']:
             if len(a['parameters']) != 0:
@@ -315,14 +317,8 @@ def getParameters(member, groups, section, events):
                 if (p != 'group'):
                     params[p] = "\"" + member[p] + "\""
                 else:
-                    params[p] = "Group\n{\n"
-                    for g in groups:
-                        for m in g['members']:
-                            params[p] += (
-                                "{\"" + str(m['object']) + "\",\n" +
-                                "\"" + str(m['interface']) + "\",\n" +
-                                "\"" + str(m['property']) + "\"},\n")
-                    params[p] += "}"
+                    params[p] = ("Group{GroupId{" +
+                                 str(getGroupId(groups)) + "}}")
             else:
                 params[p] = member[p]
         params['params'] = plist
@@ -927,4 +923,6 @@ if __name__ == '__main__':
     tmpl = lkup.get_template('fan_zone_defs.mako.cpp')
     with open(output_file, 'w') as output:
         output.write(tmpl.render(zones=zone_config,
-                                 mgr_data=manager_config))
+                                 mgr_data=manager_config,
+                                 group_id=getGroupId,
+                                 group_ids=group_ids))
@@ -0,0 +1,263 @@
+#!/usr/bin/env python3
+
+"""
+This script reads in a machine's JSON fan control configuration files and
+generates a translation unit containing them, for fan control to use in
+place of finding and reading the files at runtime. The groups and the
+floor tables of the mapped_floor actions are generated as constexpr
+tables, so they aren't parsed from JSON at runtime.
+"""
+
+import json
+import math
+import os
+import re
+import sys
+from argparse import ArgumentParser
+from mako.lookup import TemplateLookup
+
+# The configuration files, in the order they're loaded
+conf_files = ['profiles.json', 'zones.json', 'fans.json', 'groups.json',
+              'events.json']
+
+# The configuration files that must be given
+required_files = ['zones.json', 'fans.json']
+
+# What the configuration's contents are quoted with in the generated code
+raw_delimiter = 'cfg'
+
+
+def strip_comments(text):
+    """
+    Remove the // and /* */ comments nlohmann::json allows from the
+    JSON text, leaving any within strings.
+    """
+
+    pattern = re.compile(r'"(?:\\.|[^"\\])*"|//[^\n]*|/\*.*?\*/', re.DOTALL)
+    return pattern.sub(
+        lambda match: match.group(0) if match.group(0)[0] == '"' else '',
+        text)
+
+
+def load_config(dirs, file_name):
+    """
+    Load a configuration file from the first of the directories it's
+    found in, the same as fan control would search through the
+    compatible system names at runtime.
+    """
+
+    for conf_dir in dirs:
+        path = os.path.join(conf_dir, file_name)
+        if os.path.exists(path):
+            with open(path, 'r') as conf_input:
+                try:
+                    return json.loads(strip_comments(conf_input.read()))
+                except ValueError as e:
+                    sys.exit("{}: {}".format(path, e))
+    return None
+
+
+def get_names(entries):
+    """
+    Get the names of a configuration file's entries.
+    """
+
+    return {entry['name'] for entry in entries or [] if 'name' in entry}
+
+
+def warn(message):
+    """
+    Print a warning about the configuration, which fan control tolerates.
+    """
+
+    print("Warning: " + message, file=sys.stderr)
+
+
+def validate(configs):
+    """
+    Check the configuration files are lists, and warn about references
+    between them that fan control would ignore when loading them.
+    """
+
+    for file_name in required_files:
+        if configs.get(file_name) is None:
+            sys.exit("Missing required configuration {}".format(file_name))
+
+    for file_name, entries in configs.items():
+        if not isinstance(entries, list):
+            sys.exit("{}: Configuration must be a list".format(file_name))
+
+    zones = get_names(configs['zones.json'])
+    for fan in configs['fans.json']:
+        if fan.get('zone') not in zones:
+            warn("fans.json: Fan {} is in unknown zone {}".format(
+                fan.get('name'), fan.get('zone')))
+
+    groups = get_names(configs.get('groups.json'))
+    for event in configs.get('events.json') or []:
+        event_groups = list(event.get('groups', []))
+        for action in event.get('actions', []):
+            event_groups.extend(action.get('groups', []))
+        for group in event_groups:
+            if group.get('name') not in groups:
+                warn("events.json: Event {} uses unknown group {}".format(
+                    event.get('name'), group.get('name')))
+
+
+def cpp_string(value):
+    """
+    Get a string as a C++ string_view literal.
+    """
+
+    return json.dumps(value) + 'sv'
+
+
+def cpp_value(value, where):
+    """
+    Get a JSON value as a C++ FloorValue, with any number as a double as
+    fan control compares them.
+    """
+
+    if isinstance(value, bool):
+        return 'true' if value else 'false'
+    if isinstance(value, (int, float)):
+        if not math.isfinite(value):
+            sys.exit("{}: Value {} isn't finite".format(where, value))
+        return 'double{{{}}}'.format(repr(float(value)))
+    if isinstance(value, str):
+        return cpp_string(value)
+    sys.exit("{}: Unsupported value {}".format(where, json.dumps(value)))
+
+
+def get_groups(entries):
+    """
+    Get the groups, with their members as indices into a list of every
+    member path.
+    """
+
+    paths = []
+    ids = {}
+    groups = []
+    for group in entries or []:
+        if 'name' not in group or 'members' not in group:
+            sys.exit("groups.json: Group missing its name or members")
+        members = []
+        for path in group['members']:
+            if path not in ids:
+                ids[path] = len(paths)
+                paths.append(path)
+            members.append(ids[path])
+        groups.append({
+            'name': cpp_string(group['name']),
+            'service': cpp_string(group.get('service', '')),
+            'profiles': [cpp_string(p) for p in group.get('profiles', [])],
+            'members': members})
+    return [cpp_string(path) for path in paths], groups
+
+
+def get_floor_table(event, action):
+    """
+    Get a mapped_floor action's floor table.
+    """
+
+    where = "events.json: Event {} mapped_floor".format(event.get('name'))
+    if 'fan_floors' not in action:
+        sys.exit("{}: Missing fan_floors".format(where))
+
+    table = []
+    for fan_floors in action['fan_floors']:
+        if 'key' not in fan_floors or 'floors' not in fan_floors:
+            sys.exit("{}: Missing key or floors".format(where))
+        floor_groups = []
+        for floor_group in fan_floors['floors']:
+            if (('group' not in floor_group and
+                 'parameter' not in floor_group) or
+                    'floors' not in floor_group):
+                sys.exit("{}: Missing group, parameter, or floors".format(
+                    where))
+            floors = []
+            for entry in floor_group['floors']:
+                if 'value' not in entry or 'floor' not in entry:
+                    sys.exit("{}: Missing value or floor".format(where))
+                floors.append((cpp_value(entry['value'], where),
+                               int(entry['floor'])))
+            floor_groups.append({
+                'group': cpp_string(floor_group.get('group', '')),
+                'parameter': cpp_string(
+                    '' if 'group' in floor_group
+                    else floor_group['parameter']),
+                'floors': floors})
+        default_floor = fan_floors.get('default_floor')
+        table.append({
+            'key': cpp_value(fan_floors['key'], where),
+            'offset_parameter': cpp_string(
+                fan_floors.get('floor_offset_parameter', '')),
+            'default_floor': 'std::nullopt' if default_floor is None
+            else int(default_floor),
+            'floor_groups': floor_groups})
+    return table
+
+
+def compile_floor_tables(events):
+    """
+    Move the floor tables of the mapped_floor actions out of the events,
+    leaving the index of each action's table in its place.
+    """
+
+    tables = []
+    for event in events or []:
+        for action in event.get('actions', []):
+            if action.get('name') != 'mapped_floor':
+                continue
+            tables.append(get_floor_table(event, action))
+            del action['fan_floors']
+            action['compiled_floors'] = len(tables) - 1
+    return tables
+
+
+if __name__ == '__main__':
+    parser = ArgumentParser(
+        description="Phosphor fan control JSON configuration compiler")
+
+    parser.add_argument('-d', '--config_dir', dest='config_dirs',
+                        action='append', default=[],
+                        help='configuration directory, given in priority '
+                             'order when more than one')
+    parser.add_argument('-o', '--output_dir', dest='output_dir',
+                        default=".",
+                        help='output directory')
+    args = parser.parse_args()
+
+    if not args.config_dirs:
+        parser.print_usage()
+        sys.exit(1)
+
+    configs = {}
+    for file_name in conf_files:
+        entries = load_config(args.config_dirs, file_name)
+        if entries is not None:
+            configs[file_name] = entries
+
+    validate(configs)
+
+    paths, groups = get_groups(configs.get('groups.json'))
+    floor_tables = compile_floor_tables(configs.get('events.json'))
+
+    contents = []
+    for file_name, entries in configs.items():
+        text = json.dumps(entries, separators=(',', ':'))
+        if ')' + raw_delimiter + '"' in text:
+            sys.exit("{}: Contains the raw string delimiter".format(
+                file_name))
+        contents.append((file_name, text))
+
+    tmpls_dir = os.path.join(
+        os.path.dirname(os.path.realpath(__file__)),
+        "templates")
+    output_file = os.path.join(args.output_dir, "json_config_defs.cpp")
+    lkup = TemplateLookup(directories=tmpls_dir.split())
+    tmpl = lkup.get_template('json_config_defs.mako.cpp')
+    with open(output_file, 'w') as output:
+        output.write(tmpl.render(configs=contents, delimiter=raw_delimiter,
+                                 paths=paths, groups=groups,
+                                 floor_tables=floor_tables))
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "../utils/change_tracker.hpp"
 #include "../utils/flight_recorder.hpp"
 #include "../zone.hpp"
 #include "config_base.hpp"
@@ -31,6 +32,9 @@
 #include <map>
 #include <memory>
 #include <numeric>
+#include <optional>
+#include <set>
+#include <utility>
 
 namespace phosphor::fan::control::json
 {
@@ -106,7 +110,13 @@ class ActionBase : public ConfigBase
     ActionBase(ActionBase&&) = delete;
     ActionBase& operator=(const ActionBase&) = delete;
     ActionBase& operator=(ActionBase&&) = delete;
-    virtual ~ActionBase() = default;
+    virtual ~ActionBase()
+    {
+        if (_changes)
+        {
+            ChangeTracker::untrack(*_changes, _groups);
+        }
+    }
 
     /**
      * @brief Base action object
@@ -175,6 +185,22 @@ class ActionBase : public ConfigBase
      */
     virtual void run(Zone& zone) = 0;
 
+    /**
+     * @brief Run the action given the group members that changed since it
+     *        last ran
+     *
+     * Used instead of run(Zone&) for actions that track their groups'
+     * changes, so they can update their results from only the changed
+     * members. The same changes are given for each of the action's zones.
+     *
+     * @param[in] zone - Zone to run the action on
+     * @param[in] changes - The changed group members
+     */
+    virtual void runIncremental(Zone& zone, const ChangeSet& /*changes*/)
+    {
+        run(zone);
+    }
+
     /**
      * @brief Trigger the action to run against all of its zones
      *
@@ -183,8 +209,51 @@ class ActionBase : public ConfigBase
      */
     void run()
     {
+        _runCount++;
+        if (!_changes)
+        {
+            std::for_each(_zones.begin(), _zones.end(),
+                          [this](Zone& zone) { this->run(zone); });
+            return;
+        }
+
+        if (_zones.empty())
+        {
+            // Keep the changes for when there's a zone to apply them to
+            return;
+        }
+
+        // Changes made by running are left for the next run
+        ChangeSet changes;
+        changes.all = std::exchange(_changes->all, false);
+        changes.members.swap(_changes->members);
         std::for_each(_zones.begin(), _zones.end(),
-                      [this](Zone& zone) { this->run(zone); });
+                      [this, &changes](Zone& zone) {
+                          this->runIncremental(zone, changes);
+                      });
+    }
+
+    /**
+     * @brief Get the number of times the action was triggered to run
+     *
+     * @return The action's run count
+     */
+    inline auto getRunCount() const
+    {
+        return _runCount;
+    }
+
+    /**
+     * @brief Get the names of the parameters the action sets
+     *
+     * Used to order the actions run when parameters change, so actions that
+     * set parameters must return them here.
+     *
+     * @return List of parameter names
+     */
+    virtual std::vector<std::string> getSetParameters() const
+    {
+        return {};
     }
 
     /**
@@ -197,6 +266,25 @@ class ActionBase : public ConfigBase
         return _uniqueName;
     }
 
+    /**
+     * @brief Returns the identifier of the holds the action sets on its
+     * zones, interned from its unique name
+     *
+     * The name is only interned the first time the action sets a hold, so
+     * it includes the event name and isn't interned until the manager has
+     * released the identifiers of the configuration being replaced.
+     *
+     * @return HoldId - The hold identifier
+     */
+    HoldId getHoldId()
+    {
+        if (!_holdId)
+        {
+            _holdId = HoldIds::intern(HoldScope::action, _uniqueName);
+        }
+        return *_holdId;
+    }
+
     /**
      * @brief Set the name of the owning Event.
      *
@@ -233,6 +321,28 @@ class ActionBase : public ConfigBase
     }
 
   protected:
+    /**
+     * @brief Get the names of the parameters a list of nested actions set
+     *
+     * Actions that run other actions return these from getSetParameters(),
+     * since running them ends up setting them.
+     *
+     * @param[in] actions - The nested actions
+     *
+     * @return List of parameter names, without duplicates
+     */
+    static std::vector<std::string> getNestedSetParameters(
+        const std::vector<std::unique_ptr<ActionBase>>& actions)
+    {
+        std::set<std::string> params;
+        for (const auto& action : actions)
+        {
+            auto setParams = action->getSetParameters();
+            params.insert(setParams.begin(), setParams.end());
+        }
+        return {params.begin(), params.end()};
+    }
+
     /**
      * @brief Logs a message to the flight recorder using
      *        the unique name of the action.
@@ -244,6 +354,18 @@ class ActionBase : public ConfigBase
         FlightRecorder::instance().log(getUniqueName(), message);
     }
 
+    /**
+     * @brief Have the action run with runIncremental(), tracking the
+     *        changes to its groups' members
+     *
+     * Called from the constructor of actions that support it.
+     */
+    void trackChanges()
+    {
+        _changes.emplace();
+        ChangeTracker::track(*_changes, _groups);
+    }
+
     /* Groups configured on the action */
     const std::vector<Group> _groups;
 
@@ -255,6 +377,17 @@ class ActionBase : public ConfigBase
      * It's just the name plus _actionCount at the time of action creation. */
     std::string _uniqueName;
 
+    /* Interned identifier of the unique name, for setting zone holds,
+     * interned on first use */
+    std::optional<HoldId> _holdId;
+
+    /* Number of times the action was triggered to run */
+    uint64_t _runCount = 0;
+
+    /* The changes to the groups' members since the action last ran,
+     * when it tracks them */
+    std::optional<ChangeSet> _changes;
+
     /* Running count of all actions */
     static inline size_t _actionCount = 0;
 };
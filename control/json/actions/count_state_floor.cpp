@@ -16,6 +16,7 @@
 #include "count_state_floor.hpp"
 
 #include "../manager.hpp"
+#include "../utils/group_reduction.hpp"
 #include "../zone.hpp"
 #include "action.hpp"
 #include "group.hpp"
@@ -34,22 +35,36 @@ CountStateFloor::CountStateFloor(const json& jsonObj,
 
 void CountStateFloor::run(Zone& zone)
 {
+    if (_numericRanges.empty())
+    {
+        _numericRanges = Manager::getNumericRanges(_groups);
+    }
+
+    auto dblState = std::get_if<double>(&_state);
     size_t numAtState = 0;
-    for (const auto& group : _groups)
+    for (size_t i = 0; i < _groups.size(); i++)
     {
-        for (const auto& member : group.getMembers())
+        const auto& group = _groups[i];
+
+        // Groups of only doubles are counted from their numeric column
+        if (dblState && _numericRanges[i].allNumeric())
         {
-            try
+            numAtState += reduction::countEqual(_numericRanges[i], *dblState);
+            if (numAtState >= _count)
             {
-                if (Manager::getObjValueVariant(member, group.getInterface(),
-                                                group.getProperty()) == _state)
-                {
-                    numAtState++;
-                }
+                break;
             }
-            catch (const std::out_of_range& oore)
+            continue;
+        }
+
+        for (const auto& member : group.getMembers())
+        {
+            // Default to property not equal when not found
+            auto value = Manager::getObjValuePtr(member, group.getInterface(),
+                                                 group.getProperty());
+            if (value && (*value == _state))
             {
-                // Default to property not equal when not found
+                numAtState++;
             }
             if (numAtState >= _count)
             {
@@ -63,7 +78,7 @@ void CountStateFloor::run(Zone& zone)
     }
 
     // Update zone's floor hold based on action results
-    zone.setFloorHold(getUniqueName(), _floor, (numAtState >= _count));
+    zone.setFloorHold(getHoldId(), _floor, (numAtState >= _count));
 }
 
 void CountStateFloor::setCount(const json& jsonObj)
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "../utils/numeric_column.hpp"
 #include "../zone.hpp"
 #include "action.hpp"
 #include "group.hpp"
@@ -112,6 +113,10 @@ class CountStateFloor :
 
     /* Floor for this action */
     uint64_t _floor;
+
+    /* The numeric column ranges of the groups' values, found on the
+     * first run */
+    std::vector<NumericRange> _numericRanges;
 };
 
 } // namespace phosphor::fan::control::json
@@ -16,6 +16,7 @@
 #include "count_state_target.hpp"
 
 #include "../manager.hpp"
+#include "../utils/group_reduction.hpp"
 #include "../zone.hpp"
 #include "action.hpp"
 #include "group.hpp"
@@ -36,40 +37,84 @@ CountStateTarget::CountStateTarget(const json& jsonObj,
     setCount(jsonObj);
     setState(jsonObj);
     setTarget(jsonObj);
+
+    for (const auto& group : _groups)
+    {
+        _atState.emplace_back(group.getMembers().size(), 0);
+    }
+    trackChanges();
 }
 
 void CountStateTarget::run(Zone& zone)
 {
-    size_t numAtState = 0;
-    for (const auto& group : _groups)
+    // Without the changes, every member is checked
+    runIncremental(zone, ChangeSet{});
+}
+
+void CountStateTarget::runIncremental(Zone& zone, const ChangeSet& changes)
+{
+    if (changes.all)
+    {
+        countAll();
+    }
+    else
+    {
+        for (const auto& [group, member] : changes.members)
+        {
+            updateMember(group, member);
+        }
+    }
+
+    // Update zone's target hold based on action results
+    zone.setTargetHold(getHoldId(), _target, (_numAtState >= _count));
+}
+
+void CountStateTarget::countAll()
+{
+    if (_numericRanges.empty())
+    {
+        _numericRanges = Manager::getNumericRanges(_groups);
+    }
+
+    auto dblState = std::get_if<double>(&_state);
+    _numAtState = 0;
+    for (size_t group = 0; group < _groups.size(); group++)
     {
-        for (const auto& member : group.getMembers())
+        auto& atState = _atState[group];
+
+        // Groups of only doubles are compared from their numeric column
+        if (dblState && _numericRanges[group].allNumeric())
         {
-            try
-            {
-                if (Manager::getObjValueVariant(member, group.getInterface(),
-                                                group.getProperty()) == _state)
-                {
-                    numAtState++;
-                }
-            }
-            catch (const std::out_of_range& oore)
-            {
-                // Default to property not equal when not found
-            }
-            if (numAtState >= _count)
-            {
-                break;
-            }
+            _numAtState += reduction::markEqual(_numericRanges[group],
+                                                *dblState, atState.data());
+            continue;
         }
-        if (numAtState >= _count)
+
+        for (size_t member = 0; member < atState.size(); member++)
         {
-            break;
+            atState[member] = isAtState(group, member);
+            _numAtState += atState[member];
         }
     }
+}
 
-    // Update zone's target hold based on action results
-    zone.setTargetHold(getUniqueName(), _target, (numAtState >= _count));
+bool CountStateTarget::isAtState(size_t group, size_t member) const
+{
+    const auto& grp = _groups[group];
+    // Default to property not equal when not found
+    auto value = Manager::getObjValuePtr(grp.getMembers()[member],
+                                         grp.getInterface(), grp.getProperty());
+    return value && (*value == _state);
+}
+
+void CountStateTarget::updateMember(size_t group, size_t member)
+{
+    bool atState = isAtState(group, member);
+    if (atState != static_cast<bool>(_atState[group][member]))
+    {
+        _atState[group][member] = atState;
+        atState ? _numAtState++ : _numAtState--;
+    }
 }
 
 void CountStateTarget::setCount(const json& jsonObj)
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "../utils/numeric_column.hpp"
 #include "../zone.hpp"
 #include "action.hpp"
 #include "group.hpp"
@@ -70,6 +71,17 @@ class CountStateTarget :
      */
     void run(Zone& zone) override;
 
+    /**
+     * @brief Run the action from the members that changed
+     *
+     * Keeps a running count of the members at the given state, updated
+     * from only the members that changed since the action last ran.
+     *
+     * @param[in] zone - Zone to run the action on
+     * @param[in] changes - The changed group members
+     */
+    void runIncremental(Zone& zone, const ChangeSet& changes) override;
+
   private:
     /* Number of group members */
     size_t _count;
@@ -83,6 +95,16 @@ class CountStateTarget :
     /* Unique id of this action */
     size_t _id;
 
+    /* The numeric column ranges of the groups' values, found when every
+     * member is first checked */
+    std::vector<NumericRange> _numericRanges;
+
+    /* Whether each group member is at the state(0 or 1), by group */
+    std::vector<std::vector<uint8_t>> _atState;
+
+    /* Running count of the group members at the state */
+    size_t _numAtState = 0;
+
     /**
      * @brief Parse and set the count
      *
@@ -109,6 +131,30 @@ class CountStateTarget :
      * Sets the target to use when running the action
      */
     void setTarget(const json& jsonObj);
+
+    /**
+     * @brief Recount the members at the state from every member's cached
+     *        value
+     */
+    void countAll();
+
+    /**
+     * @brief Get whether a member's cached value is at the state
+     *
+     * @param[in] group - Index of the member's group
+     * @param[in] member - Index of the member within its group
+     *
+     * @return Whether the member is at the state
+     */
+    bool isAtState(size_t group, size_t member) const;
+
+    /**
+     * @brief Update the running count from a member's cached value
+     *
+     * @param[in] group - Index of the member's group
+     * @param[in] member - Index of the member within its group
+     */
+    void updateMember(size_t group, size_t member);
 };
 
 } // namespace phosphor::fan::control::json
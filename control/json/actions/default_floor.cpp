@@ -37,20 +37,20 @@ DefaultFloor::DefaultFloor(const json& jsonObj,
 
 void DefaultFloor::run(Zone& zone)
 {
-    for (const auto& group : _groups)
+    if (_missingOwners.empty())
     {
-        const auto& members = group.getMembers();
-        auto isMissingOwner =
-            std::any_of(members.begin(), members.end(),
-                        [&intf = group.getInterface()](const auto& member) {
-                            return !Manager::hasOwner(member, intf);
-                        });
+        _missingOwners = Manager::getMissingOwnerCounts(_groups);
+    }
+
+    for (size_t i = 0; i < _groups.size(); i++)
+    {
+        auto isMissingOwner = (*_missingOwners[i] != 0);
         if (isMissingOwner)
         {
             zone.setFloor(zone.getDefaultFloor());
         }
         // Update fan control floor change allowed
-        zone.setFloorChangeAllow(group.getName(), !isMissingOwner);
+        zone.setFloorChangeAllow(_groups[i].getName(), !isMissingOwner);
     }
 }
 
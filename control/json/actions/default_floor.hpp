@@ -21,6 +21,8 @@
 
 #include <nlohmann/json.hpp>
 
+#include <vector>
+
 namespace phosphor::fan::control::json
 {
 
@@ -64,6 +66,10 @@ class DefaultFloor : public ActionBase, public ActionRegister<DefaultFloor>
      * @param[in] zone - Zone to run the action on
      */
     void run(Zone& zone) override;
+
+  private:
+    /* The groups' missing owner counts, found on the first run */
+    std::vector<const size_t*> _missingOwners;
 };
 
 } // namespace phosphor::fan::control::json
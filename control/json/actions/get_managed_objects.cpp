@@ -34,6 +34,10 @@ void GetManagedObjects::run(Zone& zone)
 {
     std::set<std::string> services;
 
+    // The ObjectManager paths of each service, found once per run rather
+    // than searching the service tree again for every member
+    std::map<std::string, std::vector<std::string>> servObjMgrPaths;
+
     // Call Manager::addObjects to refresh the values of the group members.
     // If there is an ObjectManager interface that handles them, then
     // the code can combine all members in the same service down to one call.
@@ -42,20 +46,26 @@ void GetManagedObjects::run(Zone& zone)
     {
         for (const auto& member : group.getMembers())
         {
-            std::vector<std::string> objMgrPaths;
-
             const auto& service =
                 zone.getManager()->getService(member, group.getInterface());
 
-            if (!service.empty())
+            if (service.empty())
             {
-                objMgrPaths = zone.getManager()->getPaths(
-                    service, "org.freedesktop.DBus.ObjectManager");
+                continue;
             }
-            else
+
+            auto itPaths = servObjMgrPaths.find(service);
+            if (itPaths == servObjMgrPaths.end())
             {
-                continue;
+                itPaths =
+                    servObjMgrPaths
+                        .emplace(service,
+                                 zone.getManager()->getPaths(
+                                     service,
+                                     "org.freedesktop.DBus.ObjectManager"))
+                        .first;
             }
+            const auto& objMgrPaths = itPaths->second;
 
             // Look for the ObjectManager as an ancestor of the path.
             auto hasObjMgr =
@@ -100,6 +100,16 @@ class GetManagedObjects :
      */
     void setZones(std::vector<std::reference_wrapper<Zone>>& zones) override;
 
+    /**
+     * @brief Get the names of the parameters the embedded actions set
+     *
+     * @return List of parameter names
+     */
+    std::vector<std::string> getSetParameters() const override
+    {
+        return getNestedSetParameters(_actions);
+    }
+
   private:
     /**
      * @brief Parse and set the list of actions
@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "config.h"
+
 #include "mapped_floor.hpp"
 
 #include "../manager.hpp"
@@ -31,6 +33,35 @@ namespace phosphor::fan::control::json
 
 using json = nlohmann::json;
 
+/**
+ * @brief Get whether a value is numeric.  Unlike std::is_arithmetic,
+ *        bools are not considered numeric.
+ */
+bool isNumeric(const PropertyVariantType& value)
+{
+    return std::holds_alternative<double>(value) ||
+           std::holds_alternative<int32_t>(value) ||
+           std::holds_alternative<int64_t>(value);
+}
+
+/**
+ * @brief Converts the variant to a double if it's a
+ *        int32_t or int64_t.
+ */
+void tryConvertToDouble(PropertyVariantType& value)
+{
+    std::visit(
+        [&value](auto&& val) {
+            using V = std::decay_t<decltype(val)>;
+            if constexpr (std::is_same_v<int32_t, V> ||
+                          std::is_same_v<int64_t, V>)
+            {
+                value = static_cast<double>(val);
+            }
+        },
+        value);
+}
+
 template <typename T>
 uint64_t addFloorOffset(uint64_t floor, T offset, const std::string& actionName)
 {
@@ -59,6 +90,14 @@ MappedFloor::MappedFloor(const json& jsonObj,
     setKeyGroup(jsonObj);
     setFloorTable(jsonObj);
     setDefaultFloor(jsonObj);
+
+    _groupValues.resize(_groups.size());
+    _nonNumeric.resize(_groups.size(), 0);
+    for (const auto& group : _groups)
+    {
+        _memberValues.emplace_back(group.getMembers().size());
+    }
+    trackChanges();
 }
 
 const Group* MappedFloor::getGroup(const std::string& name)
@@ -97,6 +136,21 @@ void MappedFloor::setDefaultFloor(const json& jsonObj)
 
 void MappedFloor::setFloorTable(const json& jsonObj)
 {
+#ifdef CONTROL_USE_COMPILED_JSON
+    if (jsonObj.contains("compiled_floors"))
+    {
+        auto table =
+            compiled::getFloorTable(jsonObj["compiled_floors"].get<size_t>());
+        if (!table)
+        {
+            throw ActionParseError{ActionBase::getName(),
+                                   "Unknown compiled_floors table"};
+        }
+        setFloorTable(*table);
+        return;
+    }
+#endif
+
     if (!jsonObj.contains("fan_floors"))
     {
         throw ActionParseError{ActionBase::getName(),
@@ -114,8 +168,11 @@ void MappedFloor::setFloorTable(const json& jsonObj)
                 "Missing key or floors entries in actions/fan_floors JSON"};
         }
 
+        // Numeric values are converted to doubles up front, as the values
+        // they're compared to are
         FanFloors ff;
         ff.keyValue = getJsonValue(floors["key"]);
+        tryConvertToDouble(ff.keyValue);
 
         if (floors.contains("floor_offset_parameter"))
         {
@@ -165,6 +222,7 @@ void MappedFloor::setFloorTable(const json& jsonObj)
                 }
 
                 auto value = getJsonValue(floorEntry["value"]);
+                tryConvertToDouble(value);
                 auto floor = floorEntry["floor"].get<uint64_t>();
 
                 fg.floorEntries.emplace_back(std::move(value),
@@ -178,22 +236,54 @@ void MappedFloor::setFloorTable(const json& jsonObj)
     }
 }
 
-/**
- * @brief Converts the variant to a double if it's a
- *        int32_t or int64_t.
- */
-void tryConvertToDouble(PropertyVariantType& value)
+void MappedFloor::setFloorTable(
+    std::span<const compiled::FanFloorsDef> table)
 {
-    std::visit(
-        [&value](auto&& val) {
-            using V = std::decay_t<decltype(val)>;
-            if constexpr (std::is_same_v<int32_t, V> ||
-                          std::is_same_v<int64_t, V>)
+    auto toVariant = [](const compiled::FloorValue& value) {
+        return std::visit(
+            [](auto val) {
+                using V = decltype(val);
+                if constexpr (std::is_same_v<std::string_view, V>)
+                {
+                    return PropertyVariantType{std::string{val}};
+                }
+                else
+                {
+                    return PropertyVariantType{val};
+                }
+            },
+            value);
+    };
+
+    for (const auto& floors : table)
+    {
+        FanFloors ff;
+        ff.keyValue = toVariant(floors.key);
+        ff.offsetParameter = floors.offsetParameter;
+        ff.defaultFloor = floors.defaultFloor;
+
+        for (const auto& groupEntry : floors.floorGroups)
+        {
+            FloorGroup fg;
+            if (!groupEntry.group.empty())
             {
-                value = static_cast<double>(val);
+                fg.groupOrParameter = getGroup(std::string{groupEntry.group});
             }
-        },
-        value);
+            else
+            {
+                fg.groupOrParameter = std::string{groupEntry.parameter};
+            }
+
+            for (const auto& [value, floor] : groupEntry.floors)
+            {
+                fg.floorEntries.emplace_back(toVariant(value), floor);
+            }
+
+            ff.floorGroups.push_back(std::move(fg));
+        }
+
+        _fanFloors.push_back(std::move(ff));
+    }
 }
 
 std::optional<PropertyVariantType>
@@ -201,48 +291,77 @@ std::optional<PropertyVariantType>
 {
     std::optional<PropertyVariantType> max;
     bool checked = false;
+    auto index = &group - _groups.data();
+
+    // Without a non-numeric value to reject, the maximum can be taken
+    // from the group's ordered values
+    if (_useGroupValues &&
+        ((group.getMembers().size() == 1) || (_nonNumeric[index] == 0)))
+    {
+        if (!_groupValues[index].empty())
+        {
+            max = *_groupValues[index].rbegin();
+            tryConvertToDouble(*max);
+        }
+        return max;
+    }
+
+    // Groups of only doubles are reduced from their numeric column,
+    // anything else from the cached variants
+    if (_numericRanges.empty())
+    {
+        _numericRanges = Manager::getNumericRanges(_groups);
+    }
+    const auto& range = _numericRanges[index];
+    if (range.allNumeric())
+    {
+        if (auto groupMax = range.max())
+        {
+            max = *groupMax;
+        }
+        return max;
+    }
 
     for (const auto& member : group.getMembers())
     {
-        try
+        auto valuePtr = Manager::getObjValuePtr(member, group.getInterface(),
+                                                group.getProperty());
+        if (!valuePtr)
         {
-            auto value = Manager::getObjValueVariant(
-                member, group.getInterface(), group.getProperty());
+            // Property not there, continue on
+            continue;
+        }
+        const auto& value = *valuePtr;
 
-            // Only allow a group to have multiple members if it's numeric.
-            // Unlike std::is_arithmetic, bools are not considered numeric
-            // here.
-            if (!checked && (group.getMembers().size() > 1))
-            {
-                std::visit(
-                    [&group, this](auto&& val) {
-                        using V = std::decay_t<decltype(val)>;
-                        if constexpr (!std::is_same_v<double, V> &&
-                                      !std::is_same_v<int32_t, V> &&
-                                      !std::is_same_v<int64_t, V>)
-                        {
-                            throw std::runtime_error{fmt::format(
-                                "{}: Group {} has more than one member but "
-                                "isn't numeric",
-                                ActionBase::getName(), group.getName())};
-                        }
-                    },
-                    value);
-                checked = true;
-            }
+        // Only allow a group to have multiple members if it's numeric.
+        // Unlike std::is_arithmetic, bools are not considered numeric
+        // here.
+        if (!checked && (group.getMembers().size() > 1))
+        {
+            std::visit(
+                [&group, this](auto&& val) {
+                    using V = std::decay_t<decltype(val)>;
+                    if constexpr (!std::is_same_v<double, V> &&
+                                  !std::is_same_v<int32_t, V> &&
+                                  !std::is_same_v<int64_t, V>)
+                    {
+                        throw std::runtime_error{fmt::format(
+                            "{}: Group {} has more than one member but "
+                            "isn't numeric",
+                            ActionBase::getName(), group.getName())};
+                    }
+                },
+                value);
+            checked = true;
+        }
 
-            if (max && (value > max))
-            {
-                max = value;
-            }
-            else if (!max)
-            {
-                max = value;
-            }
+        if (max && (value > max))
+        {
+            max = value;
         }
-        catch (const std::out_of_range& e)
+        else if (!max)
         {
-            // Property not there, continue on
+            max = value;
         }
     }
 
@@ -263,22 +382,16 @@ void MappedFloor::run(Zone& zone)
     if (!keyValue)
     {
         auto floor = _defaultFloor ? *_defaultFloor : zone.getDefaultFloor();
-        zone.setFloorHold(getUniqueName(), floor, true);
+        zone.setFloorHold(getHoldId(), floor, true);
         return;
     }
 
     for (const auto& floorTable : _fanFloors)
     {
         // First, find the floorTable entry to use based on the key value.
-        auto tableKeyValue = floorTable.keyValue;
-
-        // Convert numeric values from the JSON to doubles so they can
-        // be compared to values coming from D-Bus.
-        tryConvertToDouble(tableKeyValue);
-
         // The key value from D-Bus must be less than the value
         // in the table for this entry to be valid.
-        if (*keyValue >= tableKeyValue)
+        if (*keyValue >= floorTable.keyValue)
         {
             continue;
         }
@@ -321,11 +434,8 @@ void MappedFloor::run(Zone& zone)
             {
                 // Do either a <= or an == check depending on the data type
                 // to get the floor value based on this group.
-                for (const auto& [tableValue, tableFloor] : floorGroups)
+                for (const auto& [value, tableFloor] : floorGroups)
                 {
-                    PropertyVariantType value{tableValue};
-                    tryConvertToDouble(value);
-
                     if (std::holds_alternative<double>(*propertyValue))
                     {
                         if (*propertyValue <= value)
@@ -389,7 +499,72 @@ void MappedFloor::run(Zone& zone)
         newFloor = _defaultFloor ? *_defaultFloor : zone.getDefaultFloor();
     }
 
-    zone.setFloorHold(getUniqueName(), *newFloor, true);
+    zone.setFloorHold(getHoldId(), *newFloor, true);
+}
+
+void MappedFloor::runIncremental(Zone& zone, const ChangeSet& changes)
+{
+    if (changes.all)
+    {
+        for (size_t group = 0; group < _groups.size(); group++)
+        {
+            for (size_t member = 0; member < _memberValues[group].size();
+                 member++)
+            {
+                updateMember(group, member);
+            }
+        }
+    }
+    else
+    {
+        for (const auto& [group, member] : changes.members)
+        {
+            updateMember(group, member);
+        }
+    }
+
+    _useGroupValues = true;
+    try
+    {
+        run(zone);
+    }
+    catch (...)
+    {
+        _useGroupValues = false;
+        throw;
+    }
+    _useGroupValues = false;
+}
+
+void MappedFloor::updateMember(size_t group, size_t member)
+{
+    const auto& grp = _groups[group];
+    auto valuePtr = Manager::getObjValuePtr(
+        grp.getMembers()[member], grp.getInterface(), grp.getProperty());
+
+    auto& position = _memberValues[group][member];
+    if (position)
+    {
+        if (valuePtr && (**position == *valuePtr))
+        {
+            return;
+        }
+        if (!isNumeric(**position))
+        {
+            _nonNumeric[group]--;
+        }
+        _groupValues[group].erase(*position);
+        position.reset();
+    }
+
+    if (valuePtr)
+    {
+        position = _groupValues[group].insert(*valuePtr);
+        if (!isNumeric(*valuePtr))
+        {
+            _nonNumeric[group]++;
+        }
+    }
 }
 
 uint64_t MappedFloor::applyFloorOffset(uint64_t floor,
@@ -15,12 +15,18 @@
  */
 #pragma once
 
+#include "../utils/numeric_column.hpp"
 #include "../zone.hpp"
 #include "action.hpp"
+#include "compiled_config.hpp"
 #include "group.hpp"
 
 #include <nlohmann/json.hpp>
 
+#include <optional>
+#include <set>
+#include <span>
+
 namespace phosphor::fan::control::json
 {
 
@@ -142,6 +148,18 @@ class MappedFloor : public ActionBase, public ActionRegister<MappedFloor>
      */
     void run(Zone& zone) override;
 
+    /**
+     * @brief Run the action from the members that changed
+     *
+     * Keeps the values of each group's members ordered, updated from only
+     * the members that changed since the action last ran, so the group
+     * maximums don't have to be found from all of the members.
+     *
+     * @param[in] zone - Zone to run the action on
+     * @param[in] changes - The changed group members
+     */
+    void runIncremental(Zone& zone, const ChangeSet& changes) override;
+
   private:
     /**
      * @brief Parse and set the key group
@@ -164,6 +182,14 @@ class MappedFloor : public ActionBase, public ActionRegister<MappedFloor>
      */
     void setFloorTable(const json& jsonObj);
 
+    /**
+     * @brief Sets the floor group data members from a floor table
+     *        compiled in by gen-json-config-defs.py
+     *
+     * @param[in] table - The compiled floor table
+     */
+    void setFloorTable(std::span<const compiled::FanFloorsDef> table);
+
     /**
      * @brief Applies the offset in offsetParameter to the
      *        value passed in.
@@ -199,6 +225,15 @@ class MappedFloor : public ActionBase, public ActionRegister<MappedFloor>
     std::optional<PropertyVariantType> getMaxGroupValue(const Group& group,
                                                         const Manager& manager);
 
+    /**
+     * @brief Update the ordered values of a member's group from the
+     *        member's cached value
+     *
+     * @param[in] group - Index of the member's group
+     * @param[in] member - Index of the member within its group
+     */
+    void updateMember(size_t group, size_t member);
+
     /**
      * @brief Returns a pointer to the group object specified
      *
@@ -234,6 +269,26 @@ class MappedFloor : public ActionBase, public ActionRegister<MappedFloor>
 
     /* The fan floors action data, loaded from JSON */
     std::vector<FanFloors> _fanFloors;
+
+    /* The numeric column ranges of the groups' values, found on the
+     * first run */
+    std::vector<NumericRange> _numericRanges;
+
+    using GroupValues = std::multiset<PropertyVariantType>;
+
+    /* The cached values of each group's members, ordered */
+    std::vector<GroupValues> _groupValues;
+
+    /* Each member's position in its group's values, by group */
+    std::vector<std::vector<std::optional<GroupValues::iterator>>>
+        _memberValues;
+
+    /* Number of each group's members with non-numeric values */
+    std::vector<size_t> _nonNumeric;
+
+    /* Whether the group maximums come from the ordered values,
+     * which is only while running with the changes applied */
+    bool _useGroupValues = false;
 };
 
 } // namespace phosphor::fan::control::json
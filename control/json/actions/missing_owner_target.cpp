@@ -41,16 +41,27 @@ MissingOwnerTarget::MissingOwnerTarget(const json& jsonObj,
 
 void MissingOwnerTarget::run(Zone& zone)
 {
-    for (const auto& group : _groups)
+    if (_missingOwners.empty())
     {
-        const auto& members = group.getMembers();
-        auto isMissingOwner =
-            std::any_of(members.begin(), members.end(),
-                        [&intf = group.getInterface()](const auto& member) {
-                            return !Manager::hasOwner(member, intf);
-                        });
+        _missingOwners = Manager::getMissingOwnerCounts(_groups);
+    }
+    if (_holdIds.empty())
+    {
+        // The groups' holds are shared with any other action holding
+        // them, but never with an action's hold of the same name
+        _holdIds.reserve(_groups.size());
+        for (const auto& group : _groups)
+        {
+            _holdIds.push_back(
+                HoldIds::intern(HoldScope::group, group.getName()));
+        }
+    }
+
+    for (size_t i = 0; i < _groups.size(); i++)
+    {
+        auto isMissingOwner = (*_missingOwners[i] != 0);
         // Update zone's target hold based on action results
-        zone.setTargetHold(group.getName(), _target, isMissingOwner);
+        zone.setTargetHold(_holdIds[i], _target, isMissingOwner);
     }
 }
 
@@ -21,6 +21,8 @@
 
 #include <nlohmann/json.hpp>
 
+#include <vector>
+
 namespace phosphor::fan::control::json
 {
 
@@ -71,6 +73,13 @@ class MissingOwnerTarget :
     /* Target for this action */
     uint64_t _target;
 
+    /* The groups' missing owner counts, found on the first run */
+    std::vector<const size_t*> _missingOwners;
+
+    /* The identifiers of the groups' target holds, interned from their
+     * names on the first run */
+    std::vector<HoldId> _holdIds;
+
     /**
      * @brief Parse and set the target
      *
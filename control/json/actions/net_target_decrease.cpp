@@ -16,6 +16,7 @@
 #include "net_target_decrease.hpp"
 
 #include "../manager.hpp"
+#include "../utils/group_reduction.hpp"
 #include "../zone.hpp"
 #include "action.hpp"
 #include "group.hpp"
@@ -54,86 +55,101 @@ void NetTargetDecrease::run(Zone& zone)
         _state = *s;
     }
 
+    if (_numericRanges.empty())
+    {
+        _numericRanges = Manager::getNumericRanges(_groups);
+    }
+
+    auto dblState = std::get_if<double>(&_state);
     auto netDelta = zone.getDecDelta();
-    for (const auto& group : _groups)
+    for (size_t i = 0; i < _groups.size(); i++)
     {
+        const auto& group = _groups[i];
+
+        // Groups of only doubles are reduced from their numeric column
+        if (dblState && (_delta != 0) && _numericRanges[i].allNumeric())
+        {
+            netDelta = reduceDecrease(_numericRanges[i], *dblState, netDelta);
+            zone.setDecreaseAllow(group.getName(), !(netDelta == 0));
+            continue;
+        }
+
         for (const auto& member : group.getMembers())
         {
-            try
+            auto valuePtr = Manager::getObjValuePtr(
+                member, group.getInterface(), group.getProperty());
+            if (!valuePtr)
+            {
+                // Property value not found, netDelta unchanged
+                continue;
+            }
+            const auto& value = *valuePtr;
+            if (std::holds_alternative<int64_t>(value) ||
+                std::holds_alternative<double>(value))
             {
-                auto value = Manager::getObjValueVariant(
-                    member, group.getInterface(), group.getProperty());
-                if (std::holds_alternative<int64_t>(value) ||
-                    std::holds_alternative<double>(value))
+                if (value >= _state)
                 {
-                    if (value >= _state)
+                    // No decrease allowed for this group
+                    netDelta = 0;
+                    break;
+                }
+                else
+                {
+                    // Decrease factor is the difference in configured state
+                    // to the current value's state
+                    uint64_t deltaFactor = 0;
+                    if (auto dblPtr = std::get_if<double>(&value))
                     {
-                        // No decrease allowed for this group
-                        netDelta = 0;
-                        break;
+                        deltaFactor = static_cast<uint64_t>(
+                            std::get<double>(_state) - *dblPtr);
                     }
                     else
                     {
-                        // Decrease factor is the difference in configured state
-                        // to the current value's state
-                        uint64_t deltaFactor = 0;
-                        if (auto dblPtr = std::get_if<double>(&value))
-                        {
-                            deltaFactor = static_cast<uint64_t>(
-                                std::get<double>(_state) - *dblPtr);
-                        }
-                        else
-                        {
-                            deltaFactor = static_cast<uint64_t>(
-                                std::get<int64_t>(_state) -
-                                std::get<int64_t>(value));
-                        }
-
-                        // Multiply the decrease factor by the configured delta
-                        // to get the net decrease delta for the given group
-                        // member. The lowest net decrease delta of the entire
-                        // group is the decrease requested.
-                        if (netDelta == 0)
-                        {
-                            netDelta = deltaFactor * _delta;
-                        }
-                        else
-                        {
-                            netDelta = std::min(netDelta, deltaFactor * _delta);
-                        }
+                        deltaFactor = static_cast<uint64_t>(
+                            std::get<int64_t>(_state) -
+                            std::get<int64_t>(value));
                     }
-                }
-                else if (std::holds_alternative<bool>(value) ||
-                         std::holds_alternative<std::string>(value))
-                {
-                    // Where a group of booleans or strings equal the state
-                    // provided, request a decrease of the configured delta
-                    if (_state == value)
+
+                    // Multiply the decrease factor by the configured delta
+                    // to get the net decrease delta for the given group
+                    // member. The lowest net decrease delta of the entire
+                    // group is the decrease requested.
+                    if (netDelta == 0)
                     {
-                        if (netDelta == 0)
-                        {
-                            netDelta = _delta;
-                        }
-                        else
-                        {
-                            netDelta = std::min(netDelta, _delta);
-                        }
+                        netDelta = deltaFactor * _delta;
+                    }
+                    else
+                    {
+                        netDelta = std::min(netDelta, deltaFactor * _delta);
                     }
                 }
-                else
+            }
+            else if (std::holds_alternative<bool>(value) ||
+                     std::holds_alternative<std::string>(value))
+            {
+                // Where a group of booleans or strings equal the state
+                // provided, request a decrease of the configured delta
+                if (_state == value)
                 {
-                    // Unsupported group member type for this action
-                    log<level::ERR>(
-                        fmt::format("Action {}: Unsupported group member type "
-                                    "given. [object = {} : {} : {}]",
-                                    ActionBase::getName(), member,
-                                    group.getInterface(), group.getProperty())
-                            .c_str());
+                    if (netDelta == 0)
+                    {
+                        netDelta = _delta;
+                    }
+                    else
+                    {
+                        netDelta = std::min(netDelta, _delta);
+                    }
                 }
             }
-            catch (const std::out_of_range& oore)
+            else
             {
-                // Property value not found, netDelta unchanged
+                // Unsupported group member type for this action
+                log<level::ERR>(
+                    fmt::format("Action {}: Unsupported group member type "
+                                "given. [object = {} : {} : {}]",
+                                ActionBase::getName(), member,
+                                group.getInterface(), group.getProperty())
+                        .c_str());
             }
         }
         // Update group's decrease allowed state
@@ -143,6 +159,34 @@ void NetTargetDecrease::run(Zone& zone)
     zone.requestDecrease(netDelta);
 }
 
+uint64_t NetTargetDecrease::reduceDecrease(const NumericRange& range,
+                                           double state, uint64_t netDelta)
+{
+    if (reduction::countAtOrAbove(range, state) != 0)
+    {
+        // No decrease allowed for this group
+        return 0;
+    }
+
+    // A member less than a whole step below the state gives a decrease
+    // of 0, which the members after it then replace, so only those
+    // members count.
+    size_t first = 0;
+    if (auto last = reduction::lastWithinBelowState(range, state, 1.0))
+    {
+        netDelta = 0;
+        first = *last + 1;
+    }
+
+    auto minDelta = reduction::minDeltaBelowState(range, state, first);
+    if (minDelta)
+    {
+        auto delta = static_cast<uint64_t>(*minDelta) * _delta;
+        netDelta = (netDelta == 0) ? delta : std::min(netDelta, delta);
+    }
+    return netDelta;
+}
+
 void NetTargetDecrease::setState(const json& jsonObj)
 {
     if (jsonObj.contains("state"))
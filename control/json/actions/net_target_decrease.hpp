@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "../utils/numeric_column.hpp"
 #include "../zone.hpp"
 #include "action.hpp"
 #include "group.hpp"
@@ -95,6 +96,10 @@ class NetTargetDecrease :
     /* Decrease delta for this action */
     uint64_t _delta;
 
+    /* The numeric column ranges of the groups' values, found on the
+     * first run */
+    std::vector<NumericRange> _numericRanges;
+
     /**
      * @brief Parse and set the state
      *
@@ -112,6 +117,21 @@ class NetTargetDecrease :
      * Sets the decrease delta to use when running the action
      */
     void setDelta(const json& jsonObj);
+
+    /**
+     * @brief Reduce a group of only double values to its decrease delta
+     *
+     * Gives the same result as checking each member of the group in turn,
+     * but from the group's numeric column.
+     *
+     * @param[in] range - The group's range of the numeric column
+     * @param[in] state - The state the members are compared to
+     * @param[in] netDelta - The decrease delta from the previous groups
+     *
+     * @return The decrease delta including this group
+     */
+    uint64_t reduceDecrease(const NumericRange& range, double state,
+                            uint64_t netDelta);
 };
 
 } // namespace phosphor::fan::control::json
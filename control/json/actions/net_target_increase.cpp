@@ -16,6 +16,7 @@
 #include "net_target_increase.hpp"
 
 #include "../manager.hpp"
+#include "../utils/group_reduction.hpp"
 #include "../zone.hpp"
 #include "action.hpp"
 #include "group.hpp"
@@ -40,104 +41,179 @@ NetTargetIncrease::NetTargetIncrease(const json& jsonObj,
 {
     setState(jsonObj);
     setDelta(jsonObj);
+
+    for (const auto& group : _groups)
+    {
+        _memberDeltas.emplace_back(group.getMembers().size(), 0);
+    }
+    trackChanges();
 }
 
 void NetTargetIncrease::run(Zone& zone)
 {
+    // Without the changes, every member is checked
+    runIncremental(zone, ChangeSet{});
+}
 
+void NetTargetIncrease::runIncremental(Zone& zone, const ChangeSet& changes)
+{
     if (!_stateParameter.empty())
     {
         auto s = Manager::getParameter(_stateParameter);
         if (!s)
         {
+            // The changes aren't applied, so start over next time
+            _deltasState.reset();
             return;
         }
         _state = *s;
     }
 
+    if (changes.all || !_deltasState || (*_deltasState != _state))
+    {
+        // Every member's increase depends on the state
+        _deltasState = _state;
+        updateAll();
+    }
+    else
+    {
+        for (const auto& [group, member] : changes.members)
+        {
+            updateMember(group, member);
+        }
+    }
+
     auto netDelta = zone.getIncDelta();
-    for (const auto& group : _groups)
+    if (!_deltas.empty())
     {
-        const auto& members = group.getMembers();
-        std::for_each(
-            members.begin(), members.end(),
-            [this, &zone, &group, &netDelta](const auto& member) {
-                try
-                {
-                    auto value = Manager::getObjValueVariant(
-                        member, group.getInterface(), group.getProperty());
-                    if (std::holds_alternative<int64_t>(value) ||
-                        std::holds_alternative<double>(value))
-                    {
-                        // Where a group of int/doubles are greater than or
-                        // equal to the state(some value) provided, request an
-                        // increase of the configured delta times the difference
-                        // between the group member's value and configured state
-                        // value.
-                        if (value >= _state)
-                        {
-                            uint64_t incDelta = 0;
-                            if (auto dblPtr = std::get_if<double>(&value))
-                            {
-                                incDelta = static_cast<uint64_t>(
-                                    (*dblPtr - std::get<double>(_state)) *
-                                    _delta);
-                            }
-                            else
-                            {
-                                // Increase by at least a single delta
-                                // to attempt bringing under provided 'state'
-                                auto deltaFactor =
-                                    std::max((std::get<int64_t>(value) -
-                                              std::get<int64_t>(_state)),
-                                             1ll);
-                                incDelta =
-                                    static_cast<uint64_t>(deltaFactor * _delta);
-                            }
-                            netDelta = std::max(netDelta, incDelta);
-                        }
-                    }
-                    else if (std::holds_alternative<bool>(value))
-                    {
-                        // Where a group of booleans equal the state(`true` or
-                        // `false`) provided, request an increase of the
-                        // configured delta
-                        if (_state == value)
-                        {
-                            netDelta = std::max(netDelta, _delta);
-                        }
-                    }
-                    else if (std::holds_alternative<std::string>(value))
-                    {
-                        // Where a group of strings equal the state(some string)
-                        // provided, request an increase of the configured delta
-                        if (_state == value)
-                        {
-                            netDelta = std::max(netDelta, _delta);
-                        }
-                    }
-                    else
-                    {
-                        // Unsupported group member type for this action
-                        log<level::ERR>(
-                            fmt::format(
-                                "Action {}: Unsupported group member type "
-                                "given. [object = {} : {} : {}]",
-                                ActionBase::getName(), member,
-                                group.getInterface(), group.getProperty())
-                                .c_str());
-                    }
-                }
-                catch (const std::out_of_range& oore)
-                {
-                    // Property value not found, netDelta unchanged
-                }
-            });
+        netDelta = std::max(netDelta, *_deltas.rbegin());
     }
     // Request increase to target
     zone.requestIncrease(netDelta);
 }
 
+void NetTargetIncrease::updateAll()
+{
+    if (_numericRanges.empty())
+    {
+        _numericRanges = Manager::getNumericRanges(_groups);
+    }
+
+    auto dblState = std::get_if<double>(&_state);
+    _deltas.clear();
+    for (size_t group = 0; group < _groups.size(); group++)
+    {
+        auto& deltas = _memberDeltas[group];
+
+        // Groups of only doubles are reduced from their numeric column,
+        // each increase growing with how far the member is above the state
+        if (dblState && _numericRanges[group].allNumeric())
+        {
+            reduction::deltasAboveState(_numericRanges[group], *dblState,
+                                        _delta, deltas.data());
+        }
+        else
+        {
+            const auto& grp = _groups[group];
+            for (size_t member = 0; member < deltas.size(); member++)
+            {
+                deltas[member] = getMemberDelta(grp, grp.getMembers()[member]);
+            }
+        }
+
+        for (auto delta : deltas)
+        {
+            if (delta != 0)
+            {
+                _deltas.insert(delta);
+            }
+        }
+    }
+}
+
+void NetTargetIncrease::updateMember(size_t group, size_t member)
+{
+    auto& memberDelta = _memberDeltas[group][member];
+    const auto& grp = _groups[group];
+    auto delta = getMemberDelta(grp, grp.getMembers()[member]);
+    if (delta == memberDelta)
+    {
+        return;
+    }
+    if (memberDelta != 0)
+    {
+        _deltas.erase(_deltas.find(memberDelta));
+    }
+    if (delta != 0)
+    {
+        _deltas.insert(delta);
+    }
+    memberDelta = delta;
+}
+
+uint64_t NetTargetIncrease::getMemberDelta(const Group& group,
+                                           const std::string& member) const
+{
+    auto valuePtr = Manager::getObjValuePtr(member, group.getInterface(),
+                                            group.getProperty());
+    if (!valuePtr)
+    {
+        // Property value not found, no increase
+        return 0;
+    }
+    const auto& value = *valuePtr;
+    if (std::holds_alternative<int64_t>(value) ||
+        std::holds_alternative<double>(value))
+    {
+        // Where a group of int/doubles are greater than or equal to the
+        // state(some value) provided, request an increase of the configured
+        // delta times the difference between the group member's value and
+        // configured state value.
+        if (value >= _state)
+        {
+            if (auto dblPtr = std::get_if<double>(&value))
+            {
+                return static_cast<uint64_t>(
+                    (*dblPtr - std::get<double>(_state)) * _delta);
+            }
+
+            // Increase by at least a single delta
+            // to attempt bringing under provided 'state'
+            auto deltaFactor = std::max(
+                (std::get<int64_t>(value) - std::get<int64_t>(_state)), 1ll);
+            return static_cast<uint64_t>(deltaFactor * _delta);
+        }
+    }
+    else if (std::holds_alternative<bool>(value))
+    {
+        // Where a group of booleans equal the state(`true` or `false`)
+        // provided, request an increase of the configured delta
+        if (_state == value)
+        {
+            return _delta;
+        }
+    }
+    else if (std::holds_alternative<std::string>(value))
+    {
+        // Where a group of strings equal the state(some string) provided,
+        // request an increase of the configured delta
+        if (_state == value)
+        {
+            return _delta;
+        }
+    }
+    else
+    {
+        // Unsupported group member type for this action
+        log<level::ERR>(fmt::format("Action {}: Unsupported group member type "
+                                    "given. [object = {} : {} : {}]",
+                                    ActionBase::getName(), member,
+                                    group.getInterface(), group.getProperty())
+                            .c_str());
+    }
+    return 0;
+}
+
 void NetTargetIncrease::setState(const json& jsonObj)
 {
     if (jsonObj.contains("state"))
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "../utils/numeric_column.hpp"
 #include "../zone.hpp"
 #include "action.hpp"
 #include "group.hpp"
@@ -22,6 +23,7 @@
 #include <nlohmann/json.hpp>
 
 #include <optional>
+#include <set>
 
 namespace phosphor::fan::control::json
 {
@@ -82,6 +84,18 @@ class NetTargetIncrease :
      */
     void run(Zone& zone) override;
 
+    /**
+     * @brief Run the action from the members that changed
+     *
+     * Keeps the increase each member requests, updated from only the
+     * members that changed since the action last ran, or from all of
+     * them when the state changed.
+     *
+     * @param[in] zone - Zone to run the action on
+     * @param[in] changes - The changed group members
+     */
+    void runIncremental(Zone& zone, const ChangeSet& changes) override;
+
   private:
     /* State the members must be at to increase the target */
     PropertyVariantType _state;
@@ -95,6 +109,19 @@ class NetTargetIncrease :
     /* Increase delta for this action */
     uint64_t _delta;
 
+    /* The numeric column ranges of the groups' values, found when every
+     * member is first checked */
+    std::vector<NumericRange> _numericRanges;
+
+    /* The increase each group member requests, by group */
+    std::vector<std::vector<uint64_t>> _memberDeltas;
+
+    /* The nonzero member increases, ordered */
+    std::multiset<uint64_t> _deltas;
+
+    /* The state the member increases are for */
+    std::optional<PropertyVariantType> _deltasState;
+
     /**
      * @brief Parse and set the state
      *
@@ -112,6 +139,30 @@ class NetTargetIncrease :
      * Sets the increase delta to use when running the action
      */
     void setDelta(const json& jsonObj);
+
+    /**
+     * @brief Update every member's increase from its cached value
+     */
+    void updateAll();
+
+    /**
+     * @brief Update a member's increase from its cached value
+     *
+     * @param[in] group - Index of the member's group
+     * @param[in] member - Index of the member within its group
+     */
+    void updateMember(size_t group, size_t member);
+
+    /**
+     * @brief Get the increase a member requests
+     *
+     * @param[in] group - The member's group
+     * @param[in] member - The member
+     *
+     * @return The increase delta, 0 for none
+     */
+    uint64_t getMemberDelta(const Group& group,
+                            const std::string& member) const;
 };
 
 } // namespace phosphor::fan::control::json
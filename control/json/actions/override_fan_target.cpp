@@ -47,21 +47,17 @@ void OverrideFanTarget::run(Zone& zone)
     {
         for (const auto& member : group.getMembers())
         {
-            try
+            auto value = Manager::getObjValuePtr(member, group.getInterface(),
+                                                 group.getProperty());
+            if (value && (*value == _state))
             {
-                if (Manager::getObjValueVariant(member, group.getInterface(),
-                                                group.getProperty()) == _state)
-                {
-                    numAtState++;
+                numAtState++;
 
-                    if (numAtState >= _count)
-                    {
-                        break;
-                    }
+                if (numAtState >= _count)
+                {
+                    break;
                 }
             }
-            catch (const std::out_of_range&)
-            {}
         }
 
         // lock the fans
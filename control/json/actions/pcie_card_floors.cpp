@@ -18,7 +18,6 @@
 #include "../manager.hpp"
 #include "json_config.hpp"
 #include "sdbusplus.hpp"
-#include "sdeventplus.hpp"
 
 namespace phosphor::fan::control::json
 {
@@ -48,13 +47,18 @@ void PCIeCardFloors::run(Zone& zone)
     }
     else
     {
-        _settleTimer =
-            std::make_unique<Timer>(util::SDEventPlus::getEvent(),
-                                    [&zone, this](Timer&) { execute(zone); });
+        _settleTimer = std::make_unique<WheelTimer>(
+            Manager::getTimerWheel(),
+            [&zone, this](WheelTimer&) { execute(zone); });
     }
     _settleTimer->restartOnce(_settleTime);
 }
 
+std::vector<std::string> PCIeCardFloors::getSetParameters() const
+{
+    return {floorIndexParam};
+}
+
 void PCIeCardFloors::execute(Zone& zone)
 {
     size_t hotCards = 0;
@@ -75,14 +79,9 @@ void PCIeCardFloors::execute(Zone& zone)
 
         for (const auto& slotPath : group.getMembers())
         {
-            PropertyVariantType powerState;
-
-            try
-            {
-                powerState = Manager::getObjValueVariant(
-                    slotPath, group.getInterface(), group.getProperty());
-            }
-            catch (const std::out_of_range& oore)
+            auto powerState = Manager::getObjValuePtr(
+                slotPath, group.getInterface(), group.getProperty());
+            if (!powerState)
             {
                 log<level::ERR>(
                     fmt::format("Could not get power state for {}", slotPath)
@@ -90,7 +89,7 @@ void PCIeCardFloors::execute(Zone& zone)
                 continue;
             }
 
-            if (std::get<std::string>(powerState) !=
+            if (std::get<std::string>(*powerState) !=
                 "xyz.openbmc_project.State.Decorator.PowerState.State.On")
             {
                 continue;
@@ -175,41 +174,39 @@ void PCIeCardFloors::loadCardJSON(const json& jsonObj)
     _cardMetadata = std::make_unique<PCIeCardMetadata>(names);
 }
 
-uint16_t PCIeCardFloors::getPCIeDeviceProperty(const std::string& objectPath,
-                                               const std::string& propertyName)
+std::optional<uint16_t>
+    PCIeCardFloors::getPCIeDeviceProperty(const std::string& objectPath,
+                                          const std::string& propertyName)
 {
-    PropertyVariantType variantValue;
-    uint16_t value{};
-
-    try
-    {
-        variantValue = Manager::getObjValueVariant(objectPath, pcieDeviceIface,
-                                                   propertyName);
-    }
-    catch (const std::out_of_range& oore)
+    auto variantValue =
+        Manager::getObjValuePtr(objectPath, pcieDeviceIface, propertyName);
+    if (!variantValue)
     {
         log<level::ERR>(
             fmt::format(
                 "{}: Could not get PCIeDevice property {} {} from cache ",
                 ActionBase::getName(), objectPath, propertyName)
                 .c_str());
-        throw;
+        return std::nullopt;
     }
 
-    try
+    auto strValue = std::get_if<std::string>(variantValue);
+    if (strValue)
     {
-        value = std::stoul(std::get<std::string>(variantValue), nullptr, 0);
-        return value;
-    }
-    catch (const std::invalid_argument& e)
-    {
-        log<level::INFO>(
-            fmt::format("{}: {} has invalid PCIeDevice property {} value: {}",
-                        ActionBase::getName(), objectPath, propertyName,
-                        std::get<std::string>(variantValue))
-                .c_str());
-        throw;
+        try
+        {
+            return static_cast<uint16_t>(std::stoul(*strValue, nullptr, 0));
+        }
+        catch (const std::logic_error& e)
+        {}
     }
+
+    log<level::INFO>(
+        fmt::format("{}: {} has invalid PCIeDevice property {} value",
+                    ActionBase::getName(), objectPath, propertyName)
+            .c_str());
+
+    return std::nullopt;
 }
 
 std::optional<std::variant<int32_t, bool>>
@@ -217,21 +214,18 @@ std::optional<std::variant<int32_t, bool>>
 {
     const auto& card = getCardFromSlot(slotPath);
 
-    try
+    auto deviceID = getPCIeDeviceProperty(card, deviceIDProp);
+    auto vendorID = getPCIeDeviceProperty(card, vendorIDProp);
+    auto subsystemID = getPCIeDeviceProperty(card, subsystemIDProp);
+    auto subsystemVendorID = getPCIeDeviceProperty(card, subsystemVendorIDProp);
+
+    if (!deviceID || !vendorID || !subsystemID || !subsystemVendorID)
     {
-        auto deviceID = getPCIeDeviceProperty(card, deviceIDProp);
-        auto vendorID = getPCIeDeviceProperty(card, vendorIDProp);
-        auto subsystemID = getPCIeDeviceProperty(card, subsystemIDProp);
-        auto subsystemVendorID =
-            getPCIeDeviceProperty(card, subsystemVendorIDProp);
-
-        return _cardMetadata->lookup(deviceID, vendorID, subsystemID,
-                                     subsystemVendorID);
+        return std::nullopt;
     }
-    catch (const std::exception& e)
-    {}
 
-    return std::nullopt;
+    return _cardMetadata->lookup(*deviceID, *vendorID, *subsystemID,
+                                 *subsystemVendorID);
 }
 
 const std::string& PCIeCardFloors::getCardFromSlot(const std::string& slotPath)
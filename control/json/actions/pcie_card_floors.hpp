@@ -109,6 +109,13 @@ class PCIeCardFloors : public ActionBase, public ActionRegister<PCIeCardFloors>
     void setEventName(const std::string& name) override
     {}
 
+    /**
+     * @brief Get the names of the parameters the action sets
+     *
+     * @return The PCIe card floor index parameter name
+     */
+    std::vector<std::string> getSetParameters() const override;
+
   private:
     /**
      * @brief Runs the contents of the action when the settle timer expires.
@@ -155,10 +162,12 @@ class PCIeCardFloors : public ActionBase, public ActionRegister<PCIeCardFloors>
      * @param[in] objectPath - The card object path
      * @param[in] propertyName - The property to read
      *
-     * @return uint16_t The property value
+     * @return optional<uint16_t> The property value, or std::nullopt
+     *         if it isn't in the cache or isn't a valid number.
      */
-    uint16_t getPCIeDeviceProperty(const std::string& objectPath,
-                                   const std::string& propertyName);
+    std::optional<uint16_t>
+        getPCIeDeviceProperty(const std::string& objectPath,
+                              const std::string& propertyName);
 
     /* The PCIe card metadata manager */
     std::unique_ptr<PCIeCardMetadata> _cardMetadata;
@@ -172,7 +181,7 @@ class PCIeCardFloors : public ActionBase, public ActionRegister<PCIeCardFloors>
     std::chrono::seconds _settleTime{0};
 
     /* Timer to wait for slot plugs to settle down before running action */
-    std::unique_ptr<Timer> _settleTimer;
+    std::unique_ptr<WheelTimer> _settleTimer;
 
     /* Last status printed so only new messages get recorded */
     std::string _lastStatus;
@@ -46,45 +46,44 @@ void RequestTargetBase::run(Zone& zone)
     {
         for (const auto& member : group.getMembers())
         {
-            try
+            auto valuePtr = Manager::getObjValuePtr(
+                member, group.getInterface(), group.getProperty());
+            if (!valuePtr)
             {
-                auto value = Manager::getObjValueVariant(
-                    member, group.getInterface(), group.getProperty());
-                if (auto intPtr = std::get_if<int64_t>(&value))
-                {
-                    // Throw out any negative values as those are not valid
-                    // to use as a fan target base
-                    if (*intPtr < 0)
-                    {
-                        continue;
-                    }
-                    base = std::max(base, static_cast<uint64_t>(*intPtr));
-                }
-                else if (auto dblPtr = std::get_if<double>(&value))
+                // Property value not found, base request target unchanged
+                continue;
+            }
+            const auto& value = *valuePtr;
+            if (auto intPtr = std::get_if<int64_t>(&value))
+            {
+                // Throw out any negative values as those are not valid
+                // to use as a fan target base
+                if (*intPtr < 0)
                 {
-                    // Throw out any negative values as those are not valid
-                    // to use as a fan target base
-                    if (*dblPtr < 0)
-                    {
-                        continue;
-                    }
-                    // Precision of a double not a concern with fan targets
-                    base = std::max(base, static_cast<uint64_t>(*dblPtr));
+                    continue;
                 }
-                else
+                base = std::max(base, static_cast<uint64_t>(*intPtr));
+            }
+            else if (auto dblPtr = std::get_if<double>(&value))
+            {
+                // Throw out any negative values as those are not valid
+                // to use as a fan target base
+                if (*dblPtr < 0)
                 {
-                    // Unsupported group member type for this action
-                    log<level::ERR>(
-                        fmt::format("Action {}: Unsupported group member type "
-                                    "given. [object = {} : {} : {}]",
-                                    getName(), member, group.getInterface(),
-                                    group.getProperty())
-                            .c_str());
+                    continue;
                 }
+                // Precision of a double not a concern with fan targets
+                base = std::max(base, static_cast<uint64_t>(*dblPtr));
             }
-            catch (const std::out_of_range& oore)
+            else
             {
-                // Property value not found, base request target unchanged
+                // Unsupported group member type for this action
+                log<level::ERR>(
+                    fmt::format("Action {}: Unsupported group member type "
+                                "given. [object = {} : {} : {}]",
+                                getName(), member, group.getInterface(),
+                                group.getProperty())
+                        .c_str());
             }
         }
     }
@@ -40,21 +40,37 @@ void SetParameterFromGroupMax::run(Zone& zone)
     // Find the maximum value of all group member properties, possibly modify
     // it, and then write it to the Manager as a parameter.
 
-    for (const auto& group : _groups)
+    if (_numericRanges.empty())
     {
-        const auto& members = group.getMembers();
-        for (const auto& member : members)
+        _numericRanges = Manager::getNumericRanges(_groups);
+    }
+
+    for (size_t i = 0; i < _groups.size(); i++)
+    {
+        const auto& group = _groups[i];
+
+        // Groups of only doubles are reduced from their numeric column,
+        // anything else from the cached variants
+        if (_numericRanges[i].allNumeric())
         {
-            PropertyVariantType value;
-            try
+            auto groupMax = _numericRanges[i].max();
+            if (groupMax && (!max || (PropertyVariantType{*groupMax} > max)))
             {
-                value = Manager::getObjValueVariant(
-                    member, group.getInterface(), group.getProperty());
+                max = *groupMax;
             }
-            catch (const std::out_of_range&)
+            continue;
+        }
+
+        const auto& members = group.getMembers();
+        for (const auto& member : members)
+        {
+            auto valuePtr = Manager::getObjValuePtr(
+                member, group.getInterface(), group.getProperty());
+            if (!valuePtr)
             {
                 continue;
             }
+            const auto& value = *valuePtr;
 
             // Only allow a group to have multiple members if it's
             // numeric. Unlike with std::is_arithmetic, bools are not
@@ -16,6 +16,7 @@
 #pragma once
 
 #include "../utils/modifier.hpp"
+#include "../utils/numeric_column.hpp"
 #include "../zone.hpp"
 #include "action.hpp"
 #include "group.hpp"
@@ -86,6 +87,16 @@ class SetParameterFromGroupMax :
      */
     void run(Zone& zone) override;
 
+    /**
+     * @brief Get the names of the parameters the action sets
+     *
+     * @return The configured parameter name
+     */
+    std::vector<std::string> getSetParameters() const override
+    {
+        return {_name};
+    }
+
   private:
     /**
      * @brief Read the parameter name from the JSON
@@ -112,6 +123,12 @@ class SetParameterFromGroupMax :
      * Only created if a modifier is specified in the JSON.
      */
     std::unique_ptr<Modifier> _modifier;
+
+    /**
+     * @brief The numeric column ranges of the groups' values,
+     *        found on the first run
+     */
+    std::vector<NumericRange> _numericRanges;
 };
 
 } // namespace phosphor::fan::control::json
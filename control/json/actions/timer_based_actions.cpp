@@ -20,7 +20,6 @@
 #include "event.hpp"
 #include "group.hpp"
 #include "sdbusplus.hpp"
-#include "sdeventplus.hpp"
 #include "zone.hpp"
 
 #include <fmt/format.h>
@@ -38,7 +37,7 @@ using json = nlohmann::json;
 TimerBasedActions::TimerBasedActions(const json& jsonObj,
                                      const std::vector<Group>& groups) :
     ActionBase(jsonObj, groups),
-    _timer(util::SDEventPlus::getEvent(),
+    _timer(Manager::getTimerWheel(),
            std::bind(&TimerBasedActions::timerExpired, this))
 {
     // If any of groups' value == nullopt(i.e. not configured), action is
@@ -56,16 +55,15 @@ void TimerBasedActions::run(Zone& zone)
 {
     if (_byOwner)
     {
+        if (_missingOwners.empty())
+        {
+            _missingOwners = Manager::getMissingOwnerCounts(_groups);
+        }
+
         // If any service providing a group member is not owned, start
         // timer and if all members' services are owned, stop timer.
-        if (std::any_of(_groups.begin(), _groups.end(), [](const auto& group) {
-                const auto& members = group.getMembers();
-                return std::any_of(members.begin(), members.end(),
-                                   [&group](const auto& member) {
-                                       return !Manager::hasOwner(
-                                           member, group.getInterface());
-                                   });
-            }))
+        if (std::any_of(_missingOwners.begin(), _missingOwners.end(),
+                        [](const auto* count) { return *count != 0; }))
         {
             startTimer();
         }
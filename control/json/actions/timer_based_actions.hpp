@@ -114,13 +114,27 @@ class TimerBasedActions :
     virtual void
         setZones(std::vector<std::reference_wrapper<Zone>>& zones) override;
 
+    /**
+     * @brief Get the names of the parameters the timer's actions set
+     *
+     * @return List of parameter names
+     */
+    std::vector<std::string> getSetParameters() const override
+    {
+        return getNestedSetParameters(_actions);
+    }
+
   private:
     /* The timer for this action */
-    Timer _timer;
+    WheelTimer _timer;
 
     /* Whether timer triggered by groups' owner or property value states */
     bool _byOwner;
 
+    /* The groups' missing owner counts when triggered by owner states,
+     * found on the first run */
+    std::vector<const size_t*> _missingOwners;
+
     /* Timer interval for this action's timer */
     std::chrono::microseconds _interval;
 
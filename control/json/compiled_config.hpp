@@ -0,0 +1,123 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <variant>
+
+namespace phosphor::fan::control::json::compiled
+{
+
+/*
+ * The machine's configuration, compiled in by gen-json-config-defs.py when
+ * the build is configured with CONTROL_JSON_CONFIG_DIRS.
+ */
+
+/**
+ * A group from groups.json
+ */
+struct GroupDef
+{
+    /* The group's name */
+    std::string_view name;
+
+    /* The service serving the members, empty when not given */
+    std::string_view service;
+
+    /* The profiles the group is used in, empty for all */
+    std::span<const std::string_view> profiles;
+
+    /* The members, as indices into the member paths */
+    std::span<const size_t> members;
+};
+
+/**
+ * A value in a mapped_floor action's floor table, where any number is
+ * already a double, as the values it's compared to are
+ */
+using FloorValue = std::variant<bool, double, std::string_view>;
+
+/**
+ * A floor of a group or parameter's value in a mapped_floor action's table
+ */
+struct FloorEntryDef
+{
+    FloorValue value;
+    uint64_t floor;
+};
+
+/**
+ * The floors of a group or parameter in a mapped_floor action's table
+ */
+struct FloorGroupDef
+{
+    /* The group's name, empty when a parameter is used */
+    std::string_view group;
+
+    /* The parameter's name, empty when a group is used */
+    std::string_view parameter;
+
+    std::span<const FloorEntryDef> floors;
+};
+
+/**
+ * The floors used for key group values below a mapped_floor action's key
+ */
+struct FanFloorsDef
+{
+    FloorValue key;
+    std::string_view offsetParameter;
+    std::optional<uint64_t> defaultFloor;
+    std::span<const FloorGroupDef> floorGroups;
+};
+
+/**
+ * @brief Get a compiled in configuration file's contents
+ *
+ * The events.json entries of mapped_floor actions have their `fan_floors`
+ * replaced with a `compiled_floors` index into the floor tables.
+ *
+ * @param[in] fileName - The configuration file name
+ *
+ * @return The file's JSON, or std::nullopt when the file wasn't part of
+ *         the machine's configuration
+ */
+std::optional<std::string_view> getConfig(std::string_view fileName);
+
+/**
+ * @brief Get the member paths of all of the groups, each path once
+ */
+std::span<const std::string_view> getPaths();
+
+/**
+ * @brief Get the groups from groups.json
+ */
+std::span<const GroupDef> getGroups();
+
+/**
+ * @brief Get a mapped_floor action's floor table
+ *
+ * @param[in] index - The action's `compiled_floors` index
+ *
+ * @return The floor table, or std::nullopt for an unknown index
+ */
+std::optional<std::span<const FanFloorsDef>> getFloorTable(size_t index);
+
+} // namespace phosphor::fan::control::json::compiled
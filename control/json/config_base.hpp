@@ -65,6 +65,20 @@ class ConfigBase
         }
     }
 
+    /**
+     * Constructor
+     * Creates a config base from configuration compiled in, not parsed
+     * from JSON
+     *
+     * @param[in] name - Name of the configuration object
+     * @param[in] profiles - Profiles the configuration object is used in
+     */
+    ConfigBase(const std::string& name,
+               const std::vector<std::string>& profiles) :
+        _name(name),
+        _profiles(profiles)
+    {}
+
     /**
      * Copy Constructor
      * Creates a config base from another config base's originally parsed JSON
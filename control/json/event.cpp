@@ -96,7 +96,7 @@ std::map<configKey, std::unique_ptr<Group>>&
 {
     if (allGroups.empty() && loadGroups)
     {
-        allGroups = Manager::getConfig<Group>(true);
+        allGroups = Manager::getGroups();
     }
 
     return allGroups;
@@ -296,6 +296,12 @@ void Event::setTriggers(const json& jsonObj)
             _triggers.emplace_back(
                 trigFunc->first,
                 trigFunc->second(jsonTrig, getName(), _actions));
+            if (tClass == "parameter")
+            {
+                // Trigger parsing already required the parameter name
+                _paramTriggers.emplace_back(
+                    jsonTrig["parameter"].get<std::string>());
+            }
         }
         else
         {
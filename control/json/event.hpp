@@ -141,6 +141,26 @@ class Event : public ConfigBase
                           const std::vector<std::string>& profiles,
                           std::vector<Group>& groups);
 
+    /**
+     * @brief Get the actions of the event
+     *
+     * @return List of the event's actions
+     */
+    inline const auto& getActions() const
+    {
+        return _actions;
+    }
+
+    /**
+     * @brief Get the parameters that trigger the event's actions
+     *
+     * @return List of parameter names from the event's parameter triggers
+     */
+    inline const auto& getParameterTriggers() const
+    {
+        return _paramTriggers;
+    }
+
     /**
      * @brief Return the contained groups and actions as JSON
      *
@@ -167,6 +187,9 @@ class Event : public ConfigBase
     /* List of trigger type and enablement functions for this event */
     std::vector<std::tuple<std::string, trigger::enableTrigger>> _triggers;
 
+    /* List of parameter names from the event's parameter triggers */
+    std::vector<std::string> _paramTriggers;
+
     /* All groups available to be configred on events */
     static std::map<configKey, std::unique_ptr<Group>> allGroups;
 
@@ -13,9 +13,13 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "config.h"
+
 #include "fan.hpp"
 
 #include "sdbusplus.hpp"
+#include "utils/bus_interface.hpp"
+#include "utils/dbus_worker.hpp"
 
 #include <fmt/format.h>
 
@@ -32,11 +36,11 @@ using namespace phosphor::logging;
 constexpr auto FAN_SENSOR_PATH = "/xyz/openbmc_project/sensors/fan_tach/";
 constexpr auto FAN_TARGET_PROPERTY = "Target";
 
-Fan::Fan(const json& jsonObj) :
-    ConfigBase(jsonObj), _bus(util::SDBusPlus::getBus())
+Fan::Fan(const json& jsonObj) : ConfigBase(jsonObj)
 {
     setInterface(jsonObj);
     setSensors(jsonObj);
+    setSysfsTargets(jsonObj);
     setZone(jsonObj);
 }
 
@@ -60,19 +64,40 @@ void Fan::setSensors(const json& jsonObj)
                         entry("JSON=%s", jsonObj.dump().c_str()));
         throw std::runtime_error("Missing required fan sensors list");
     }
+    auto& bus = BusInterfaceBase::getInstance();
     std::string path;
     for (const auto& sensor : jsonObj["sensors"])
     {
         path = FAN_SENSOR_PATH + sensor.get<std::string>();
-        auto service = util::SDBusPlus::getService(_bus, path, _interface);
+        auto service = bus.getService(path, _interface);
         _sensors[path] = service;
     }
     // All sensors associated with this fan are set to the same target,
     // so only need to read target property from one of them
     if (!path.empty())
     {
-        _target = util::SDBusPlus::getProperty<uint64_t>(
-            _bus, _sensors.at(path), path, _interface, FAN_TARGET_PROPERTY);
+        _target = bus.getTarget(_sensors.at(path), path, _interface);
+    }
+}
+
+void Fan::setSysfsTargets(const json& jsonObj)
+{
+    if (!jsonObj.contains("sysfs_targets"))
+    {
+        return;
+    }
+    for (const auto& [sensor, attr] : jsonObj["sysfs_targets"].items())
+    {
+        auto path = FAN_SENSOR_PATH + sensor;
+        if (_sensors.find(path) == _sensors.end())
+        {
+            log<level::ERR>("Sysfs target given for a sensor not in the fan",
+                            entry("JSON=%s", jsonObj.dump().c_str()),
+                            entry("SENSOR=%s", sensor.c_str()));
+            throw std::runtime_error(
+                "Sysfs target given for a sensor not in the fan");
+        }
+        _sysfsTargets.try_emplace(path, attr.get<std::string>());
     }
 }
 
@@ -89,30 +114,127 @@ void Fan::setZone(const json& jsonObj)
 
 void Fan::setTarget(uint64_t target)
 {
-    if ((_target == target) || !_lockedTargets.empty())
+    if (((_target == target) && !*_writeFailed) || !_lockedTargets.empty())
     {
         return;
     }
 
-    for (const auto& sensor : _sensors)
+#ifdef CONTROL_USE_IO_THREAD
+    *_writeFailed = false;
+#endif
+    for (const auto& [path, service] : _sensors)
     {
-        auto value = target;
-        try
+        auto itSysfs = _sysfsTargets.find(path);
+        if ((itSysfs != _sysfsTargets.end()) && itSysfs->second.write(target))
         {
-            util::SDBusPlus::setProperty<uint64_t>(
-                _bus, sensor.second, sensor.first, _interface,
-                FAN_TARGET_PROPERTY, std::move(value));
-        }
-        catch (const sdbusplus::exception::exception&)
-        {
-            throw util::DBusPropertyError{
-                fmt::format("Failed to set target for fan {}", _name).c_str(),
-                sensor.second, sensor.first, _interface, FAN_TARGET_PROPERTY};
+            publishSensorTarget(path, service, target);
+            continue;
         }
+#ifdef CONTROL_USE_IO_THREAD
+        postSensorTarget(path, service, target);
+#else
+        setSensorTarget(path, service, target);
+#endif
     }
     _target = target;
 }
 
+#ifdef CONTROL_USE_IO_THREAD
+void Fan::postSensorTarget(const std::string& path, const std::string& service,
+                           uint64_t target)
+{
+    // Write the target from the I/O thread so a slow fan sensor service
+    // doesn't hold up the event loop. Only the latest target is kept
+    // pending per sensor, so an older target can't be written after it.
+    auto& pending = _pendingTargets[path];
+    if (!pending)
+    {
+        pending = std::make_shared<DBusWorker::LatestValue>(
+            [path = path, service = service,
+             intf = _interface](auto& bus, uint64_t value) {
+                util::SDBusPlus::setProperty<uint64_t>(
+                    bus, service, path, intf, FAN_TARGET_PROPERTY,
+                    std::move(value));
+            },
+            [failed = std::weak_ptr<bool>(_writeFailed), name = _name,
+             path = path](std::exception_ptr error) {
+                if (!error)
+                {
+                    return;
+                }
+                try
+                {
+                    std::rethrow_exception(error);
+                }
+                catch (const std::exception& e)
+                {
+                    log<level::ERR>(
+                        fmt::format(
+                            "Failed to set target for fan {} on {}: {}", name,
+                            path, e.what())
+                            .c_str());
+                }
+                // Rewrite the target on the next request, even if unchanged
+                if (auto writeFailed = failed.lock())
+                {
+                    *writeFailed = true;
+                }
+            });
+    }
+
+    if (!DBusWorker::instance().postLatest(pending, target))
+    {
+        log<level::ERR>(
+            fmt::format("Too many pending target writes, fan {} on {} "
+                        "not set to {}",
+                        _name, path, target)
+                .c_str());
+        *_writeFailed = true;
+    }
+}
+#endif
+
+void Fan::publishSensorTarget(const std::string& path,
+                              const std::string& service, uint64_t target)
+{
+    // The sysfs attribute already has the target, so the sensor's Target
+    // property is updated for its readers without waiting on the service.
+    // The service writes the target to the attribute again, and as it
+    // handles the sets in order, the last one it writes is the latest.
+#ifdef CONTROL_USE_IO_THREAD
+    postSensorTarget(path, service, target);
+#else
+    try
+    {
+        BusInterfaceBase::getInstance().publishTarget(service, path,
+                                                      _interface, target);
+    }
+    catch (const sdbusplus::exception::exception& e)
+    {
+        log<level::ERR>(
+            fmt::format("Failed to publish target for fan {} on {}: {}",
+                        _name, path, e.what())
+                .c_str());
+    }
+#endif
+}
+
+void Fan::setSensorTarget(const std::string& path, const std::string& service,
+                          uint64_t target)
+{
+    try
+    {
+        BusInterfaceBase::getInstance().setTarget(service, path, _interface,
+                                                  target);
+    }
+    catch (const sdbusplus::exception::exception&)
+    {
+        throw util::DBusPropertyError{
+            fmt::format("Failed to set target for fan {}", _name).c_str(),
+            service, path, _interface, FAN_TARGET_PROPERTY};
+    }
+}
+
 void Fan::lockTarget(uint64_t target)
 {
     // if multiple locks, take highest, else allow only the
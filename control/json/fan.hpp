@@ -16,11 +16,13 @@
 #pragma once
 
 #include "config_base.hpp"
+#include "utils/dbus_worker.hpp"
+#include "utils/sysfs_target.hpp"
 
 #include <nlohmann/json.hpp>
-#include <sdbusplus/bus.hpp>
 
 #include <map>
+#include <memory>
 
 namespace phosphor::fan::control::json
 {
@@ -110,6 +112,16 @@ class Fan : public ConfigBase
      */
     void setTarget(uint64_t target);
 
+    /**
+     * @brief Get the target locks active on the fan
+     *
+     * @return - List of the locked targets
+     */
+    inline const auto& getLockedTargets() const
+    {
+        return _lockedTargets;
+    }
+
   private:
     /**
      * Forces all contained sensors to the target (if this target is the
@@ -127,8 +139,39 @@ class Fan : public ConfigBase
      */
     void unlockTarget(uint64_t target);
 
-    /* The sdbusplus bus object */
-    sdbusplus::bus::bus& _bus;
+    /**
+     * @brief Write the target to one of the fan's sensors from the event
+     * loop thread
+     *
+     * @param[in] path - The sensor's object path
+     * @param[in] service - The service providing the sensor
+     * @param[in] target - The target to write
+     */
+    void setSensorTarget(const std::string& path, const std::string& service,
+                         uint64_t target);
+
+    /**
+     * @brief Post the write of the target to one of the fan's sensors to
+     * the I/O thread, replacing the target of any write to it still
+     * pending there
+     *
+     * @param[in] path - The sensor's object path
+     * @param[in] service - The service providing the sensor
+     * @param[in] target - The target to write
+     */
+    void postSensorTarget(const std::string& path, const std::string& service,
+                          uint64_t target);
+
+    /**
+     * @brief Update the target property of a sensor whose sysfs attribute
+     * the target was written to, without waiting for the service
+     *
+     * @param[in] path - The sensor's object path
+     * @param[in] service - The service providing the sensor
+     * @param[in] target - The target written
+     */
+    void publishSensorTarget(const std::string& path,
+                             const std::string& service, uint64_t target);
 
     /**
      * Interface containing the `Target` property
@@ -142,12 +185,28 @@ class Fan : public ConfigBase
     /* list of locked targets active on this fan */
     std::vector<uint64_t> _lockedTargets;
 
+    /* Set when a target write done from the I/O thread failed */
+    std::shared_ptr<bool> _writeFailed = std::make_shared<bool>(false);
+
     /**
      * Map of sensors containing the `Target` property on
      * dbus to the service providing them that make up the fan
      */
     std::map<std::string, std::string> _sensors;
 
+    /**
+     * Map of the sensors whose targets are written straight to their
+     * hwmon sysfs attributes to the attributes' writers
+     */
+    std::map<std::string, SysfsTarget> _sysfsTargets;
+
+    /**
+     * Map of sensors to the latest target to write to each from the I/O
+     * thread
+     */
+    std::map<std::string, std::shared_ptr<DBusWorker::LatestValue>>
+        _pendingTargets;
+
     /* The zone this fan belongs to */
     std::string _zone;
 
@@ -170,6 +229,16 @@ class Fan : public ConfigBase
      */
     void setSensors(const json& jsonObj);
 
+    /**
+     * @brief Parse and set the fan's sensors' sysfs target attributes
+     *
+     * @param[in] jsonObj - JSON object for the fan
+     *
+     * Sets the hwmon sysfs attributes(OPTIONAL) to write the targets of
+     * the given sensors to, instead of their `Target` property on dbus.
+     */
+    void setSysfsTargets(const json& jsonObj);
+
     /**
      * @brief Parse and set the fan's zone
      *
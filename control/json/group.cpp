@@ -36,6 +36,20 @@ Group::Group(const json& jsonObj) : ConfigBase(jsonObj), _service("")
     }
 }
 
+Group::Group(const compiled::GroupDef& group) :
+    ConfigBase(std::string{group.name},
+               std::vector<std::string>{group.profiles.begin(),
+                                        group.profiles.end()}),
+    _service(group.service)
+{
+    const auto paths = compiled::getPaths();
+    for (auto member : group.members)
+    {
+        _members.emplace_back(paths[member]);
+    }
+    _allMembers.insert(_members.begin(), _members.end());
+}
+
 Group::Group(const Group& origObj) : ConfigBase(origObj)
 {
     // Copy everything from the original Group object
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "compiled_config.hpp"
 #include "config_base.hpp"
 
 #include <nlohmann/json.hpp>
@@ -60,6 +61,14 @@ class Group : public ConfigBase
      */
     Group(const json& jsonObj);
 
+    /**
+     * Constructor
+     * Populates a configuration group from a compiled in group
+     *
+     * @param[in] group - The compiled in group
+     */
+    Group(const compiled::GroupDef& group);
+
     /**
      * Copy Constructor
      * Creates a group from another group's originally parsed JSON object data
@@ -18,6 +18,9 @@
 #include "manager.hpp"
 
 #include "action.hpp"
+#ifdef CONTROL_USE_COMPILED_JSON
+#include "compiled_config.hpp"
+#endif
 #include "event.hpp"
 #include "fan.hpp"
 #include "group.hpp"
@@ -25,11 +28,22 @@
 #include "power_state.hpp"
 #include "profile.hpp"
 #include "sdbusplus.hpp"
+#include "sdeventplus.hpp"
+#include "utils/dbus_worker.hpp"
 #include "utils/flight_recorder.hpp"
 #include "zone.hpp"
 
+#include <fcntl.h>
 #include <systemd/sd-bus.h>
-
+#include <unistd.h>
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/cereal.hpp>
+#include <cereal/types/map.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/tuple.hpp>
+#include <cereal/types/unordered_map.hpp>
+#include <cereal/types/variant.hpp>
 #include <nlohmann/json.hpp>
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/server/manager.hpp>
@@ -38,11 +52,19 @@
 
 #include <algorithm>
 #include <chrono>
+#include <deque>
 #include <filesystem>
+#include <fstream>
 #include <functional>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <system_error>
 #include <tuple>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -50,6 +72,20 @@ namespace phosphor::fan::control::json
 {
 
 using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+/* State snapshot file name and format version */
+constexpr auto snapshotFile = "state_snapshot";
+constexpr uint32_t snapshotVersion = 2;
+
+/* How often the state snapshot is saved */
+constexpr auto snapshotInterval = std::chrono::seconds(30);
+
+/* How long properties seeded from the snapshot are used without a refresh */
+constexpr auto seedLifetime = std::chrono::seconds(30);
+
+/* Interface of the fans whose targets are PWM duty cycles */
+constexpr auto fanPwmIntf = "xyz.openbmc_project.Control.FanPwm";
 
 std::vector<std::string> Manager::_activeProfiles;
 std::map<std::string,
@@ -59,7 +95,19 @@ std::map<std::string,
          std::map<std::string, std::map<std::string, PropertyVariantType>>>
     Manager::_objects;
 std::unordered_map<std::string, PropertyVariantType> Manager::_parameters;
+std::map<std::pair<std::string, std::string>, NumericColumn>
+    Manager::_numericColumns;
+std::map<std::pair<std::string, std::vector<std::string>>, size_t>
+    Manager::_missingOwners;
+std::unordered_map<std::string, std::vector<Manager::OwnerWatch>>
+    Manager::_ownerWatches;
 std::unordered_map<std::string, TriggerActions> Manager::_parameterTriggers;
+std::unordered_map<const ActionBase*, size_t> Manager::_actionRanks;
+std::set<std::pair<size_t, ActionBase*>> Manager::_waveActions;
+std::unordered_set<const ActionBase*> Manager::_waveRan;
+bool Manager::_inWave = false;
+std::unordered_map<std::string, std::set<std::pair<std::string, std::string>>>
+    Manager::_seeded;
 
 const std::string Manager::dumpFile = "/tmp/fan_control_dump.json";
 
@@ -69,13 +117,34 @@ Manager::Manager(const sdeventplus::Event& event) :
     _powerState(std::make_unique<PGoodState>(
         util::SDBusPlus::getBus(),
         std::bind(std::mem_fn(&Manager::powerStateChanged), this,
-                  std::placeholders::_1)))
-{}
+                  std::placeholders::_1))),
+    _snapshotTimer(getTimerWheel(),
+                   std::bind(&Manager::saveSnapshot, this, false)),
+    _configHash(0),
+    _telemetryTimer(getTimerWheel(),
+                    std::bind(&Manager::publishTelemetry, this)),
+    _seedExpiryTimer(getTimerWheel(), std::bind(&Manager::expireSeeded, this))
+{
+    try
+    {
+        _telemetry = std::make_unique<telemetry::Writer>();
+    }
+    catch (const std::exception& e)
+    {
+        // Fan control runs fine without publishing telemetry
+        log<level::ERR>(
+            fmt::format("Unable to create telemetry region: {}", e.what())
+                .c_str());
+    }
+}
 
 void Manager::sighupHandler(sdeventplus::source::Signal&,
                             const struct signalfd_siginfo*)
 {
     FlightRecorder::instance().log("main", "SIGHUP received");
+    // Keep the current state in case the reload loads the same config
+    saveSnapshot(true);
+
     // Save current set of available and active profiles
     std::map<configKey, std::unique_ptr<Profile>> profiles;
     profiles.swap(_profiles);
@@ -109,6 +178,19 @@ void Manager::sigUsr1Handler(sdeventplus::source::Signal&,
                           std::placeholders::_1));
 }
 
+void Manager::sigtermHandler(sdeventplus::source::Signal&,
+                             const struct signalfd_siginfo*)
+{
+    FlightRecorder::instance().log("main", "SIGTERM received");
+    saveSnapshot(true);
+    if (_telemetry)
+    {
+        // Readers go back to D-Bus once fan control is stopped
+        _telemetry->invalidate();
+    }
+    _event.exit(0);
+}
+
 void Manager::dumpDebugData(sdeventplus::source::EventBase& /*source*/)
 {
     json data;
@@ -161,6 +243,12 @@ void Manager::dumpCache(json& data)
     });
 
     data["services"] = _servTree;
+
+    data["timers"] = getTimerWheel().dump();
+
+#ifdef CONTROL_USE_IO_THREAD
+    data["io_worker"] = DBusWorker::instance().dump();
+#endif
 }
 
 void Manager::load()
@@ -199,11 +287,16 @@ void Manager::load()
         auto groups = std::move(Event::getAllGroups(false));
         Event::clearAllGroups();
 
+        auto configHash = getConfigHash();
         std::map<configKey, std::unique_ptr<Event>> events;
+        std::unordered_map<const ActionBase*, size_t> actionRanks;
         try
         {
             // Load any events configured, including all the groups
             events = getConfig<Event>(true, this, zones);
+
+            // Reject configurations where parameters depend on themselves
+            actionRanks = getParameterGraph(events);
         }
         catch (const std::runtime_error& re)
         {
@@ -217,21 +310,418 @@ void Manager::load()
         std::for_each(_zones.begin(), _zones.end(),
                       [](const auto& entry) { entry.second->enable(); });
 
+        // Seed state from the last snapshot while events fetch live data
+        _configHash = configHash;
+        restoreSnapshot();
+
         // Clear current timers and signal subscriptions before enabling events
         // To save reloading services and/or objects into cache, do not clear
         // cache
         _timers.clear();
         _signals.clear();
+        _parameterTriggers.clear();
+        _actionRanks = std::move(actionRanks);
+
+        // Take a new snapshot of the bus name owners the first time the
+        // events enabled by this load need one
+        _ownedNames.reset();
+
+        // Drop the replaced events before enabling the new ones, releasing
+        // the hold identifiers their actions interned for reuse
+        _events.clear();
+        HoldIds::clear();
 
         // Enable events
         _events = std::move(events);
         std::for_each(_events.begin(), _events.end(),
                       [](const auto& entry) { entry.second->enable(); });
 
+        // Enabling the events refreshed what it could of the seeded
+        // objects, the rest are only used until they expire
+        if (!_seeded.empty())
+        {
+            _seedExpiryTimer.restartOnce(seedLifetime);
+        }
+        if (!_snapshotTimer.isEnabled())
+        {
+            _snapshotTimer.restart(snapshotInterval);
+        }
+        if (_telemetry)
+        {
+            publishTelemetry();
+            if (!_telemetryTimer.isEnabled())
+            {
+                _telemetryTimer.restart(telemetry::publishInterval);
+            }
+        }
+
         _loadAllowed = false;
     }
 }
 
+void Manager::queueTelemetry()
+{
+    if (_telemetry && !_telemetryEventSource)
+    {
+        _telemetryEventSource = std::make_unique<sdeventplus::source::Defer>(
+            _event, std::bind(std::mem_fn(&Manager::publishQueuedTelemetry),
+                              this, std::placeholders::_1));
+    }
+}
+
+void Manager::publishQueuedTelemetry(sdeventplus::source::EventBase&)
+{
+    publishTelemetry();
+    _telemetryEventSource.reset();
+}
+
+void Manager::publishTelemetry()
+{
+    _telemetry->publish([this](telemetry::Payload& payload) {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        payload.updated =
+            std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+
+        payload.numZones = 0;
+        payload.numFans = 0;
+        for (const auto& [key, zone] : _zones)
+        {
+            if (payload.numZones == telemetry::maxZones)
+            {
+                break;
+            }
+            auto& zoneEntry = payload.zones[payload.numZones++];
+            const auto [target, floor] = zone->getState();
+            const auto& targetHolds = zone->getTargetHolds();
+            const auto& floorHolds = zone->getFloorHolds();
+            telemetry::setName(zoneEntry.name, zone->getName());
+            zoneEntry.target = target;
+            zoneEntry.floor = floor;
+            zoneEntry.ceiling = zone->getCeiling();
+            zoneEntry.numTargetHolds = targetHolds.size();
+            zoneEntry.targetHold = targetHolds.max().value_or(0);
+            zoneEntry.numFloorHolds = floorHolds.size();
+            zoneEntry.floorHold = floorHolds.max().value_or(0);
+            zoneEntry.active = zone->isActive();
+
+            for (const auto& fan : zone->getFans())
+            {
+                if (payload.numFans == telemetry::maxFans)
+                {
+                    break;
+                }
+                auto& fanEntry = payload.fans[payload.numFans++];
+                const auto& locks = fan->getLockedTargets();
+                telemetry::setName(fanEntry.name, fan->getName());
+                telemetry::setName(fanEntry.zone, zone->getName());
+                fanEntry.target = fan->getTarget();
+                fanEntry.pwm = (fan->getInterface() == fanPwmIntf);
+                fanEntry.numLocks = locks.size();
+                fanEntry.lockedTarget =
+                    locks.empty()
+                        ? 0
+                        : *std::max_element(locks.begin(), locks.end());
+                fanEntry.numSensors = 0;
+                for (const auto& [path, service] : fan->getSensors())
+                {
+                    if (fanEntry.numSensors == telemetry::maxFanSensors)
+                    {
+                        break;
+                    }
+                    telemetry::setName(
+                        fanEntry.sensors[fanEntry.numSensors++], path);
+                }
+            }
+        }
+
+        payload.numActions = 0;
+        for (const auto& [key, event] : _events)
+        {
+            for (const auto& action : event->getActions())
+            {
+                if (payload.numActions == telemetry::maxActions)
+                {
+                    return;
+                }
+                auto& actionEntry = payload.actions[payload.numActions++];
+                telemetry::setName(actionEntry.name, action->getUniqueName());
+                actionEntry.runs = action->getRunCount();
+            }
+        }
+    });
+}
+
+namespace
+{
+
+/**
+ * @brief Get the 64-bit FNV-1a hash of a string
+ *
+ * Unlike std::hash, the value doesn't change between builds, so it can be
+ * kept in the state snapshot.
+ *
+ * @param[in] contents - The string
+ *
+ * @return The hash
+ */
+uint64_t fnv1a(const std::string& contents)
+{
+    uint64_t hash = 0xcbf29ce484222325;
+    for (auto c : contents)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+} // namespace
+
+uint64_t Manager::getConfigHash() const
+{
+    std::string contents;
+    for (const auto* fileName :
+         {Profile::confFileName, Zone::confFileName, Fan::confFileName,
+          Group::confFileName, Event::confFileName})
+    {
+        contents += readConfig(fileName);
+        contents += '\0';
+    }
+    for (const auto& profile : _activeProfiles)
+    {
+        contents += profile;
+        contents += '\0';
+    }
+
+    return fnv1a(contents);
+}
+
+namespace
+{
+
+/**
+ * @brief Write a file and flush it to storage
+ *
+ * @param[in] path - The file's path
+ * @param[in] contents - What to write to it
+ *
+ * @throws std::system_error when it can't be written
+ */
+void writeSynced(const fs::path& path, const std::string& contents)
+{
+    auto fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                     0644);
+    if (fd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to open " + path.string());
+    }
+    const auto* data = contents.data();
+    auto remaining = contents.size();
+    while (remaining)
+    {
+        auto written = ::write(fd, data, remaining);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            auto err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(),
+                                    "Failed to write " + path.string());
+        }
+        data += written;
+        remaining -= written;
+    }
+    if (::fsync(fd) < 0)
+    {
+        auto err = errno;
+        ::close(fd);
+        throw std::system_error(err, std::generic_category(),
+                                "Failed to sync " + path.string());
+    }
+    ::close(fd);
+}
+
+} // namespace
+
+void Manager::saveSnapshot(bool withObjects)
+{
+    if (_zones.empty())
+    {
+        // No configuration loaded yet
+        return;
+    }
+
+    std::map<std::string, ZoneState> zones;
+    for (const auto& [key, zone] : _zones)
+    {
+        zones.emplace(zone->getName(), zone->getState());
+    }
+
+    fs::path path{CONTROL_PERSIST_ROOT_PATH};
+    path /= snapshotFile;
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+
+    try
+    {
+        std::ostringstream data;
+        {
+            cereal::BinaryOutputArchive oArch(data);
+            oArch(snapshotVersion, _configHash, zones, _parameters);
+            // The object cache changes with every sensor reading, so it's
+            // only kept when stopping or reloading, not periodically
+            if (withObjects)
+            {
+                oArch(_objects);
+            }
+            else
+            {
+                oArch(decltype(_objects){});
+            }
+        }
+        auto contents = data.str();
+        auto hash = std::hash<std::string>{}(contents);
+        if (_snapshotHash == hash)
+        {
+            // Nothing changed since the last snapshot
+            return;
+        }
+
+        fs::create_directories(path.parent_path());
+        writeSynced(tmpPath, contents);
+        // Replace the last snapshot only once the new one is complete
+        fs::rename(tmpPath, path);
+        _snapshotHash = hash;
+    }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>(
+            fmt::format("Unable to save state snapshot: {}", e.what())
+                .c_str());
+    }
+}
+
+void Manager::restoreSnapshot()
+{
+    fs::path path{CONTROL_PERSIST_ROOT_PATH};
+    path /= snapshotFile;
+    if (!fs::exists(path))
+    {
+        return;
+    }
+
+    uint32_t version = 0;
+    uint64_t configHash = 0;
+    std::map<std::string, ZoneState> zones;
+    std::unordered_map<std::string, PropertyVariantType> parameters;
+    std::map<std::string,
+             std::map<std::string, std::map<std::string, PropertyVariantType>>>
+        objects;
+    try
+    {
+        std::ifstream ifs(path.c_str(), std::ios::in | std::ios::binary);
+        cereal::BinaryInputArchive iArch(ifs);
+        iArch(version, configHash);
+        if (version != snapshotVersion || configHash != _configHash)
+        {
+            FlightRecorder::instance().log(
+                "main", "State snapshot is from a different configuration");
+            return;
+        }
+        iArch(zones, parameters, objects);
+    }
+    catch (const std::exception& e)
+    {
+        // Include possible exception when removing file, otherwise ec = 0
+        std::error_code ec;
+        fs::remove(path, ec);
+        log<level::ERR>(fmt::format("Unable to restore state snapshot ({}, "
+                                    "ec: {})",
+                                    e.what(), ec.value())
+                            .c_str());
+        return;
+    }
+
+    for (const auto& [key, zone] : _zones)
+    {
+        auto itZone = zones.find(zone->getName());
+        if (itZone != zones.end())
+        {
+            zone->restoreState(itZone->second);
+        }
+    }
+
+    for (auto& [name, value] : parameters)
+    {
+        _parameters.try_emplace(name, std::move(value));
+    }
+
+    for (auto& [objPath, intfs] : objects)
+    {
+        for (auto& [intf, props] : intfs)
+        {
+            for (auto& [prop, value] : props)
+            {
+                auto [itProp, added] =
+                    _objects[objPath][intf].try_emplace(prop, std::move(value));
+                if (added)
+                {
+                    auto itColumn = _numericColumns.find({intf, prop});
+                    if (itColumn != _numericColumns.end())
+                    {
+                        itColumn->second.set(objPath, itProp->second);
+                    }
+                    ChangeTracker::changed(objPath, intf, prop);
+                    _seeded[objPath].emplace(intf, prop);
+                }
+            }
+        }
+    }
+
+    FlightRecorder::instance().log("main", "Restored state snapshot");
+}
+
+void Manager::expireSeeded()
+{
+    size_t expired = 0;
+    for (const auto& [path, props] : _seeded)
+    {
+        auto itPath = _objects.find(path);
+        if (itPath == _objects.end())
+        {
+            continue;
+        }
+        for (const auto& [intf, prop] : props)
+        {
+            auto itIntf = itPath->second.find(intf);
+            if ((itIntf == itPath->second.end()) || !itIntf->second.erase(prop))
+            {
+                continue;
+            }
+            auto itColumn = _numericColumns.find({intf, prop});
+            if (itColumn != _numericColumns.end())
+            {
+                itColumn->second.erase(path);
+            }
+            ChangeTracker::changed(path, intf, prop);
+            expired++;
+        }
+    }
+    _seeded.clear();
+
+    if (expired)
+    {
+        FlightRecorder::instance().log(
+            "main",
+            fmt::format("Removed {} seeded properties that weren't refreshed",
+                        expired));
+    }
+}
+
 void Manager::powerStateChanged(bool powerStateOn)
 {
     if (powerStateOn)
@@ -295,6 +785,104 @@ bool Manager::inConfig(const configKey& input, const configKey& comp)
     }
 }
 
+json Manager::loadConfig(const std::string& fileName, bool isOptional)
+{
+#ifdef CONTROL_USE_COMPILED_JSON
+    if (!fs::exists(fs::path{fan::confOverridePath} / confAppName / fileName))
+    {
+        auto contents = compiled::getConfig(fileName);
+        if (!contents)
+        {
+            if (!isOptional)
+            {
+                throw fan::NoConfigFound(confAppName, fileName);
+            }
+            return json{};
+        }
+        FlightRecorder::instance().log(
+            "main", fmt::format("Loading compiled in configuration {}",
+                                fileName));
+        // Comments were already removed when compiling it in
+        return json::parse(contents->begin(), contents->end());
+    }
+#endif
+
+    auto confFile = fan::JsonConfig::getConfFile(
+        util::SDBusPlus::getBus(), confAppName, fileName, isOptional);
+    if (confFile.empty())
+    {
+        return json{};
+    }
+    FlightRecorder::instance().log(
+        "main",
+        fmt::format("Loading configuration from {}", confFile.string()));
+    return fan::JsonConfig::load(confFile);
+}
+
+std::string Manager::readConfig(const std::string& fileName)
+{
+#ifdef CONTROL_USE_COMPILED_JSON
+    if (!fs::exists(fs::path{fan::confOverridePath} / confAppName / fileName))
+    {
+        auto contents = compiled::getConfig(fileName);
+        return contents ? std::string{*contents} : std::string{};
+    }
+#endif
+
+    std::string contents;
+    auto confFile = fan::JsonConfig::getConfFile(
+        util::SDBusPlus::getBus(), confAppName, fileName, true);
+    if (!confFile.empty())
+    {
+        std::ifstream file{confFile};
+        contents.append(std::istreambuf_iterator<char>(file),
+                        std::istreambuf_iterator<char>());
+    }
+    return contents;
+}
+
+std::map<configKey, std::unique_ptr<Group>> Manager::getGroups()
+{
+#ifdef CONTROL_USE_COMPILED_JSON
+    if (!fs::exists(fs::path{fan::confOverridePath} / confAppName /
+                    Group::confFileName))
+    {
+        std::map<configKey, std::unique_ptr<Group>> groups;
+        for (const auto& def : compiled::getGroups())
+        {
+            // Do not create the group if its profiles are not in the list
+            // of active profiles
+            if (!hasActiveProfile(std::vector<std::string>{
+                    def.profiles.begin(), def.profiles.end()}))
+            {
+                continue;
+            }
+            auto group = std::make_unique<Group>(def);
+            groups.emplace(
+                std::make_pair(group->getName(), group->getProfiles()),
+                std::move(group));
+        }
+        FlightRecorder::instance().log(
+            "main", fmt::format("Loaded {} compiled in groups", groups.size()));
+        return groups;
+    }
+#endif
+
+    return getConfig<Group>(true);
+}
+
+bool Manager::hasActiveProfile(const std::vector<std::string>& profiles)
+{
+    const auto& activeProfiles = getActiveProfiles();
+    return profiles.empty() ||
+           std::any_of(profiles.begin(), profiles.end(),
+                       [&activeProfiles](const auto& name) {
+                           return std::find(activeProfiles.begin(),
+                                            activeProfiles.end(),
+                                            name) != activeProfiles.end();
+                       });
+}
+
 bool Manager::hasOwner(const std::string& path, const std::string& intf)
 {
     auto itServ = _servTree.find(path);
@@ -327,6 +915,7 @@ void Manager::setOwner(const std::string& serv, bool hasOwner)
         if (itServ != itPath.second.end())
         {
             itServ->second.first = hasOwner;
+            updateOwnerCounts(itPath.first);
 
             // Remove associated interfaces from object cache when service no
             // longer has an owner
@@ -335,6 +924,8 @@ void Manager::setOwner(const std::string& serv, bool hasOwner)
                 for (auto& intf : itServ->second.second)
                 {
                     _objects[itPath.first].erase(intf);
+                    eraseNumericValues(itPath.first, intf);
+                    ChangeTracker::removed(itPath.first, intf);
                 }
             }
         }
@@ -354,6 +945,7 @@ void Manager::setOwner(const std::string& path, const std::string& serv,
     {
         ownIntf.second.emplace_back(intf);
     }
+    updateOwnerCounts(path);
 
     // Update owner state on all entries of the same `serv` & `intf`
     for (auto& itPath : _servTree)
@@ -375,11 +967,56 @@ void Manager::setOwner(const std::string& path, const std::string& serv,
             if (itIntf != std::end(itServ.second.second))
             {
                 itServ.second.first = isOwned;
+                updateOwnerCounts(itPath.first);
             }
         }
     }
 }
 
+bool Manager::nameHasOwner(const std::string& serv)
+{
+    if (!_ownedNames)
+    {
+        if (!_nameOwnerMatch)
+        {
+            // Subscribe before taking the snapshot so no change is missed
+            _nameOwnerMatch = std::make_unique<sdbusplus::bus::match_t>(
+                _bus, sdbusplus::bus::match::rules::nameOwnerChanged(),
+                std::bind(std::mem_fn(&Manager::nameOwnerChanged), this,
+                          std::placeholders::_1));
+        }
+        auto names = BusInterfaceBase::getInstance().listNames();
+        _ownedNames = std::unordered_set<std::string>(
+            std::make_move_iterator(names.begin()),
+            std::make_move_iterator(names.end()));
+    }
+
+    return _ownedNames->find(serv) != _ownedNames->end();
+}
+
+void Manager::nameOwnerChanged(sdbusplus::message::message& msg)
+{
+    if (!_ownedNames)
+    {
+        // No snapshot to keep current
+        return;
+    }
+
+    std::string name;
+    std::string oldOwner;
+    std::string newOwner;
+    msg.read(name, oldOwner, newOwner);
+
+    if (newOwner.empty())
+    {
+        _ownedNames->erase(name);
+    }
+    else
+    {
+        _ownedNames->insert(std::move(name));
+    }
+}
+
 const std::string& Manager::findService(const std::string& path,
                                         const std::string& intf)
 {
@@ -407,8 +1044,8 @@ const std::string& Manager::findService(const std::string& path,
 void Manager::addServices(const std::string& intf, int32_t depth)
 {
     // Get all subtree objects for the given interface
-    auto objects = util::SDBusPlus::getSubTreeRaw(util::SDBusPlus::getBus(),
-                                                  "/", intf, depth);
+    auto objects =
+        BusInterfaceBase::getInstance().getSubTree("/", intf, depth);
     // Add what's returned to the cache of path->services
     for (auto& itPath : objects)
     {
@@ -447,6 +1084,7 @@ void Manager::addServices(const std::string& intf, int32_t depth)
                 _servTree[itPath.first][servName] = std::make_pair(true, intfs);
             }
         }
+        updateOwnerCounts(itPath.first);
     }
 }
 
@@ -571,9 +1209,8 @@ void Manager::addObjects(const std::string& path, const std::string& intf,
         // Attempt to retrieve property directly
         try
         {
-            auto value =
-                util::SDBusPlus::getPropertyVariant<PropertyVariantType>(
-                    _bus, service, path, intf, prop);
+            auto value = BusInterfaceBase::getInstance().getProperty(
+                service, path, intf, prop);
 
             setProperty(path, intf, prop, value);
         }
@@ -585,8 +1222,8 @@ void Manager::addObjects(const std::string& path, const std::string& intf,
     for (const auto& objMgrPath : objMgrPaths)
     {
         // Get all managed objects of service
-        auto objects = util::SDBusPlus::getManagedObjects<PropertyVariantType>(
-            _bus, service, objMgrPath);
+        auto objects = BusInterfaceBase::getInstance().getManagedObjects(
+            service, objMgrPath);
 
         // insert all objects that are in groups but remove any NaN values
         insertFilteredObjects(objects);
@@ -619,6 +1256,21 @@ const std::optional<PropertyVariantType>
 void Manager::setProperty(const std::string& path, const std::string& intf,
                           const std::string& prop, PropertyVariantType value)
 {
+    auto itColumn = _numericColumns.empty()
+                        ? _numericColumns.end()
+                        : _numericColumns.find({intf, prop});
+
+    if (!_seeded.empty())
+    {
+        // The property is live now, so it no longer expires
+        auto itSeeded = _seeded.find(path);
+        if ((itSeeded != _seeded.end()) &&
+            itSeeded->second.erase({intf, prop}) && itSeeded->second.empty())
+        {
+            _seeded.erase(itSeeded);
+        }
+    }
+
     // filter NaNs out of the cache
     if (PropertyContainsNan(value))
     {
@@ -628,34 +1280,155 @@ void Manager::setProperty(const std::string& path, const std::string& intf,
         {
             _objects[path][intf].erase(prop);
         }
+        if (itColumn != _numericColumns.end())
+        {
+            itColumn->second.erase(path);
+        }
+        ChangeTracker::changed(path, intf, prop);
     }
     else
     {
+        if (itColumn != _numericColumns.end())
+        {
+            itColumn->second.set(path, value);
+        }
         _objects[path][intf][prop] = std::move(value);
+        ChangeTracker::changed(path, intf, prop);
     }
 }
 
+std::vector<NumericRange>
+    Manager::getNumericRanges(const std::vector<Group>& groups)
+{
+    std::vector<NumericRange> ranges;
+    ranges.reserve(groups.size());
+    for (const auto& group : groups)
+    {
+        auto& column =
+            _numericColumns[{group.getInterface(), group.getProperty()}];
+        bool added = false;
+        ranges.push_back(column.addRange(group.getMembers(), added));
+        if (!added)
+        {
+            continue;
+        }
+
+        // Start the new range out with what's already cached
+        for (const auto& member : group.getMembers())
+        {
+            auto valuePtr = getObjValuePtr(member, group.getInterface(),
+                                           group.getProperty());
+            if (valuePtr)
+            {
+                column.set(member, *valuePtr);
+            }
+        }
+    }
+    return ranges;
+}
+
+std::vector<const size_t*>
+    Manager::getMissingOwnerCounts(const std::vector<Group>& groups)
+{
+    std::vector<const size_t*> counts;
+    counts.reserve(groups.size());
+    for (const auto& group : groups)
+    {
+        const auto& intf = group.getInterface();
+        auto [itCount, added] =
+            _missingOwners.try_emplace({intf, group.getMembers()}, 0);
+        counts.push_back(&itCount->second);
+        if (!added)
+        {
+            continue;
+        }
+
+        // Start the new count out from the service tree cache
+        auto& count = itCount->second;
+        for (const auto& member : group.getMembers())
+        {
+            auto& watches = _ownerWatches[member];
+            auto itWatch = std::find_if(
+                watches.begin(), watches.end(),
+                [&intf](const auto& watch) { return watch.intf == intf; });
+            if (itWatch == watches.end())
+            {
+                itWatch = watches.insert(watches.end(),
+                                         {intf, hasOwner(member, intf), {}});
+            }
+            itWatch->counts.push_back(&count);
+            if (!itWatch->owned)
+            {
+                count++;
+            }
+        }
+    }
+    return counts;
+}
+
+void Manager::updateOwnerCounts(const std::string& path)
+{
+    auto itWatches = _ownerWatches.find(path);
+    if (itWatches == _ownerWatches.end())
+    {
+        return;
+    }
+    for (auto& watch : itWatches->second)
+    {
+        auto owned = hasOwner(path, watch.intf);
+        if (owned == watch.owned)
+        {
+            continue;
+        }
+        watch.owned = owned;
+        for (auto* count : watch.counts)
+        {
+            owned ? (*count)-- : (*count)++;
+        }
+    }
+}
+
+void Manager::eraseNumericValues(const std::string& path,
+                                 const std::string& intf)
+{
+    for (auto itColumn = _numericColumns.lower_bound({intf, std::string{}});
+         itColumn != _numericColumns.end() && itColumn->first.first == intf;
+         ++itColumn)
+    {
+        itColumn->second.erase(path);
+    }
+}
+
+TimerWheel& Manager::getTimerWheel()
+{
+    static TimerWheel wheel(util::SDEventPlus::getEvent(),
+                            std::chrono::milliseconds(CONTROL_TIMER_SLACK_MS));
+    return wheel;
+}
+
 void Manager::addTimer(const TimerType type,
                        const std::chrono::microseconds interval,
                        std::unique_ptr<TimerPkg> pkg)
 {
-    auto dataPtr =
-        std::make_unique<TimerData>(std::make_pair(type, std::move(*pkg)));
-    Timer timer(_event,
-                std::bind(&Manager::timerExpired, this, std::ref(*dataPtr)));
-    if (type == TimerType::repeating)
+    if (type != TimerType::repeating && type != TimerType::oneshot)
     {
-        timer.restart(interval);
+        throw std::invalid_argument("Invalid Timer Type");
     }
-    else if (type == TimerType::oneshot)
+
+    auto itTimer = _timers.emplace(
+        _timers.end(), std::piecewise_construct,
+        std::forward_as_tuple(type, std::move(*pkg)),
+        std::forward_as_tuple(getTimerWheel()));
+    auto& timer = itTimer->second;
+    timer.setCallback(std::bind(&Manager::timerExpired, this, itTimer));
+    if (type == TimerType::repeating)
     {
-        timer.restartOnce(interval);
+        timer.restart(interval);
     }
     else
     {
-        throw std::invalid_argument("Invalid Timer Type");
+        timer.restartOnce(interval);
     }
-    _timers.emplace_back(std::move(dataPtr), std::move(timer));
 }
 
 void Manager::addGroups(const std::vector<Group>& groups)
@@ -698,10 +1471,10 @@ void Manager::addGroups(const std::vector<Group>& groups)
                         // Attempt to retrieve group member property directly
                         try
                         {
-                            auto value = util::SDBusPlus::getPropertyVariant<
-                                PropertyVariantType>(_bus, service, member,
-                                                     group.getInterface(),
-                                                     group.getProperty());
+                            auto value =
+                                BusInterfaceBase::getInstance().getProperty(
+                                    service, member, group.getInterface(),
+                                    group.getProperty());
                             setProperty(member, group.getInterface(),
                                         group.getProperty(), value);
                         }
@@ -716,8 +1489,9 @@ void Manager::addGroups(const std::vector<Group>& groups)
                         for (const auto& objMgrPath : objMgrPaths)
                         {
                             // Get all managed objects from the service
-                            auto objects = util::SDBusPlus::getManagedObjects<
-                                PropertyVariantType>(_bus, service, objMgrPath);
+                            auto objects =
+                                BusInterfaceBase::getInstance()
+                                    .getManagedObjects(service, objMgrPath);
 
                             // Insert objects into cache
                             insertFilteredObjects(objects);
@@ -735,8 +1509,9 @@ void Manager::addGroups(const std::vector<Group>& groups)
     }
 }
 
-void Manager::timerExpired(TimerData& data)
+void Manager::timerExpired(TimerList::iterator timer)
 {
+    auto& data = timer->first;
     if (std::get<bool>(data.second))
     {
         addGroups(std::get<const std::vector<Group>&>(data.second));
@@ -751,16 +1526,7 @@ void Manager::timerExpired(TimerData& data)
     // Remove oneshot timers after they expired
     if (data.first == TimerType::oneshot)
     {
-        auto itTimer = std::find_if(
-            _timers.begin(), _timers.end(), [&data](const auto& timer) {
-                return (data.first == timer.first->first &&
-                        (std::get<std::string>(data.second) ==
-                         std::get<std::string>(timer.first->second)));
-            });
-        if (itTimer != std::end(_timers))
-        {
-            _timers.erase(itTimer);
-        }
+        _timers.erase(timer);
     }
 }
 
@@ -794,13 +1560,12 @@ void Manager::handleSignal(sdbusplus::message::message& msg,
 void Manager::setProfiles()
 {
     // Profiles JSON config file is optional
-    auto confFile = fan::JsonConfig::getConfFile(_bus, confAppName,
-                                                 Profile::confFileName, true);
+    auto entries = loadConfig(Profile::confFileName, true);
 
     _profiles.clear();
-    if (!confFile.empty())
+    if (!entries.is_null())
     {
-        for (const auto& entry : fan::JsonConfig::load(confFile))
+        for (const auto& entry : entries)
         {
             auto obj = std::make_unique<Profile>(entry);
             _profiles.emplace(
@@ -846,11 +1611,144 @@ void Manager::addParameterTrigger(
 void Manager::runParameterActions(const std::string& name)
 {
     auto it = _parameterTriggers.find(name);
-    if (it != _parameterTriggers.end())
+    if (it == _parameterTriggers.end())
+    {
+        return;
+    }
+
+    for (auto& action : it->second)
+    {
+        auto* actionPtr = action.get().get();
+        if (_waveRan.find(actionPtr) == _waveRan.end())
+        {
+            auto itRank = _actionRanks.find(actionPtr);
+            auto rank = (itRank != _actionRanks.end()) ? itRank->second : 0;
+            _waveActions.emplace(rank, actionPtr);
+        }
+    }
+
+    if (_inWave)
+    {
+        // Parameter set by an action of the running wave, which will run
+        // the queued actions in order
+        return;
+    }
+
+    // Run queued actions by rank, any actions queued by parameters they set
+    // are ranked after them
+    _inWave = true;
+    try
+    {
+        while (!_waveActions.empty())
+        {
+            auto* action = _waveActions.begin()->second;
+            _waveActions.erase(_waveActions.begin());
+            _waveRan.insert(action);
+            action->run();
+        }
+    }
+    catch (...)
+    {
+        _waveActions.clear();
+        _waveRan.clear();
+        _inWave = false;
+        throw;
+    }
+    _waveRan.clear();
+    _inWave = false;
+}
+
+std::unordered_map<const ActionBase*, size_t> Manager::getParameterGraph(
+    const std::map<configKey, std::unique_ptr<Event>>& events)
+{
+    // Actions run by each parameter's triggers
+    std::unordered_map<std::string, std::vector<const ActionBase*>> triggered;
+    for (const auto& [key, event] : events)
     {
-        std::for_each(it->second.begin(), it->second.end(),
-                      [](auto& action) { action.get()->run(); });
+        for (const auto& param : event->getParameterTriggers())
+        {
+            auto& actions = triggered[param];
+            for (const auto& action : event->getActions())
+            {
+                actions.emplace_back(action.get());
+            }
+        }
     }
+
+    // An action depends on every action that sets a parameter triggering it
+    std::vector<const ActionBase*> actions;
+    std::unordered_map<const ActionBase*, std::vector<const ActionBase*>>
+        dependents;
+    std::unordered_map<const ActionBase*, size_t> numDeps;
+    for (const auto& [key, event] : events)
+    {
+        for (const auto& action : event->getActions())
+        {
+            actions.emplace_back(action.get());
+            numDeps.try_emplace(action.get(), 0);
+            // Includes the parameters set by any actions this one runs
+            for (const auto& param : action->getSetParameters())
+            {
+                auto it = triggered.find(param);
+                if (it == triggered.end())
+                {
+                    continue;
+                }
+                for (const auto* dependent : it->second)
+                {
+                    dependents[action.get()].emplace_back(dependent);
+                    numDeps[dependent]++;
+                }
+            }
+        }
+    }
+
+    // Rank the actions in topological order
+    std::unordered_map<const ActionBase*, size_t> ranks;
+    std::deque<const ActionBase*> ready;
+    std::copy_if(actions.begin(), actions.end(), std::back_inserter(ready),
+                 [&numDeps](const auto* action) {
+                     return numDeps[action] == 0;
+                 });
+    while (!ready.empty())
+    {
+        const auto* action = ready.front();
+        ready.pop_front();
+        ranks.emplace(action, ranks.size());
+        for (const auto* dependent : dependents[action])
+        {
+            if (--numDeps[dependent] == 0)
+            {
+                ready.emplace_back(dependent);
+            }
+        }
+    }
+
+    if (ranks.size() != actions.size())
+    {
+        // Whatever is left unranked sets parameters in a cycle
+        std::set<std::string> params;
+        for (const auto* action : actions)
+        {
+            if (ranks.find(action) == ranks.end())
+            {
+                auto setParams = action->getSetParameters();
+                params.insert(setParams.begin(), setParams.end());
+            }
+        }
+        auto paramList = std::accumulate(
+            std::next(params.begin()), params.end(), *params.begin(),
+            [](auto list, const auto& param) {
+                return std::move(list) + ", " + param;
+            });
+        auto msg = fmt::format("Parameter trigger dependency cycle found "
+                               "involving parameters: {}",
+                               paramList);
+        log<level::ERR>(msg.c_str());
+        throw std::runtime_error(msg);
+    }
+
+    return ranks;
 }
 
 } // namespace phosphor::fan::control::json
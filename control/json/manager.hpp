@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "../telemetry.hpp"
 #include "action.hpp"
 #include "config_base.hpp"
 #include "event.hpp"
@@ -23,7 +24,11 @@
 #include "power_state.hpp"
 #include "profile.hpp"
 #include "sdbusplus.hpp"
+#include "utils/bus_interface.hpp"
+#include "utils/change_tracker.hpp"
 #include "utils/flight_recorder.hpp"
+#include "utils/numeric_column.hpp"
+#include "utils/timer_wheel.hpp"
 #include "zone.hpp"
 
 #include <fmt/format.h>
@@ -37,10 +42,14 @@
 #include <sdeventplus/utility/timer.hpp>
 
 #include <chrono>
+#include <list>
 #include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -80,6 +89,13 @@ using TimerPkg =
 using TimerData = std::pair<TimerType, TimerPkg>;
 /* Dbus event timer */
 using Timer = sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>;
+/**
+ * List of timers added to the Manager
+ * Pair constructed of:
+ *      TimerData = Data used when the timer expires
+ *      WheelTimer = The timer scheduled on the Manager's timer wheel
+ */
+using TimerList = std::list<std::pair<TimerData, WheelTimer>>;
 
 /* Dbus signal object */
 constexpr auto Path = 0;
@@ -114,20 +130,6 @@ using SignalPkg = std::tuple<SignalHandler, SignalObject, TriggerActions>;
 using SignalData = std::tuple<std::unique_ptr<std::vector<SignalPkg>>,
                               std::unique_ptr<sdbusplus::bus::match_t>>;
 
-/**
- * Package of data from a D-Bus call to get managed objects
- * Tuple constructed of:
- *     std::map<Path,            // D-Bus Path
- *       std::map<Intf,          // D-Bus Interface
- *         std::map<Property,    // D-Bus Property
- *         std::variant>>>       // Variant value of that property
- */
-using Path_v = sdbusplus::message::object_path;
-using Intf_v = std::string;
-using Prop_v = std::string;
-using ManagedObjects =
-    std::map<Path_v, std::map<Intf_v, std::map<Prop_v, PropertyVariantType>>>;
-
 /**
  * Actions to run when a parameter trigger runs.
  */
@@ -178,6 +180,38 @@ class Manager
     void sigUsr1Handler(sdeventplus::source::Signal&,
                         const struct signalfd_siginfo*);
 
+    /**
+     * @brief Callback function to handle receiving a TERM signal to save
+     * a state snapshot before exiting.
+     */
+    void sigtermHandler(sdeventplus::source::Signal&,
+                        const struct signalfd_siginfo*);
+
+    /**
+     * @brief Save the zones' states, parameters, and optionally the object
+     * cache to the state snapshot file under CONTROL_PERSIST_ROOT_PATH
+     *
+     * The snapshot is tagged with the hash of the loaded configuration so it
+     * is only used to seed the state of the same configuration. It isn't
+     * rewritten when nothing in it changed.
+     *
+     * @param[in] withObjects - Whether to include the object cache
+     */
+    void saveSnapshot(bool withObjects);
+
+    /**
+     * @brief Check if a path has cached properties that were seeded from
+     * the state snapshot and haven't been refreshed since
+     *
+     * @param[in] path - Dbus object path
+     *
+     * @return - Whether the path's objects should be fetched again
+     */
+    static bool isSeeded(const std::string& path)
+    {
+        return _seeded.find(path) != _seeded.end();
+    }
+
     /**
      * @brief Get the active profiles of the system where an empty list
      * represents that only configuration entries without a profile defined will
@@ -204,15 +238,10 @@ class Manager
     {
         std::map<configKey, std::unique_ptr<T>> config;
 
-        auto confFile =
-            fan::JsonConfig::getConfFile(util::SDBusPlus::getBus(), confAppName,
-                                         T::confFileName, isOptional);
-        if (!confFile.empty())
+        auto entries = loadConfig(T::confFileName, isOptional);
+        if (!entries.is_null())
         {
-            FlightRecorder::instance().log(
-                "main", fmt::format("Loading configuration from {}",
-                                    confFile.string()));
-            for (const auto& entry : fan::JsonConfig::load(confFile))
+            for (const auto& entry : entries)
             {
                 if (entry.contains("profiles"))
                 {
@@ -224,15 +253,7 @@ class Manager
                     }
                     // Do not create the object if its profiles are not in the
                     // list of active profiles
-                    if (!profiles.empty() &&
-                        !std::any_of(profiles.begin(), profiles.end(),
-                                     [](const auto& name) {
-                                         return std::find(
-                                                    getActiveProfiles().begin(),
-                                                    getActiveProfiles().end(),
-                                                    name) !=
-                                                getActiveProfiles().end();
-                                     }))
+                    if (!hasActiveProfile(profiles))
                     {
                         continue;
                     }
@@ -254,6 +275,15 @@ class Manager
         return config;
     }
 
+    /**
+     * @brief Load the groups, from the compiled in group table when the
+     *        machine's configuration is compiled in, based on the active
+     *        profiles
+     *
+     * @return Map of configuration keys to their groups
+     */
+    static std::map<configKey, std::unique_ptr<Group>> getGroups();
+
     /**
      * @brief Check if the given input configuration key matches with another
      * configuration key that it's to be included in
@@ -265,6 +295,41 @@ class Manager
      */
     static bool inConfig(const configKey& input, const configKey& comp);
 
+    /**
+     * @brief Load a configuration file
+     *
+     * When the machine's configuration is compiled in, that is used unless
+     * the file is in the override location, so configurations can still
+     * be tried out without rebuilding.
+     *
+     * @param[in] fileName - The configuration file name
+     * @param[in] isOptional - Whether the file is optional
+     *
+     * @return The parsed configuration, or a null JSON object when an
+     *         optional file isn't found
+     *
+     * @throws NoConfigFound when a required file isn't found
+     */
+    static json loadConfig(const std::string& fileName, bool isOptional);
+
+    /**
+     * @brief Read a configuration file's contents without parsing them
+     *
+     * @param[in] fileName - The configuration file name
+     *
+     * @return The contents, empty when the file isn't found
+     */
+    static std::string readConfig(const std::string& fileName);
+
+    /**
+     * @brief Check if a configuration object with the given profiles is used
+     *
+     * @param[in] profiles - The configuration object's profiles
+     *
+     * @return Whether there are no profiles or one of them is active
+     */
+    static bool hasActiveProfile(const std::vector<std::string>& profiles);
+
     /**
      * @brief Check if the given path and inteface is owned by a dbus service
      *
@@ -296,6 +361,22 @@ class Manager
     void setOwner(const std::string& path, const std::string& serv,
                   const std::string& intf, bool isOwned);
 
+    /**
+     * @brief Get whether a dbus service name currently has an owner
+     *
+     * The owner state is answered from a snapshot of the bus names that is
+     * taken with a single ListNames call the first time it's needed after a
+     * config load, and then kept current by a NameOwnerChanged subscription.
+     *
+     * @param[in] serv - Dbus service name
+     *
+     * @return - Whether the service name has an owner
+     *
+     * @throws - DBusMethodError
+     * Throws a DBusMethodError when the `ListNames` method call fails
+     */
+    bool nameHasOwner(const std::string& serv);
+
     /**
      * @brief Add a set of services for a path and interface by retrieving all
      * the path subtrees to the given depth from root for the interface
@@ -394,8 +475,9 @@ class Manager
      * @param[in] prop - Dbus object's property
      * @param[in] value - Dbus object's property value
      */
-    void setProperty(const std::string& path, const std::string& intf,
-                     const std::string& prop, PropertyVariantType value);
+    static void setProperty(const std::string& path, const std::string& intf,
+                            const std::string& prop,
+                            PropertyVariantType value);
 
     /**
      * @brief Remove an object's interface
@@ -410,6 +492,8 @@ class Manager
         if (itPath != std::end(_objects))
         {
             _objects[path].erase(intf);
+            eraseNumericValues(path, intf);
+            ChangeTracker::removed(path, intf);
         }
     }
 
@@ -429,6 +513,72 @@ class Manager
         return _objects.at(path).at(intf).at(prop);
     };
 
+    /**
+     * @brief Get a pointer to the object's property value as a variant,
+     *        without throwing when the property is not cached
+     *
+     * Group members that don't exist are a normal occurrence, so actions
+     * should use this rather than catching exceptions on every run.
+     *
+     * @param[in] path - Path of the object containing the property
+     * @param[in] intf - Interface name containing the property
+     * @param[in] prop - Name of property
+     *
+     * @return - Pointer to the cached property value, or nullptr when the
+     *           object, interface, or property is not in the cache
+     */
+    static inline const PropertyVariantType*
+        getObjValuePtr(const std::string& path, const std::string& intf,
+                       const std::string& prop)
+    {
+        auto itPath = _objects.find(path);
+        if (itPath == _objects.end())
+        {
+            return nullptr;
+        }
+        auto itIntf = itPath->second.find(intf);
+        if (itIntf == itPath->second.end())
+        {
+            return nullptr;
+        }
+        auto itProp = itIntf->second.find(prop);
+        if (itProp == itIntf->second.end())
+        {
+            return nullptr;
+        }
+        return &itProp->second;
+    }
+
+    /**
+     * @brief Get the ranges of the numeric column the groups' member
+     *        values are kept in
+     *
+     * Each group's member property values are kept as contiguous doubles
+     * alongside the object cache, for actions that reduce over numeric
+     * groups to read directly.
+     *
+     * @param[in] groups - The groups
+     *
+     * @return - The range of each group, in the same order
+     */
+    static std::vector<NumericRange>
+        getNumericRanges(const std::vector<Group>& groups);
+
+    /**
+     * @brief Get the counts of the groups' members whose service owning
+     *        the group's interface is missing
+     *
+     * The counts are kept up to date as the owner states in the service
+     * tree cache change, so actions can check for a missing owner without
+     * looking each member up.
+     *
+     * @param[in] groups - The groups
+     *
+     * @return - The count of each group, in the same order
+     */
+    static std::vector<const size_t*>
+        getMissingOwnerCounts(const std::vector<Group>& groups);
+
     /**
      * @brief Add a dbus timer
      *
@@ -443,9 +593,18 @@ class Manager
     /**
      * @brief Callback when a timer expires
      *
-     * @param[in] data - Data to be used when the timer expired
+     * @param[in] timer - The timer that expired and its data
      */
-    void timerExpired(TimerData& data);
+    void timerExpired(TimerList::iterator timer);
+
+    /**
+     * @brief Get the timer wheel all fan control timers are scheduled on
+     *
+     * Timers are coalesced to the CONTROL_TIMER_SLACK_MS tick of the wheel.
+     *
+     * @return - Reference to the timer wheel
+     */
+    static TimerWheel& getTimerWheel();
 
     /**
      * @brief Get the signal data for a given match string
@@ -553,6 +712,10 @@ class Manager
      * @brief Runs the actions registered to a parameter
      *        trigger with this name.
      *
+     * Actions are run in the order of the parameter dependency graph, so
+     * parameters set by the actions propagate in the same wave and each
+     * action runs at most once per wave.
+     *
      * @param[in] name - The parameter name
      */
     static void runParameterActions(const std::string& name);
@@ -570,7 +733,64 @@ class Manager
     /* The name of the dump file */
     static const std::string dumpFile;
 
+    /**
+     * @brief Publish the telemetry once the event loop is done with the
+     * current changes, so readers see zone target changes without waiting
+     * for the periodic update
+     */
+    void queueTelemetry();
+
   private:
+    /**
+     * @brief Publish the zones', fans', and actions' state to the telemetry
+     * shared memory region read by fanctl and other tools
+     */
+    void publishTelemetry();
+
+    /**
+     * @brief Publish the telemetry queued by queueTelemetry()
+     *
+     * @param[in] source - The deferred event source that queued it
+     */
+    void publishQueuedTelemetry(sdeventplus::source::EventBase& source);
+
+    /**
+     * @brief Get the hash of the configuration files and active profiles
+     *
+     * @return - Hash identifying the configuration being loaded
+     */
+    uint64_t getConfigHash() const;
+
+    /**
+     * @brief Seed the zones, parameters, and object cache from the state
+     * snapshot file when it matches the loaded configuration
+     *
+     * Live data already in the parameters or object cache is kept.
+     */
+    void restoreSnapshot();
+
+    /**
+     * @brief Remove the properties seeded from the state snapshot that
+     * haven't been refreshed from the bus, so actions don't keep using
+     * values from before the restart
+     */
+    void expireSeeded();
+
+    /**
+     * @brief Build the parameter dependency graph of the given events
+     *
+     * Orders the events' actions so an action that sets a parameter comes
+     * before the actions triggered by that parameter.
+     *
+     * @param[in] events - The events to build the graph from
+     *
+     * @return Map of actions to their rank in the dependency order
+     *
+     * @throws std::runtime_error when the parameters form a cycle
+     */
+    static std::unordered_map<const ActionBase*, size_t> getParameterGraph(
+        const std::map<configKey, std::unique_ptr<Event>>& events);
+
     /**
      * @brief Helper to detect when a property's double contains a NaN
      * (not-a-number) value.
@@ -607,6 +827,30 @@ class Manager
     /* The system's power state determination object */
     std::unique_ptr<PowerState> _powerState;
 
+    /* Timer to periodically save the state snapshot */
+    WheelTimer _snapshotTimer;
+
+    /* Hash of the loaded configuration files and active profiles */
+    uint64_t _configHash;
+
+    /* Map of paths to the (interface, property) pairs in the object cache
+     * that were seeded from the state snapshot and not refreshed since */
+    static std::unordered_map<std::string,
+                              std::set<std::pair<std::string, std::string>>>
+        _seeded;
+
+    /* Hash of the last snapshot written, to skip rewriting it unchanged */
+    std::optional<size_t> _snapshotHash;
+
+    /* Shared memory region the zone, fan, and action state is published to */
+    std::unique_ptr<telemetry::Writer> _telemetry;
+
+    /* Timer to periodically publish the telemetry */
+    WheelTimer _telemetryTimer;
+
+    /* Timer to remove the seeded properties that weren't refreshed */
+    WheelTimer _seedExpiryTimer;
+
     /* List of profiles configured */
     std::map<configKey, std::unique_ptr<Profile>> _profiles;
 
@@ -625,8 +869,14 @@ class Manager
         std::map<std::string, std::map<std::string, PropertyVariantType>>>
         _objects;
 
+    /* Snapshot of the names currently owned on the bus */
+    std::optional<std::unordered_set<std::string>> _ownedNames;
+
+    /* Subscription keeping the _ownedNames snapshot current */
+    std::unique_ptr<sdbusplus::bus::match_t> _nameOwnerMatch;
+
     /* List of timers and their data to be processed when expired */
-    std::vector<std::pair<std::unique_ptr<TimerData>, Timer>> _timers;
+    TimerList _timers;
 
     /* Map of signal match strings to a list of signal handler data */
     std::unordered_map<std::string, std::vector<SignalData>> _signals;
@@ -641,6 +891,10 @@ class Manager
      * data from the event loop after the USR1 signal.  */
     std::unique_ptr<sdeventplus::source::Defer> debugDumpEventSource;
 
+    /* The sdeventplus wrapper around sd_event_add_defer to publish the
+     * telemetry from the event loop after a zone's target changed */
+    std::unique_ptr<sdeventplus::source::Defer> _telemetryEventSource;
+
     /**
      * @brief A map of parameter names and values that are something
      *        other than just D-Bus property values that other actions
@@ -648,12 +902,59 @@ class Manager
      */
     static std::unordered_map<std::string, PropertyVariantType> _parameters;
 
+    /* Numeric columns of the group member values, by interface and
+     * property */
+    static std::map<std::pair<std::string, std::string>, NumericColumn>
+        _numericColumns;
+
+    /* A group member interface whose owner state is counted */
+    struct OwnerWatch
+    {
+        /* The interface */
+        std::string intf;
+
+        /* The owner state last counted */
+        bool owned;
+
+        /* The missing owner counts the member is included in */
+        std::vector<size_t*> counts;
+    };
+
+    /* Counts of group members with a missing owner, by interface and
+     * group members */
+    static std::map<std::pair<std::string, std::vector<std::string>>, size_t>
+        _missingOwners;
+
+    /* Map of object paths to their counted interfaces */
+    static std::unordered_map<std::string, std::vector<OwnerWatch>>
+        _ownerWatches;
+
     /**
      * @brief Map of parameter names to the actions to run when their
      *        values change.
      */
     static std::unordered_map<std::string, TriggerActions> _parameterTriggers;
 
+    /**
+     * @brief Map of actions to their rank in the parameter dependency
+     *        order.
+     */
+    static std::unordered_map<const ActionBase*, size_t> _actionRanks;
+
+    /**
+     * @brief Actions queued to run in the current parameter propagation
+     *        wave, ordered by rank.
+     */
+    static std::set<std::pair<size_t, ActionBase*>> _waveActions;
+
+    /**
+     * @brief Actions already run in the current parameter propagation wave.
+     */
+    static std::unordered_set<const ActionBase*> _waveRan;
+
+    /* Whether a parameter propagation wave is running */
+    static bool _inWave;
+
     /**
      * @brief Callback for power state changes
      *
@@ -664,6 +965,14 @@ class Manager
      */
     void powerStateChanged(bool powerStateOn);
 
+    /**
+     * @brief Callback for NameOwnerChanged signals to keep the _ownedNames
+     * snapshot current
+     *
+     * @param[in] msg - The NameOwnerChanged signal message
+     */
+    void nameOwnerChanged(sdbusplus::message::message& msg);
+
     /**
      * @brief Find the service name for a given path and interface from the
      * cached dataset
@@ -716,6 +1025,24 @@ class Manager
      * @param[in] groups - The groups to add
      */
     void addGroups(const std::vector<Group>& groups);
+
+    /**
+     * @brief Mark an object interface's values as no longer cached in
+     *        the numeric columns
+     *
+     * @param[in] path - Dbus object's path
+     * @param[in] intf - Dbus object's interface
+     */
+    static void eraseNumericValues(const std::string& path,
+                                   const std::string& intf);
+
+    /**
+     * @brief Update the missing owner counts from an object's owner
+     *        states in the service tree cache
+     *
+     * @param[in] path - Dbus object's path
+     */
+    static void updateOwnerCounts(const std::string& path);
 };
 
 } // namespace phosphor::fan::control::json
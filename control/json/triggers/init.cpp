@@ -48,9 +48,10 @@ void getProperties(Manager* mgr, const Group& group)
             // Check if property already cached
             auto value = mgr->getProperty(member, group.getInterface(),
                                           group.getProperty());
-            if (value == std::nullopt)
+            if (value == std::nullopt || Manager::isSeeded(member))
             {
-                // Property not in cache, attempt to add it
+                // Property not in cache or only seeded from the state
+                // snapshot, attempt to add it
                 mgr->addObjects(member, group.getInterface(),
                                 group.getProperty(), group.getService());
 
@@ -95,10 +96,7 @@ void nameHasOwner(Manager* mgr, const Group& group)
                 {
                     // Member not provided by same service as last group member
                     lastName = servName;
-                    hasOwner = util::SDBusPlus::callMethodAndRead<bool>(
-                        mgr->getBus(), "org.freedesktop.DBus",
-                        "/org/freedesktop/DBus", "org.freedesktop.DBus",
-                        "NameHasOwner", servName);
+                    hasOwner = mgr->nameHasOwner(servName);
                 }
                 // Update service name owner state of group object
                 mgr->setOwner(member, servName, intf, hasOwner);
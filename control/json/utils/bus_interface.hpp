@@ -0,0 +1,295 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "config_base.hpp"
+#include "sdbusplus.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace phosphor::fan::control::json
+{
+
+/**
+ * Package of data from a D-Bus call to get managed objects
+ * Tuple constructed of:
+ *     std::map<Path,            // D-Bus Path
+ *       std::map<Intf,          // D-Bus Interface
+ *         std::map<Property,    // D-Bus Property
+ *         std::variant>>>       // Variant value of that property
+ */
+using Path_v = sdbusplus::message::object_path;
+using Intf_v = std::string;
+using Prop_v = std::string;
+using ManagedObjects =
+    std::map<Path_v, std::map<Intf_v, std::map<Prop_v, PropertyVariantType>>>;
+
+/* Map of object paths to the services and interfaces implementing them */
+using SubTree =
+    std::map<std::string, std::map<std::string, std::vector<std::string>>>;
+
+/**
+ * @class BusInterfaceBase
+ *
+ * Base class for the D-Bus calls fan control makes to read the objects
+ * it caches and to read and write its fans' targets, so testcases can
+ * replace them with a mock instead of needing a bus.
+ *
+ * The instance in use is set with setInstance(), defaulting to one that
+ * calls out on the system bus.
+ */
+class BusInterfaceBase
+{
+  public:
+    BusInterfaceBase() = default;
+    virtual ~BusInterfaceBase() = default;
+    BusInterfaceBase(const BusInterfaceBase&) = delete;
+    BusInterfaceBase& operator=(const BusInterfaceBase&) = delete;
+    BusInterfaceBase(BusInterfaceBase&&) = delete;
+    BusInterfaceBase& operator=(BusInterfaceBase&&) = delete;
+
+    /**
+     * @brief Get the service providing an interface on a path
+     *
+     * @param[in] path - The object path
+     * @param[in] intf - The interface
+     *
+     * @return The service name
+     */
+    virtual std::string getService(const std::string& path,
+                                   const std::string& intf) = 0;
+
+    /**
+     * @brief Get the subtree of objects implementing an interface
+     *
+     * @param[in] path - The subtree's root path
+     * @param[in] intf - The interface
+     * @param[in] depth - The depth to search to, 0 for unlimited
+     *
+     * @return The objects' paths, services and interfaces
+     */
+    virtual SubTree getSubTree(const std::string& path, const std::string& intf,
+                               int32_t depth) = 0;
+
+    /**
+     * @brief Get the names currently owned on the bus
+     *
+     * @return The names
+     */
+    virtual std::vector<std::string> listNames() = 0;
+
+    /**
+     * @brief Get a property's value
+     *
+     * @param[in] service - The service providing the object
+     * @param[in] path - The object path
+     * @param[in] intf - The interface
+     * @param[in] prop - The property
+     *
+     * @return The property value
+     */
+    virtual PropertyVariantType getProperty(const std::string& service,
+                                            const std::string& path,
+                                            const std::string& intf,
+                                            const std::string& prop) = 0;
+
+    /**
+     * @brief Get all of the objects of a service's ObjectManager
+     *
+     * @param[in] service - The service
+     * @param[in] path - The ObjectManager path
+     *
+     * @return The objects' properties
+     */
+    virtual ManagedObjects getManagedObjects(const std::string& service,
+                                             const std::string& path) = 0;
+
+    /**
+     * @brief Get a fan sensor's target
+     *
+     * @param[in] service - The service providing the sensor
+     * @param[in] path - The sensor's object path
+     * @param[in] intf - The interface with the target property
+     *
+     * @return The target
+     */
+    virtual uint64_t getTarget(const std::string& service,
+                               const std::string& path,
+                               const std::string& intf) = 0;
+
+    /**
+     * @brief Set a fan sensor's target
+     *
+     * @param[in] service - The service providing the sensor
+     * @param[in] path - The sensor's object path
+     * @param[in] intf - The interface with the target property
+     * @param[in] target - The target
+     */
+    virtual void setTarget(const std::string& service, const std::string& path,
+                           const std::string& intf, uint64_t target) = 0;
+
+    /**
+     * @brief Set a fan sensor's target without waiting for the service to
+     *        reply, for when the target was already written another way
+     *        and the property is only kept current for its readers
+     *
+     * @param[in] service - The service providing the sensor
+     * @param[in] path - The sensor's object path
+     * @param[in] intf - The interface with the target property
+     * @param[in] target - The target
+     */
+    virtual void publishTarget(const std::string& service,
+                               const std::string& path,
+                               const std::string& intf, uint64_t target) = 0;
+
+    /**
+     * @brief Get the instance in use
+     */
+    static BusInterfaceBase& getInstance();
+
+    /**
+     * @brief Replace the instance in use
+     *
+     * @param[in] bus - The new instance
+     */
+    static void setInstance(std::unique_ptr<BusInterfaceBase> bus)
+    {
+        instance() = std::move(bus);
+    }
+
+    /* The property fan targets are held in */
+    static constexpr auto targetProperty = "Target";
+
+  private:
+    static std::unique_ptr<BusInterfaceBase>& instance()
+    {
+        static std::unique_ptr<BusInterfaceBase> bus;
+        return bus;
+    }
+};
+
+/**
+ * @class BusInterface
+ *
+ * Concrete class making the D-Bus calls on the system bus
+ */
+class BusInterface : public BusInterfaceBase
+{
+  public:
+    BusInterface(const BusInterface&) = delete;
+    BusInterface& operator=(const BusInterface&) = delete;
+    BusInterface(BusInterface&&) = delete;
+    BusInterface& operator=(BusInterface&&) = delete;
+    ~BusInterface() = default;
+
+    BusInterface() : _bus(util::SDBusPlus::getBus())
+    {}
+
+    std::string getService(const std::string& path,
+                           const std::string& intf) override
+    {
+        return util::SDBusPlus::getService(_bus, path, intf);
+    }
+
+    SubTree getSubTree(const std::string& path, const std::string& intf,
+                       int32_t depth) override
+    {
+        return util::SDBusPlus::getSubTreeRaw(_bus, path, intf, depth);
+    }
+
+    std::vector<std::string> listNames() override
+    {
+        return util::SDBusPlus::callMethodAndRead<std::vector<std::string>>(
+            _bus, "org.freedesktop.DBus", "/org/freedesktop/DBus",
+            "org.freedesktop.DBus", "ListNames");
+    }
+
+    PropertyVariantType getProperty(const std::string& service,
+                                    const std::string& path,
+                                    const std::string& intf,
+                                    const std::string& prop) override
+    {
+        return util::SDBusPlus::getPropertyVariant<PropertyVariantType>(
+            _bus, service, path, intf, prop);
+    }
+
+    ManagedObjects getManagedObjects(const std::string& service,
+                                     const std::string& path) override
+    {
+        return util::SDBusPlus::getManagedObjects<PropertyVariantType>(
+            _bus, service, path);
+    }
+
+    uint64_t getTarget(const std::string& service, const std::string& path,
+                       const std::string& intf) override
+    {
+        return util::SDBusPlus::getProperty<uint64_t>(_bus, service, path,
+                                                      intf, targetProperty);
+    }
+
+    void setTarget(const std::string& service, const std::string& path,
+                   const std::string& intf, uint64_t target) override
+    {
+        util::SDBusPlus::setProperty<uint64_t>(_bus, service, path, intf,
+                                               targetProperty,
+                                               std::move(target));
+    }
+
+    void publishTarget(const std::string& service, const std::string& path,
+                       const std::string& intf, uint64_t target) override
+    {
+        auto msg = _bus.new_method_call(service.c_str(), path.c_str(),
+                                        "org.freedesktop.DBus.Properties",
+                                        "Set");
+        msg.append(intf, targetProperty, std::variant<uint64_t>(target));
+        // Sent without expecting a reply, so nothing waits on the service
+        auto rc = sd_bus_message_set_expect_reply(msg.get(), false);
+        if (rc >= 0)
+        {
+            rc = sd_bus_send(_bus.get(), msg.get(), nullptr);
+        }
+        if (rc < 0)
+        {
+            throw sdbusplus::exception::SdBusError(
+                -rc, "Failed to publish fan target");
+        }
+    }
+
+  private:
+    /* The sdbusplus bus object */
+    sdbusplus::bus::bus& _bus;
+};
+
+inline BusInterfaceBase& BusInterfaceBase::getInstance()
+{
+    auto& bus = instance();
+    if (!bus)
+    {
+        bus = std::make_unique<BusInterface>();
+    }
+    return *bus;
+}
+
+} // namespace phosphor::fan::control::json
@@ -0,0 +1,197 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "group.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace phosphor::fan::control::json
+{
+
+/**
+ * @brief The members of an action's groups whose cached values changed
+ *        since the action last ran
+ */
+struct ChangeSet
+{
+    /* Whether every member has to be checked, as before an action's
+     * first run or when more changes were made than there are members */
+    bool all = true;
+
+    /* The changed members as (group index, member index) pairs, with a
+     * member repeated for each time it changed */
+    std::vector<std::pair<size_t, size_t>> members;
+
+    /* Number of members being tracked */
+    size_t tracked = 0;
+};
+
+/**
+ * @class ChangeTracker
+ *
+ * Records the changes to the object cache into the change sets of the
+ * actions whose groups the changed objects are members of.
+ */
+class ChangeTracker
+{
+  public:
+    ChangeTracker() = delete;
+
+    /**
+     * @brief Start recording the changes to a list of groups' members
+     *
+     * @param[in] changes - Where to record the changes
+     * @param[in] groups - The groups, which must outlive the tracking
+     */
+    static void track(ChangeSet& changes, const std::vector<Group>& groups)
+    {
+        for (size_t g = 0; g < groups.size(); g++)
+        {
+            const auto& members = groups[g].getMembers();
+            changes.tracked += members.size();
+            for (size_t m = 0; m < members.size(); m++)
+            {
+                _subscriptions[members[m]].push_back(
+                    {&changes, &groups[g], g, m});
+            }
+        }
+    }
+
+    /**
+     * @brief Stop recording the changes to a list of groups' members
+     *
+     * @param[in] changes - Where the changes were recorded
+     * @param[in] groups - The groups
+     */
+    static void untrack(const ChangeSet& changes,
+                        const std::vector<Group>& groups)
+    {
+        for (const auto& group : groups)
+        {
+            for (const auto& member : group.getMembers())
+            {
+                auto itSubs = _subscriptions.find(member);
+                if (itSubs == _subscriptions.end())
+                {
+                    continue;
+                }
+                auto& subs = itSubs->second;
+                subs.erase(std::remove_if(subs.begin(), subs.end(),
+                                          [&changes](const auto& sub) {
+                                              return sub.changes == &changes;
+                                          }),
+                           subs.end());
+                if (subs.empty())
+                {
+                    _subscriptions.erase(itSubs);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Record that an object's cached property value changed
+     *
+     * @param[in] path - Dbus object's path
+     * @param[in] intf - Dbus object's interface
+     * @param[in] prop - Dbus object's property
+     */
+    static void changed(const std::string& path, const std::string& intf,
+                        const std::string& prop)
+    {
+        auto itSubs = _subscriptions.find(path);
+        if (itSubs == _subscriptions.end())
+        {
+            return;
+        }
+        for (const auto& sub : itSubs->second)
+        {
+            if ((sub.group->getInterface() == intf) &&
+                (sub.group->getProperty() == prop))
+            {
+                record(sub);
+            }
+        }
+    }
+
+    /**
+     * @brief Record that an object's interface was removed from the cache
+     *
+     * @param[in] path - Dbus object's path
+     * @param[in] intf - Dbus object's interface
+     */
+    static void removed(const std::string& path, const std::string& intf)
+    {
+        auto itSubs = _subscriptions.find(path);
+        if (itSubs == _subscriptions.end())
+        {
+            return;
+        }
+        for (const auto& sub : itSubs->second)
+        {
+            if (sub.group->getInterface() == intf)
+            {
+                record(sub);
+            }
+        }
+    }
+
+  private:
+    /* A group member an action is tracking */
+    struct Subscription
+    {
+        ChangeSet* changes;
+        const Group* group;
+        size_t groupIndex;
+        size_t memberIndex;
+    };
+
+    /**
+     * @brief Add a change to the tracking action's change set
+     *
+     * Once there are as many changes as members being tracked, all of the
+     * members get checked instead.
+     *
+     * @param[in] sub - The subscription of the changed member
+     */
+    static void record(const Subscription& sub)
+    {
+        auto& changes = *sub.changes;
+        if (changes.all)
+        {
+            return;
+        }
+        if (changes.members.size() >= changes.tracked)
+        {
+            changes.all = true;
+            changes.members.clear();
+            return;
+        }
+        changes.members.emplace_back(sub.groupIndex, sub.memberIndex);
+    }
+
+    /* Map of object paths to the subscriptions to their changes */
+    static inline std::unordered_map<std::string, std::vector<Subscription>>
+        _subscriptions;
+};
+
+} // namespace phosphor::fan::control::json
@@ -0,0 +1,198 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dbus_worker.hpp"
+
+#include "sdeventplus.hpp"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <functional>
+#include <system_error>
+
+namespace phosphor::fan::control::json
+{
+
+namespace
+{
+
+int makeEventFd(int flags)
+{
+    auto fd = eventfd(0, EFD_CLOEXEC | flags);
+    if (fd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to create D-Bus worker eventfd");
+    }
+    return fd;
+}
+
+} // namespace
+
+DBusWorker::DBusWorker() :
+    _bus(sdbusplus::bus::new_system()), _requestFd(makeEventFd(0)),
+    _completeFd(makeEventFd(EFD_NONBLOCK)),
+    _completeSource(util::SDEventPlus::getEvent(), _completeFd(), EPOLLIN,
+                    std::bind(&DBusWorker::complete, this)),
+    _stop(false), _posted(0), _completed(0), _failed(0), _rejected(0),
+    _coalesced(0), _thread(&DBusWorker::run, this)
+{}
+
+DBusWorker::~DBusWorker()
+{
+    _stop.store(true, std::memory_order_release);
+    signal(_requestFd());
+    _thread.join();
+}
+
+DBusWorker& DBusWorker::instance()
+{
+    static DBusWorker worker;
+    return worker;
+}
+
+bool DBusWorker::post(Call&& call, Completion&& done)
+{
+    if (!_requests.push(Request{std::move(call), std::move(done)}))
+    {
+        _rejected++;
+        return false;
+    }
+    _posted++;
+    signal(_requestFd());
+    return true;
+}
+
+bool DBusWorker::postLatest(const std::shared_ptr<LatestValue>& latest,
+                            uint64_t value)
+{
+    latest->_value.store(value);
+    if (latest->_queued.exchange(true))
+    {
+        // The queued call reads the value when it runs
+        _coalesced++;
+        return true;
+    }
+
+    auto queued = post(
+        [latest](auto& bus) {
+            // Clear the flag before reading the value, so a value posted
+            // after the read queues the call again
+            latest->_queued.store(false);
+            latest->_call(bus, latest->_value.load());
+        },
+        [latest](std::exception_ptr error) {
+            if (latest->_done)
+            {
+                latest->_done(error);
+            }
+        });
+    if (!queued)
+    {
+        latest->_queued.store(false);
+    }
+    return queued;
+}
+
+json DBusWorker::dump() const
+{
+    json data;
+    data["posted"] = _posted;
+    data["completed"] = _completed;
+    data["failed"] = _failed;
+    data["rejected"] = _rejected;
+    data["coalesced"] = _coalesced;
+    data["pending"] = _posted - _completed;
+    return data;
+}
+
+void DBusWorker::signal(int fd)
+{
+    uint64_t count = 1;
+    while (write(fd, &count, sizeof(count)) < 0 && errno == EINTR)
+    {}
+}
+
+void DBusWorker::run()
+{
+    while (!_stop.load(std::memory_order_acquire))
+    {
+        // Block until calls are posted or the worker is stopped
+        uint64_t count;
+        if (read(_requestFd(), &count, sizeof(count)) < 0)
+        {
+            continue;
+        }
+
+        while (auto request = _requests.pop())
+        {
+            if (!execute(std::move(*request)))
+            {
+                return;
+            }
+        }
+    }
+}
+
+bool DBusWorker::execute(Request&& request)
+{
+    Result result{std::move(request.done), nullptr};
+    try
+    {
+        request.call(_bus);
+    }
+    catch (...)
+    {
+        result.error = std::current_exception();
+    }
+
+    // The result queue is as large as the request queue, so it only
+    // fills when the event loop is behind on running completions
+    while (!_results.push(std::move(result)))
+    {
+        if (_stop.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        signal(_completeFd());
+        std::this_thread::yield();
+    }
+    signal(_completeFd());
+    return true;
+}
+
+void DBusWorker::complete()
+{
+    uint64_t count;
+    while (read(_completeFd(), &count, sizeof(count)) < 0 && errno == EINTR)
+    {}
+
+    while (auto result = _results.pop())
+    {
+        _completed++;
+        if (result->error)
+        {
+            _failed++;
+        }
+        if (result->done)
+        {
+            result->done(result->error);
+        }
+    }
+}
+
+} // namespace phosphor::fan::control::json
@@ -0,0 +1,244 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "spsc_queue.hpp"
+#include "utility.hpp"
+
+#include <nlohmann/json.hpp>
+#include <sdbusplus/bus.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace phosphor::fan::control::json
+{
+
+using json = nlohmann::json;
+
+/**
+ * @class DBusWorker
+ *
+ * Runs D-Bus calls on a separate I/O thread with its own bus connection, so
+ * a slow or hung D-Bus peer can't stall the event loop the zones are
+ * controlled from.
+ *
+ * Calls are posted from the event loop thread through a lock-free single
+ * producer/single consumer queue. Once a call finishes, its completion is
+ * handed back through a second queue and an eventfd wakes the event loop to
+ * run it, so completions always run on the event loop thread.
+ */
+class DBusWorker
+{
+  public:
+    /* A D-Bus call, run on the I/O thread with its bus connection */
+    using Call = std::function<void(sdbusplus::bus::bus&)>;
+
+    /* Run on the event loop thread with the exception the call threw, if any */
+    using Completion = std::function<void(std::exception_ptr)>;
+
+    DBusWorker(const DBusWorker&) = delete;
+    DBusWorker& operator=(const DBusWorker&) = delete;
+    DBusWorker(DBusWorker&&) = delete;
+    DBusWorker& operator=(DBusWorker&&) = delete;
+
+    /**
+     * @brief Stops and joins the I/O thread
+     */
+    ~DBusWorker();
+
+    /**
+     * @brief Returns a reference to the static instance, starting the I/O
+     * thread on first use.
+     */
+    static DBusWorker& instance();
+
+    /**
+     * @brief Post a D-Bus call to run on the I/O thread
+     *
+     * Must only be called from the event loop thread.
+     *
+     * @param[in] call - The D-Bus call
+     * @param[in] done - Function to run on the event loop thread once the
+     *                   call has finished
+     *
+     * @return Whether the call was posted, false when the queue of pending
+     *         calls is full
+     */
+    bool post(Call&& call, Completion&& done = nullptr);
+
+    /**
+     * @class LatestValue
+     *
+     * A value written by a D-Bus call, such as a fan sensor's target, of
+     * which only the latest posted is written.
+     *
+     * The value is held in an atomic slot the I/O thread reads when the
+     * call runs, and the call is only queued when it isn't already, so
+     * values posted while one is queued replace it without going through
+     * the queue or taking a lock.
+     */
+    class LatestValue
+    {
+      public:
+        /* The D-Bus call, run with the latest value */
+        using ValueCall = std::function<void(sdbusplus::bus::bus&, uint64_t)>;
+
+        LatestValue() = delete;
+        LatestValue(const LatestValue&) = delete;
+        LatestValue& operator=(const LatestValue&) = delete;
+        LatestValue(LatestValue&&) = delete;
+        LatestValue& operator=(LatestValue&&) = delete;
+        ~LatestValue() = default;
+
+        /**
+         * @brief Constructor
+         *
+         * @param[in] call - The D-Bus call writing the value
+         * @param[in] done - Function to run on the event loop thread once
+         *                   the call has finished
+         */
+        LatestValue(ValueCall&& call, Completion&& done) :
+            _call(std::move(call)), _done(std::move(done))
+        {}
+
+      private:
+        friend class DBusWorker;
+
+        /* The D-Bus call writing the value */
+        const ValueCall _call;
+
+        /* Run once the call has finished */
+        const Completion _done;
+
+        /* The latest value posted */
+        std::atomic<uint64_t> _value{0};
+
+        /* Whether a call to write the value is queued and hasn't read it */
+        std::atomic<bool> _queued{false};
+    };
+
+    /**
+     * @brief Post the latest value to write with a LatestValue's call
+     *
+     * When its call is already queued and hasn't read the value yet, the
+     * value just replaces the one it will write. Otherwise the call is
+     * queued, so the values are always written in the order posted.
+     *
+     * Must only be called from the event loop thread.
+     *
+     * @param[in] latest - The LatestValue
+     * @param[in] value - The value to write
+     *
+     * @return Whether the value will be written, false when the call had
+     *         to be queued and the queue of pending calls is full
+     */
+    bool postLatest(const std::shared_ptr<LatestValue>& latest,
+                    uint64_t value);
+
+    /**
+     * @brief Dump the worker's statistics
+     *
+     * @return json - The posted, completed, failed, rejected, and coalesced
+     *                call counts
+     */
+    json dump() const;
+
+  private:
+    DBusWorker();
+
+    struct Request
+    {
+        Call call;
+        Completion done;
+    };
+
+    struct Result
+    {
+        Completion done;
+        std::exception_ptr error;
+    };
+
+    /* Number of calls that can be pending */
+    static constexpr size_t queueSize = 256;
+
+    /**
+     * @brief The I/O thread, runs posted calls until stopped
+     */
+    void run();
+
+    /**
+     * @brief Run a call on the I/O thread and hand its result back to the
+     * event loop
+     *
+     * @param[in] request - The call and its completion
+     *
+     * @return false when the worker was stopped before the result could be
+     *         handed back
+     */
+    bool execute(Request&& request);
+
+    /**
+     * @brief Callback of the completion eventfd, runs the completions of
+     * all finished calls on the event loop thread
+     */
+    void complete();
+
+    /**
+     * @brief Increment an eventfd's counter to wake up its reader
+     *
+     * @param[in] fd - The eventfd
+     */
+    static void signal(int fd);
+
+    /* The I/O thread's own bus connection */
+    sdbusplus::bus::bus _bus;
+
+    /* Wakes up the I/O thread when calls are posted */
+    util::FileDescriptor _requestFd;
+
+    /* Wakes up the event loop when calls have finished */
+    util::FileDescriptor _completeFd;
+
+    /* Calls posted to the I/O thread */
+    SPSCQueue<Request, queueSize> _requests;
+
+    /* Finished calls handed back to the event loop */
+    SPSCQueue<Result, queueSize> _results;
+
+    /* Event loop source for the completion eventfd */
+    sdeventplus::source::IO _completeSource;
+
+    /* Set to stop the I/O thread */
+    std::atomic<bool> _stop;
+
+    /* Statistics, only touched on the event loop thread */
+    uint64_t _posted;
+    uint64_t _completed;
+    uint64_t _failed;
+    uint64_t _rejected;
+    uint64_t _coalesced;
+
+    /* The I/O thread */
+    std::thread _thread;
+};
+
+} // namespace phosphor::fan::control::json
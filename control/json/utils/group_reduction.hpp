@@ -0,0 +1,183 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "numeric_column.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+namespace phosphor::fan::control::json::reduction
+{
+
+/*
+ * Reductions over a group's range of a numeric column, comparing the
+ * members against an action's state value.
+ *
+ * Only members whose state is NumericColumn::number take part. The loops
+ * are kept free of branches and early exits so the compiler vectorizes
+ * them, with the members that don't take part masked out by their state.
+ */
+
+/**
+ * @brief Count the members equal to a value
+ *
+ * @param[in] range - The group's range
+ * @param[in] state - The value to compare against
+ *
+ * @return The number of members equal to the value
+ */
+inline size_t countEqual(const NumericRange& range, double state)
+{
+    const auto* v = range.values();
+    const auto* s = range.states();
+    size_t count = 0;
+    for (size_t i = 0; i < range.size; i++)
+    {
+        count += (s[i] == NumericColumn::number) & (v[i] == state);
+    }
+    return count;
+}
+
+/**
+ * @brief Count the members greater than or equal to a value
+ *
+ * @param[in] range - The group's range
+ * @param[in] state - The value to compare against
+ *
+ * @return The number of members at or above the value
+ */
+inline size_t countAtOrAbove(const NumericRange& range, double state)
+{
+    const auto* v = range.values();
+    const auto* s = range.states();
+    size_t count = 0;
+    for (size_t i = 0; i < range.size; i++)
+    {
+        count += (s[i] == NumericColumn::number) & (v[i] >= state);
+    }
+    return count;
+}
+
+/**
+ * @brief Mark the members equal to a value
+ *
+ * @param[in] range - The group's range
+ * @param[in] state - The value to compare against
+ * @param[out] atState - Set to 1 for each member equal to the value and
+ *                       0 otherwise, one per member of the range
+ *
+ * @return The number of members equal to the value
+ */
+inline size_t markEqual(const NumericRange& range, double state,
+                        uint8_t* atState)
+{
+    const auto* v = range.values();
+    const auto* s = range.states();
+    size_t count = 0;
+    for (size_t i = 0; i < range.size; i++)
+    {
+        atState[i] = (s[i] == NumericColumn::number) & (v[i] == state);
+        count += atState[i];
+    }
+    return count;
+}
+
+/**
+ * @brief Get the amount each member is at or above a value by, scaled
+ *
+ * @param[in] range - The group's range
+ * @param[in] state - The value to compare against
+ * @param[in] scale - What to multiply each difference by
+ * @param[out] deltas - Set to each member's scaled difference, or 0 for
+ *                      members below the value, one per member of the
+ *                      range
+ */
+inline void deltasAboveState(const NumericRange& range, double state,
+                             uint64_t scale, uint64_t* deltas)
+{
+    const auto* v = range.values();
+    const auto* s = range.states();
+    for (size_t i = 0; i < range.size; i++)
+    {
+        auto above = (s[i] == NumericColumn::number) & (v[i] >= state);
+        auto delta = above ? v[i] - state : 0.0;
+        deltas[i] = static_cast<uint64_t>(delta * scale);
+    }
+}
+
+/**
+ * @brief Get the smallest amount any member from a position on is below
+ *        a value by
+ *
+ * @param[in] range - The group's range
+ * @param[in] state - The value to compare against
+ * @param[in] first - Position of the first member to include
+ *
+ * @return The smallest difference, or std::nullopt when no member is
+ *         below the value
+ */
+inline std::optional<double> minDeltaBelowState(const NumericRange& range,
+                                                double state, size_t first = 0)
+{
+    const auto* v = range.values();
+    const auto* s = range.states();
+    auto min = std::numeric_limits<double>::infinity();
+    for (size_t i = first; i < range.size; i++)
+    {
+        auto below = (s[i] == NumericColumn::number) & (v[i] < state);
+        auto delta = state - v[i];
+        min = (below && (delta < min)) ? delta : min;
+    }
+    if (min == std::numeric_limits<double>::infinity())
+    {
+        return std::nullopt;
+    }
+    return min;
+}
+
+/**
+ * @brief Get the position of the last member below a value by less
+ *        than a limit
+ *
+ * @param[in] range - The group's range
+ * @param[in] state - The value to compare against
+ * @param[in] limit - The limit on the difference
+ *
+ * @return The member's position, or std::nullopt when there is none
+ */
+inline std::optional<size_t> lastWithinBelowState(const NumericRange& range,
+                                                  double state, double limit)
+{
+    const auto* v = range.values();
+    const auto* s = range.states();
+    size_t last = 0;
+    for (size_t i = 0; i < range.size; i++)
+    {
+        auto within = (s[i] == NumericColumn::number) & (v[i] < state) &
+                      (state - v[i] < limit);
+        last = within ? i + 1 : last;
+    }
+    if (last == 0)
+    {
+        return std::nullopt;
+    }
+    return last - 1;
+}
+
+} // namespace phosphor::fan::control::json::reduction
@@ -0,0 +1,237 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+namespace phosphor::fan::control::json
+{
+
+/* Interned identifier of a hold */
+using HoldId = uint32_t;
+
+/* What a hold name identifies, each interned in its own namespace so an
+ * action and a group with the same name don't share a hold */
+enum class HoldScope : size_t
+{
+    action,
+    group
+};
+
+/**
+ * @class HoldIds
+ *
+ * Interns the names holds are set under, so the zones' hold arbiters are
+ * keyed by integers instead of hashing and comparing the names each time a
+ * hold is set. Names are interned once, the first time the actions setting
+ * the holds run, and only looked up again for logging and dumps.
+ *
+ * The identifiers are only valid for the configuration they were interned
+ * under, the manager clears them all when it replaces the configuration.
+ */
+class HoldIds
+{
+  public:
+    HoldIds() = delete;
+
+    /**
+     * @brief Get the identifier of a hold name, interning it if it's new
+     *
+     * @param[in] scope - What the name identifies
+     * @param[in] name - The hold name
+     *
+     * @return The hold identifier
+     */
+    static HoldId intern(HoldScope scope, const std::string& name)
+    {
+        auto& ids = _ids[static_cast<size_t>(scope)];
+        auto [itId, added] =
+            ids.try_emplace(name, static_cast<HoldId>(_names.size()));
+        if (added)
+        {
+            _names.push_back(name);
+        }
+        return itId->second;
+    }
+
+    /**
+     * @brief Get the name a hold identifier was interned from
+     *
+     * @param[in] id - The hold identifier
+     *
+     * @return The hold name
+     */
+    static const std::string& name(HoldId id)
+    {
+        return _names.at(id);
+    }
+
+    /**
+     * @brief Get the number of interned hold names
+     */
+    static size_t size()
+    {
+        return _names.size();
+    }
+
+    /**
+     * @brief Release all hold identifiers, so they're reused
+     *
+     * Must only be called once nothing holds on to an identifier anymore.
+     */
+    static void clear()
+    {
+        for (auto& ids : _ids)
+        {
+            ids.clear();
+        }
+        _names.clear();
+    }
+
+  private:
+    /* Map of hold names to their identifiers, per scope */
+    static inline std::array<std::unordered_map<std::string, HoldId>, 2> _ids;
+
+    /* Hold names by identifier, in a deque so references stay valid */
+    static inline std::deque<std::string> _names;
+};
+
+/**
+ * @class HoldArbiter
+ *
+ * Keeps the values held by each hold identifier ordered, so the winning
+ * (highest) hold is available without scanning all holds.
+ *
+ * Each identifier maps to its position in an ordered multiset of the held
+ * values, making setting or releasing a hold a single lookup plus an
+ * O(log n) reinsert, and getting the highest hold O(1).
+ */
+class HoldArbiter
+{
+  public:
+    /* Result of setting a hold */
+    enum class SetResult
+    {
+        unchanged,
+        added,
+        changed
+    };
+
+    HoldArbiter() = default;
+    HoldArbiter(const HoldArbiter&) = delete;
+    HoldArbiter& operator=(const HoldArbiter&) = delete;
+    HoldArbiter(HoldArbiter&&) = delete;
+    HoldArbiter& operator=(HoldArbiter&&) = delete;
+    ~HoldArbiter() = default;
+
+    /**
+     * @brief Set or update an identifier's hold
+     *
+     * @param[in] ident - Unique identifier of the hold
+     * @param[in] value - Value to hold
+     *
+     * @return Whether the hold was added, changed, or already held the value
+     */
+    SetResult set(HoldId ident, uint64_t value)
+    {
+        auto [itHold, added] = _holds.try_emplace(ident, _values.end());
+        if (added)
+        {
+            itHold->second = _values.insert(value);
+            return SetResult::added;
+        }
+        if (*itHold->second == value)
+        {
+            return SetResult::unchanged;
+        }
+        _values.erase(itHold->second);
+        itHold->second = _values.insert(value);
+        return SetResult::changed;
+    }
+
+    /**
+     * @brief Release an identifier's hold
+     *
+     * @param[in] ident - Unique identifier of the hold
+     *
+     * @return Whether the identifier had a hold
+     */
+    bool erase(HoldId ident)
+    {
+        auto itHold = _holds.find(ident);
+        if (itHold == _holds.end())
+        {
+            return false;
+        }
+        _values.erase(itHold->second);
+        _holds.erase(itHold);
+        return true;
+    }
+
+    /**
+     * @brief Get the highest held value
+     *
+     * @return The highest hold, or std::nullopt when nothing is held
+     */
+    inline std::optional<uint64_t> max() const
+    {
+        if (_values.empty())
+        {
+            return std::nullopt;
+        }
+        return *_values.rbegin();
+    }
+
+    /**
+     * @brief Get the number of holds
+     */
+    inline size_t size() const
+    {
+        return _holds.size();
+    }
+
+    /**
+     * @brief Get each hold's held value by hold name
+     *
+     * @return Map of hold names to their held value
+     */
+    std::unordered_map<std::string, uint64_t> getHolds() const
+    {
+        std::unordered_map<std::string, uint64_t> holds;
+        for (const auto& [ident, itValue] : _holds)
+        {
+            holds.emplace(HoldIds::name(ident), *itValue);
+        }
+        return holds;
+    }
+
+  private:
+    using Values = std::multiset<uint64_t>;
+
+    /* All held values in order */
+    Values _values;
+
+    /* Map of hold identifiers to their value's position in _values */
+    std::unordered_map<HoldId, Values::iterator> _holds;
+};
+
+} // namespace phosphor::fan::control::json
@@ -0,0 +1,239 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "config_base.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace phosphor::fan::control::json
+{
+
+class NumericColumn;
+
+/**
+ * @brief A group's contiguous run of slots within a NumericColumn
+ *
+ * The pointers to the values and states are fetched on each use, since
+ * they change as ranges are added to the column.
+ */
+struct NumericRange
+{
+    /* The column the range is in */
+    const NumericColumn* column = nullptr;
+
+    /* The range's first slot */
+    size_t offset = 0;
+
+    /* Number of slots, one per group member */
+    size_t size = 0;
+
+    inline const double* values() const;
+    inline const uint8_t* states() const;
+
+    /**
+     * @brief Get whether every cached member value is a double
+     *
+     * @return false when any member's value is of another type, in
+     *         which case the range's values can't stand in for the
+     *         cached variants
+     */
+    inline bool allNumeric() const;
+
+    /**
+     * @brief Get the maximum of the cached member values
+     *
+     * @return The maximum, or std::nullopt when no member has a value
+     */
+    inline std::optional<double> max() const;
+};
+
+/**
+ * @class NumericColumn
+ *
+ * Holds the cached values of one interface property for groups of
+ * objects as contiguous doubles, so actions can reduce over a group's
+ * values directly rather than looking each member up in the object
+ * cache and comparing variants.
+ *
+ * Each distinct list of group members is given its own contiguous range
+ * of slots, shared by every group with the same members. A slot's state
+ * says whether the member's value is cached, and if so whether it's a
+ * double; members holding any other type leave the variant cache as the
+ * only source for their group's values.
+ */
+class NumericColumn
+{
+  public:
+    /* State of a slot's value */
+    enum State : uint8_t
+    {
+        missing = 0,
+        number = 1,
+        other = 2
+    };
+
+    NumericColumn() = default;
+    NumericColumn(const NumericColumn&) = delete;
+    NumericColumn& operator=(const NumericColumn&) = delete;
+    NumericColumn(NumericColumn&&) = delete;
+    NumericColumn& operator=(NumericColumn&&) = delete;
+    ~NumericColumn() = default;
+
+    /**
+     * @brief Get the range of slots for a list of group members, adding
+     *        one when the list is new to the column
+     *
+     * @param[in] paths - The group member object paths
+     * @param[out] added - Whether the range was newly added, with its
+     *                     slots still to be set from the object cache
+     *
+     * @return The range
+     */
+    NumericRange addRange(const std::vector<std::string>& paths, bool& added)
+    {
+        auto itRange = _ranges.find(paths);
+        added = (itRange == _ranges.end());
+        if (!added)
+        {
+            return itRange->second;
+        }
+
+        NumericRange range{this, _values.size(), paths.size()};
+        _values.resize(range.offset + range.size, 0.0);
+        _states.resize(range.offset + range.size, missing);
+        for (size_t i = 0; i < paths.size(); i++)
+        {
+            _slots[paths[i]].push_back(range.offset + i);
+        }
+        _ranges.emplace(paths, range);
+        return range;
+    }
+
+    /**
+     * @brief Update an object's value in all of its slots
+     *
+     * @param[in] path - The object path
+     * @param[in] value - The object's property value
+     */
+    void set(const std::string& path, const PropertyVariantType& value)
+    {
+        auto itSlots = _slots.find(path);
+        if (itSlots == _slots.end())
+        {
+            return;
+        }
+
+        auto dblPtr = std::get_if<double>(&value);
+        for (auto slot : itSlots->second)
+        {
+            _values[slot] = dblPtr ? *dblPtr : 0.0;
+            _states[slot] = dblPtr ? number : other;
+        }
+    }
+
+    /**
+     * @brief Mark an object's value as no longer cached
+     *
+     * @param[in] path - The object path
+     */
+    void erase(const std::string& path)
+    {
+        auto itSlots = _slots.find(path);
+        if (itSlots == _slots.end())
+        {
+            return;
+        }
+
+        for (auto slot : itSlots->second)
+        {
+            _states[slot] = missing;
+        }
+    }
+
+    inline const std::vector<double>& getValues() const
+    {
+        return _values;
+    }
+
+    inline const std::vector<uint8_t>& getStates() const
+    {
+        return _states;
+    }
+
+  private:
+    /* Map of group member lists to their range */
+    std::map<std::vector<std::string>, NumericRange> _ranges;
+
+    /* Map of object paths to the slots holding their value */
+    std::unordered_map<std::string, std::vector<size_t>> _slots;
+
+    /* Value of each slot, valid when its state is number */
+    std::vector<double> _values;
+
+    /* State of each slot's value */
+    std::vector<uint8_t> _states;
+};
+
+inline const double* NumericRange::values() const
+{
+    return column->getValues().data() + offset;
+}
+
+inline const uint8_t* NumericRange::states() const
+{
+    return column->getStates().data() + offset;
+}
+
+inline bool NumericRange::allNumeric() const
+{
+    const auto* s = states();
+    size_t others = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        others += (s[i] == NumericColumn::other);
+    }
+    return others == 0;
+}
+
+inline std::optional<double> NumericRange::max() const
+{
+    const auto* v = values();
+    const auto* s = states();
+    auto max = -std::numeric_limits<double>::infinity();
+    size_t found = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        auto valid = (s[i] == NumericColumn::number);
+        max = (valid && (v[i] > max)) ? v[i] : max;
+        found += valid;
+    }
+    if (found == 0)
+    {
+        return std::nullopt;
+    }
+    return max;
+}
+
+} // namespace phosphor::fan::control::json
@@ -0,0 +1,104 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+namespace phosphor::fan::control::json
+{
+
+/**
+ * @class SPSCQueue
+ *
+ * A bounded, lock-free queue for passing items from exactly one producer
+ * thread to exactly one consumer thread.
+ *
+ * The head index is only written by the consumer and the tail index only by
+ * the producer, so each side just needs to acquire the other's index to see
+ * the slots it handed over.
+ *
+ * @tparam T - Type of the queued items
+ * @tparam N - Capacity of the queue, must be a power of two
+ */
+template <typename T, size_t N>
+class SPSCQueue
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0,
+                  "SPSCQueue capacity must be a power of two");
+
+  public:
+    SPSCQueue() = default;
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+    SPSCQueue(SPSCQueue&&) = delete;
+    SPSCQueue& operator=(SPSCQueue&&) = delete;
+    ~SPSCQueue() = default;
+
+    /**
+     * @brief Add an item to the queue, only called by the producer
+     *
+     * @param[in] item - The item to add
+     *
+     * @return Whether the item was added, false when the queue is full
+     */
+    bool push(T&& item)
+    {
+        auto tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == N)
+        {
+            return false;
+        }
+        _slots[tail & (N - 1)] = std::move(item);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest item from the queue, only called by the
+     * consumer
+     *
+     * @return The item, or std::nullopt when the queue is empty
+     */
+    std::optional<T> pop()
+    {
+        auto head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire))
+        {
+            return std::nullopt;
+        }
+        std::optional<T> item{std::move(_slots[head & (N - 1)])};
+        // Release anything the slot held before handing it back
+        _slots[head & (N - 1)] = T{};
+        _head.store(head + 1, std::memory_order_release);
+        return item;
+    }
+
+  private:
+    /* The queued items */
+    std::array<T, N> _slots;
+
+    /* Count of items removed, on its own cache line from the producer's */
+    alignas(64) std::atomic<size_t> _head{0};
+
+    /* Count of items added */
+    alignas(64) std::atomic<size_t> _tail{0};
+};
+
+} // namespace phosphor::fan::control::json
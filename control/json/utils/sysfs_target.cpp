@@ -0,0 +1,151 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sysfs_target.hpp"
+
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <fnmatch.h>
+#include <unistd.h>
+
+#include <phosphor-logging/log.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <set>
+
+namespace phosphor::fan::control::json
+{
+
+using namespace phosphor::logging;
+namespace fs = std::filesystem;
+
+SysfsTarget::SysfsTarget(const std::string& path) :
+    _configPath(path), _path(path)
+{
+    open();
+}
+
+bool SysfsTarget::open()
+{
+    // Close the old attribute first, when reopening it
+    _fd.reset();
+
+    auto attrPath = resolve(_configPath);
+    if (!attrPath)
+    {
+        if (!_failed)
+        {
+            log<level::ERR>(fmt::format("No fan target attribute found at {}",
+                                        _configPath)
+                                .c_str());
+        }
+        _failed = true;
+        _fd.emplace(-1);
+        return false;
+    }
+    _path = attrPath->string();
+
+    _fd.emplace(::open(_path.c_str(), O_WRONLY | O_CLOEXEC));
+    if (!_fd->is_open())
+    {
+        if (!_failed)
+        {
+            log<level::ERR>(fmt::format("Failed to open fan target attribute "
+                                        "{}: {}",
+                                        _path, strerror(errno))
+                                .c_str());
+        }
+        _failed = true;
+        return false;
+    }
+    return true;
+}
+
+bool SysfsTarget::write(uint64_t target)
+{
+    if (!_fd->is_open() && !open())
+    {
+        return false;
+    }
+
+    auto value = std::to_string(target) + '\n';
+    auto rc = ::pwrite((*_fd)(), value.data(), value.size(), 0);
+    if ((rc == -1) && ((errno == ENODEV) || (errno == ENOENT)))
+    {
+        // The device went away, as when its driver is rebound, so its
+        // attribute may be back under a new hwmon instance
+        if (!open())
+        {
+            return false;
+        }
+        rc = ::pwrite((*_fd)(), value.data(), value.size(), 0);
+    }
+    if (rc != static_cast<ssize_t>(value.size()))
+    {
+        if (!_failed)
+        {
+            log<level::ERR>(fmt::format("Failed to write target {} to {}: {}",
+                                        target, _path,
+                                        (rc == -1) ? strerror(errno)
+                                                   : "Short write")
+                                .c_str());
+        }
+        _failed = true;
+        return false;
+    }
+
+    _failed = false;
+    return true;
+}
+
+std::optional<fs::path> SysfsTarget::resolve(const fs::path& path)
+{
+    fs::path resolved;
+    for (const auto& name : path)
+    {
+        if (name.string().find('*') == std::string::npos)
+        {
+            resolved /= name;
+            continue;
+        }
+
+        // Take the first match in name order, as the order entries are
+        // read in isn't defined
+        std::set<std::string> matches;
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(resolved, ec))
+        {
+            auto entryName = entry.path().filename().string();
+            if (fnmatch(name.c_str(), entryName.c_str(), 0) == 0)
+            {
+                matches.insert(entryName);
+            }
+        }
+        if (matches.empty())
+        {
+            return std::nullopt;
+        }
+        resolved /= *matches.begin();
+    }
+
+    if (!fs::exists(resolved))
+    {
+        return std::nullopt;
+    }
+    return resolved;
+}
+
+} // namespace phosphor::fan::control::json
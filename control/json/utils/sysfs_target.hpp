@@ -0,0 +1,113 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "utility.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace phosphor::fan::control::json
+{
+
+/**
+ * @class SysfsTarget
+ *
+ * Writes a fan sensor's target straight to the hwmon sysfs attribute it's
+ * held in, `pwmN` or `fanN_target`, instead of through the `Target`
+ * property of the sensor's D-Bus object.
+ *
+ * The attribute is opened once and kept open, and is reopened when the
+ * device went away, as when the driver is rebound. Every target given is
+ * written, as fan control isn't the attribute's only writer (phosphor-hwmon
+ * writes it when the sensor's `Target` property is set) and so can't know
+ * what the attribute holds from what it last wrote. Unchanged targets are
+ * skipped by the fan instead.
+ */
+class SysfsTarget
+{
+  public:
+    SysfsTarget() = delete;
+    ~SysfsTarget() = default;
+    SysfsTarget(const SysfsTarget&) = delete;
+    SysfsTarget& operator=(const SysfsTarget&) = delete;
+    SysfsTarget(SysfsTarget&&) = delete;
+    SysfsTarget& operator=(SysfsTarget&&) = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * Opens the attribute, logging when it can't be, in which case it's
+     * opened again on the next write.
+     *
+     * @param[in] path - The attribute's path, where a `*` in a directory
+     *                   name matches any name, as in `hwmon/hwmon*`
+     */
+    explicit SysfsTarget(const std::string& path);
+
+    /**
+     * @brief Write a target to the attribute
+     *
+     * @param[in] target - The target
+     *
+     * @return Whether the attribute holds the target, false when it
+     *         couldn't be written
+     */
+    bool write(uint64_t target);
+
+    /**
+     * @brief Get the attribute's path, with any `*` resolved
+     */
+    inline const auto& getPath() const
+    {
+        return _path;
+    }
+
+    /**
+     * @brief Resolve the directory names with a `*` in a path, using the
+     *        first entry of each that matches
+     *
+     * @param[in] path - The path
+     *
+     * @return The resolved path, or std::nullopt when nothing matches
+     */
+    static std::optional<std::filesystem::path>
+        resolve(const std::filesystem::path& path);
+
+  private:
+    /**
+     * @brief Resolve and open the attribute, closing any open one
+     *
+     * @return Whether the attribute is open
+     */
+    bool open();
+
+    /* The attribute's path as configured */
+    const std::string _configPath;
+
+    /* The attribute's path, with any `*` resolved when it was opened */
+    std::string _path;
+
+    /* The open attribute, -1 when it couldn't be opened */
+    std::optional<util::FileDescriptor> _fd;
+
+    /* Set after a failed write, so only the first in a row is logged */
+    bool _failed = false;
+};
+
+} // namespace phosphor::fan::control::json
@@ -0,0 +1,300 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "timer_wheel.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <functional>
+#include <optional>
+
+namespace phosphor::fan::control::json
+{
+
+using namespace std::chrono;
+
+TimerWheel::TimerWheel(const sdeventplus::Event& event,
+                       std::chrono::milliseconds slack) :
+    _epoch(Clock::now()),
+    _slack(std::max(duration_cast<microseconds>(slack), microseconds{1})),
+    _tick(0), _armed(0), _wakeups(0),
+    _source(event, std::bind(&TimerWheel::expired, this))
+{}
+
+json TimerWheel::dump() const
+{
+    auto elapsed = duration_cast<duration<double>>(Clock::now() - _epoch);
+
+    json data;
+    data["armed"] = _armed;
+    data["slack_ms"] = duration_cast<milliseconds>(_slack).count();
+    data["wakeups"] = _wakeups;
+    data["wakeups_per_sec"] =
+        (elapsed.count() > 0) ? (_wakeups / elapsed.count()) : 0.0;
+    return data;
+}
+
+uint64_t TimerWheel::toTick(Clock::time_point time, bool roundUp) const
+{
+    if (time <= _epoch)
+    {
+        return 0;
+    }
+    auto since = duration_cast<microseconds>(time - _epoch);
+    auto tick = static_cast<uint64_t>(since / _slack);
+    if (roundUp && (since % _slack) != microseconds{0})
+    {
+        tick++;
+    }
+    return tick;
+}
+
+void TimerWheel::insert(WheelTimer& timer)
+{
+    if (_armed == 0)
+    {
+        // Nothing was scheduled, so skip ahead to the current tick
+        _tick = toTick(Clock::now(), false);
+    }
+
+    timer._expires = std::max(toTick(timer._deadline, true), _tick + 1);
+    place(timer);
+    _armed++;
+}
+
+void TimerWheel::remove(WheelTimer& timer)
+{
+    auto& slot = *timer._slot;
+    slot.erase(timer._pos);
+    timer._slot = nullptr;
+    _armed--;
+    if (slot.empty())
+    {
+        vacate(slot, timer._expires);
+    }
+}
+
+void TimerWheel::vacate(const Slot& slot, uint64_t expires)
+{
+    auto index = expires & nearMask;
+    if (&slot == &_near[index])
+    {
+        _nearOccupied[index / wordBits] &= ~(uint64_t{1} << (index % wordBits));
+        return;
+    }
+
+    index = (expires >> nearBits) & farMask;
+    if (&slot == &_far[index])
+    {
+        _farOccupied &= ~(uint64_t{1} << index);
+    }
+}
+
+void TimerWheel::place(WheelTimer& timer)
+{
+    auto block = timer._expires >> nearBits;
+    auto current = _tick >> nearBits;
+
+    Slot* slot;
+    if (block == current)
+    {
+        auto index = timer._expires & nearMask;
+        slot = &_near[index];
+        _nearOccupied[index / wordBits] |= uint64_t{1} << (index % wordBits);
+    }
+    else if (block - current < farSlots)
+    {
+        auto index = block & farMask;
+        slot = &_far[index];
+        auto bit = uint64_t{1} << index;
+        if (!(_farOccupied & bit) || timer._expires < _farEarliest[index])
+        {
+            _farEarliest[index] = timer._expires;
+        }
+        _farOccupied |= bit;
+    }
+    else
+    {
+        slot = &_overflow;
+    }
+    timer._pos = slot->insert(slot->end(), &timer);
+    timer._slot = slot;
+}
+
+void TimerWheel::cascade(Slot& slot)
+{
+    Slot timers;
+    timers.swap(slot);
+    for (auto* timer : timers)
+    {
+        place(*timer);
+    }
+}
+
+void TimerWheel::advance()
+{
+    _tick++;
+    if ((_tick & nearMask) == 0)
+    {
+        // Entered a new block of ticks, bring its timers into the near wheel
+        auto block = _tick >> nearBits;
+        if ((block & farMask) == 0)
+        {
+            cascade(_overflow);
+        }
+        _farOccupied &= ~(uint64_t{1} << (block & farMask));
+        cascade(_far[block & farMask]);
+    }
+
+    auto index = _tick & nearMask;
+    _nearOccupied[index / wordBits] &= ~(uint64_t{1} << (index % wordBits));
+
+    // Timers armed from the callbacks always expire in a later tick, so
+    // they never land in the slot being run
+    auto& slot = _near[index];
+    while (!slot.empty())
+    {
+        auto* timer = slot.front();
+        slot.pop_front();
+        timer->_slot = nullptr;
+        _armed--;
+
+        if (timer->_repeating)
+        {
+            // Rearm from the last deadline so coalescing doesn't drift the
+            // interval, unless the deadline has fallen behind
+            auto now = Clock::now();
+            timer->_deadline += timer->_interval;
+            if (timer->_deadline < now)
+            {
+                timer->_deadline = now + timer->_interval;
+            }
+            insert(*timer);
+        }
+
+        // The callback may disable or destroy the timer
+        if (timer->_callback)
+        {
+            timer->_callback(*timer);
+        }
+    }
+}
+
+void TimerWheel::expired()
+{
+    _wakeups++;
+
+    auto now = toTick(Clock::now(), false);
+    while (_armed > 0 && _tick < now)
+    {
+        advance();
+    }
+
+    schedule();
+}
+
+std::optional<uint64_t> TimerWheel::nextNear() const
+{
+    auto index = (_tick + 1) & nearMask;
+    if (index == 0)
+    {
+        // The current tick is the last of its block
+        return std::nullopt;
+    }
+
+    auto word = index / wordBits;
+    auto bits = _nearOccupied[word] & (~uint64_t{0} << (index % wordBits));
+    while (bits == 0)
+    {
+        if (++word == _nearOccupied.size())
+        {
+            return std::nullopt;
+        }
+        bits = _nearOccupied[word];
+    }
+    return (_tick & ~nearMask) + (word * wordBits) + std::countr_zero(bits);
+}
+
+void TimerWheel::schedule()
+{
+    if (_armed == 0)
+    {
+        _source.setEnabled(false);
+        return;
+    }
+
+    auto next = nextNear();
+
+    // First later block with timers, waking for its earliest timer. The
+    // current block's far slot is always empty, so rotating the bitmap to
+    // start at the next block finds it in a single scan.
+    auto current = _tick >> nearBits;
+    if (!next && _farOccupied != 0)
+    {
+        auto offset = std::countr_zero(std::rotr(
+            _farOccupied, static_cast<int>((current + 1) & farMask)));
+        next = _farEarliest[(current + 1 + offset) & farMask];
+    }
+
+    if (!_overflow.empty())
+    {
+        // Wake when the overflow timers get cascaded into the far wheel
+        auto cascadeTick = ((current | farMask) + 1) << nearBits;
+        next = next ? std::min(*next, cascadeTick) : cascadeTick;
+    }
+
+    auto wake = _epoch + (_slack * static_cast<int64_t>(*next));
+    auto now = Clock::now();
+    _source.restartOnce((wake > now) ? duration_cast<microseconds>(wake - now)
+                                     : microseconds{0});
+}
+
+void WheelTimer::restart(std::chrono::microseconds interval)
+{
+    setEnabled(false);
+    _interval = interval;
+    _repeating = true;
+    setEnabled(true);
+}
+
+void WheelTimer::restartOnce(std::chrono::microseconds interval)
+{
+    setEnabled(false);
+    _interval = interval;
+    _repeating = false;
+    setEnabled(true);
+}
+
+void WheelTimer::setEnabled(bool enabled)
+{
+    if (enabled == isEnabled())
+    {
+        return;
+    }
+
+    if (enabled)
+    {
+        _deadline = std::chrono::steady_clock::now() + _interval;
+        _wheel.insert(*this);
+    }
+    else
+    {
+        _wheel.remove(*this);
+    }
+    _wheel.schedule();
+}
+
+} // namespace phosphor::fan::control::json
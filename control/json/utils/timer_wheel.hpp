@@ -0,0 +1,325 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <optional>
+
+namespace phosphor::fan::control::json
+{
+
+using json = nlohmann::json;
+
+class WheelTimer;
+
+/**
+ * @class TimerWheel
+ *
+ * A hierarchical timer wheel that schedules any number of WheelTimers off of
+ * a single monotonic sd-event timer source.
+ *
+ * Time is split into ticks the length of the configured slack and timer
+ * deadlines are rounded up to the next tick, so all timers expiring within
+ * the same tick are run from one wake-up. Timers expiring in the current
+ * block of near ticks are kept in the near wheel, later ones in the far
+ * wheel (one slot per block of near ticks) and anything further out in an
+ * overflow list. Far and overflow timers are cascaded down as time reaches
+ * them, which keeps arming and canceling a timer O(1).
+ *
+ * The underlying timer source is only armed for the next tick that has work
+ * to do and is disabled when no timers are armed. Occupancy bitmaps of the
+ * near and far wheels, along with a bound on each far slot's earliest
+ * expiration, let that tick be found with a few bit scans instead of walking
+ * the slots.
+ */
+class TimerWheel
+{
+  public:
+    TimerWheel() = delete;
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    TimerWheel(TimerWheel&&) = delete;
+    TimerWheel& operator=(TimerWheel&&) = delete;
+    ~TimerWheel() = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] event - The sdeventplus event loop to run timers from
+     * @param[in] slack - Tick length timer deadlines are coalesced to
+     */
+    TimerWheel(const sdeventplus::Event& event,
+               std::chrono::milliseconds slack);
+
+    /**
+     * @brief Get the number of armed timers
+     *
+     * @return Number of timers currently scheduled on the wheel
+     */
+    inline auto getArmed() const
+    {
+        return _armed;
+    }
+
+    /**
+     * @brief Dump the wheel's statistics
+     *
+     * @return json - The armed timer count, slack and wake-up rate
+     */
+    json dump() const;
+
+  private:
+    friend class WheelTimer;
+
+    using Clock = std::chrono::steady_clock;
+    using Slot = std::list<WheelTimer*>;
+
+    /* Number of ticks in the near wheel (2^nearBits) */
+    static constexpr size_t nearBits = 8;
+    static constexpr uint64_t nearSlots = 1 << nearBits;
+    static constexpr uint64_t nearMask = nearSlots - 1;
+
+    /* Number of blocks of near ticks in the far wheel, one bit of a word */
+    static constexpr uint64_t farSlots = 64;
+    static constexpr uint64_t farMask = farSlots - 1;
+
+    /* Number of bits in each word of the near wheel's occupancy bitmap */
+    static constexpr uint64_t wordBits = 64;
+
+    /**
+     * @brief Arm a timer to expire at its deadline
+     *
+     * @param[in] timer - Timer to add to the wheel
+     */
+    void insert(WheelTimer& timer);
+
+    /**
+     * @brief Cancel an armed timer
+     *
+     * @param[in] timer - Timer to remove from the wheel
+     */
+    void remove(WheelTimer& timer);
+
+    /**
+     * @brief Place a timer in the slot for its expiration tick
+     *
+     * @param[in] timer - Timer to place
+     */
+    void place(WheelTimer& timer);
+
+    /**
+     * @brief Clear a slot's occupancy once its last timer has left it
+     *
+     * @param[in] slot - Slot the timer was removed from
+     * @param[in] expires - Expiration tick of the removed timer
+     */
+    void vacate(const Slot& slot, uint64_t expires);
+
+    /**
+     * @brief Get the next tick of the current block with timers to run
+     *
+     * @return The tick, or std::nullopt when the rest of the block is empty
+     */
+    std::optional<uint64_t> nextNear() const;
+
+    /**
+     * @brief Re-place all timers of a slot relative to the current tick
+     *
+     * @param[in] slot - Far wheel or overflow slot to cascade
+     */
+    void cascade(Slot& slot);
+
+    /**
+     * @brief Advance the wheel by one tick, running the timers that expire
+     */
+    void advance();
+
+    /**
+     * @brief Callback of the timer source, runs all timers that expired
+     */
+    void expired();
+
+    /**
+     * @brief Arm the timer source for the next tick with timers to run
+     */
+    void schedule();
+
+    /**
+     * @brief Get the tick a point in time falls in
+     *
+     * @param[in] time - Point in time
+     * @param[in] roundUp - Whether to round up to the next tick
+     *
+     * @return The tick number
+     */
+    uint64_t toTick(Clock::time_point time, bool roundUp) const;
+
+    /* Point in time of tick zero */
+    const Clock::time_point _epoch;
+
+    /* Tick length */
+    const std::chrono::microseconds _slack;
+
+    /* Last tick that was run */
+    uint64_t _tick;
+
+    /* Slots for the ticks within the current block */
+    std::array<Slot, nearSlots> _near;
+
+    /* Slots for the next blocks of ticks */
+    std::array<Slot, farSlots> _far;
+
+    /* Timers beyond the far wheel */
+    Slot _overflow;
+
+    /* Bit per near slot that has timers */
+    std::array<uint64_t, nearSlots / wordBits> _nearOccupied{};
+
+    /* Bit per far slot that has timers */
+    uint64_t _farOccupied = 0;
+
+    /*
+     * Earliest expiration tick placed in each occupied far slot. Canceling
+     * a timer doesn't raise it, so it can be early by at most one wake-up
+     * before the slot is cascaded.
+     */
+    std::array<uint64_t, farSlots> _farEarliest{};
+
+    /* Number of armed timers */
+    size_t _armed;
+
+    /* Number of times the timer source has woken up the event loop */
+    uint64_t _wakeups;
+
+    /* The single timer source driving the wheel */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> _source;
+};
+
+/**
+ * @class WheelTimer
+ *
+ * A timer scheduled on a TimerWheel, providing the same restart, restartOnce,
+ * setEnabled, and isEnabled interface as sdeventplus's utility timer.
+ */
+class WheelTimer
+{
+  public:
+    using Callback = std::function<void(WheelTimer&)>;
+
+    WheelTimer() = delete;
+    WheelTimer(const WheelTimer&) = delete;
+    WheelTimer& operator=(const WheelTimer&) = delete;
+    WheelTimer(WheelTimer&&) = delete;
+    WheelTimer& operator=(WheelTimer&&) = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * The timer is created disabled.
+     *
+     * @param[in] wheel - The timer wheel to schedule on
+     * @param[in] callback - Function to call each time the timer expires
+     */
+    explicit WheelTimer(TimerWheel& wheel, Callback&& callback = nullptr) :
+        _wheel(wheel), _callback(std::move(callback))
+    {}
+
+    ~WheelTimer()
+    {
+        setEnabled(false);
+    }
+
+    /**
+     * @brief Set the function to call when the timer expires
+     *
+     * @param[in] callback - Function to call each time the timer expires
+     */
+    inline void setCallback(Callback&& callback)
+    {
+        _callback = std::move(callback);
+    }
+
+    /**
+     * @brief (Re)start the timer to repeatedly expire at the given interval
+     *
+     * @param[in] interval - Time between each expiration
+     */
+    void restart(std::chrono::microseconds interval);
+
+    /**
+     * @brief (Re)start the timer to expire once after the given interval
+     *
+     * @param[in] interval - Time until the expiration
+     */
+    void restartOnce(std::chrono::microseconds interval);
+
+    /**
+     * @brief Enable or disable the timer
+     *
+     * Enabling a disabled timer starts it again with its last interval.
+     *
+     * @param[in] enabled - Whether the timer should be armed
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * @brief Get whether the timer is armed
+     *
+     * @return Whether the timer is armed on the wheel
+     */
+    inline bool isEnabled() const
+    {
+        return _slot != nullptr;
+    }
+
+  private:
+    friend class TimerWheel;
+
+    /* The timer wheel this timer is scheduled on */
+    TimerWheel& _wheel;
+
+    /* Function to call when the timer expires */
+    Callback _callback;
+
+    /* Time between expirations */
+    std::chrono::microseconds _interval{0};
+
+    /* Whether the timer rearms itself after expiring */
+    bool _repeating = false;
+
+    /* Point in time the timer should expire */
+    std::chrono::steady_clock::time_point _deadline;
+
+    /* Tick of the wheel the timer expires in */
+    uint64_t _expires = 0;
+
+    /* Slot of the wheel the timer is placed in, nullptr when disabled */
+    std::list<WheelTimer*>* _slot = nullptr;
+
+    /* Position within the slot for O(1) removal */
+    std::list<WheelTimer*>::iterator _pos;
+};
+
+} // namespace phosphor::fan::control::json
@@ -18,6 +18,7 @@
 #include "../utils/flight_recorder.hpp"
 #include "dbus_zone.hpp"
 #include "fan.hpp"
+#include "manager.hpp"
 #include "sdbusplus.hpp"
 
 #include <nlohmann/json.hpp>
@@ -52,8 +53,13 @@ Zone::Zone(const json& jsonObj, const sdeventplus::Event& event, Manager* mgr) :
     ConfigBase(jsonObj), _dbusZone{}, _manager(mgr), _defaultFloor(0),
     _incDelay(0), _decInterval(0), _floor(0), _target(0), _incDelta(0),
     _decDelta(0), _requestTargetBase(0), _isActive(true),
-    _incTimer(event, std::bind(&Zone::incTimerExpired, this)),
-    _decTimer(event, std::bind(&Zone::decTimerExpired, this))
+    _incTimer(Manager::getTimerWheel(),
+              std::bind(&Zone::incTimerExpired, this)),
+    _decTimer(Manager::getTimerWheel(),
+              std::bind(&Zone::decTimerExpired, this)),
+    _floorChangeDenied(0), _decDenied(0),
+    _targetRecorderId("zone-target" + getName()),
+    _floorRecorderId("zone-floor" + getName())
 {
     // Increase delay is optional, defaults to 0
     if (jsonObj.contains("increase_delay"))
@@ -150,6 +156,10 @@ void Zone::setTarget(uint64_t target)
             FlightRecorder::instance().log(
                 "zone-set-target" + getName(),
                 fmt::format("Set target {} (from {})", target, _target));
+            if (_manager)
+            {
+                _manager->queueTelemetry();
+            }
         }
         _target = target;
         for (auto& fan : _fans)
@@ -203,52 +213,50 @@ void Zone::unlockFanTarget(const std::string& fname, uint64_t target)
     }
 }
 
-void Zone::setTargetHold(const std::string& ident, uint64_t target, bool hold)
+void Zone::setTargetHold(HoldId ident, uint64_t target, bool hold)
 {
-    using namespace std::string_literals;
-
     if (!hold)
     {
-        size_t removed = _targetHolds.erase(ident);
-        if (removed)
+        if (_targetHolds.erase(ident))
         {
             FlightRecorder::instance().log(
-                "zone-target"s + getName(),
-                fmt::format("{} is removing target hold", ident));
+                _targetRecorderId,
+                fmt::format("{} is removing target hold",
+                            HoldIds::name(ident)));
         }
     }
     else
     {
-        if (!((_targetHolds.find(ident) != _targetHolds.end()) &&
-              (_targetHolds[ident] == target)))
+        auto result = _targetHolds.set(ident, target);
+        if (result != HoldArbiter::SetResult::unchanged)
         {
             FlightRecorder::instance().log(
-                "zone-target"s + getName(),
-                fmt::format("{} is setting target hold to {}", ident, target));
+                _targetRecorderId,
+                fmt::format("{} is setting target hold to {}",
+                            HoldIds::name(ident), target));
         }
-        _targetHolds[ident] = target;
         _isActive = false;
     }
 
-    auto itHoldMax = std::max_element(_targetHolds.begin(), _targetHolds.end(),
-                                      [](const auto& aHold, const auto& bHold) {
-                                          return aHold.second < bHold.second;
-                                      });
-    if (itHoldMax == _targetHolds.end())
+    auto holdMax = _targetHolds.max();
+    if (!holdMax)
     {
         _isActive = true;
     }
     else
     {
-        if (_target != itHoldMax->second)
+        if (_target != *holdMax)
         {
             FlightRecorder::instance().log(
-                "zone-target"s + getName(),
-                fmt::format("Settings fans to target hold of {}",
-                            itHoldMax->second));
+                _targetRecorderId,
+                fmt::format("Settings fans to target hold of {}", *holdMax));
+            if (_manager)
+            {
+                _manager->queueTelemetry();
+            }
         }
 
-        _target = itHoldMax->second;
+        _target = *holdMax;
         for (auto& fan : _fans)
         {
             fan->setTarget(_target);
@@ -256,10 +264,8 @@ void Zone::setTargetHold(const std::string& ident, uint64_t target, bool hold)
     }
 }
 
-void Zone::setFloorHold(const std::string& ident, uint64_t target, bool hold)
+void Zone::setFloorHold(HoldId ident, uint64_t target, bool hold)
 {
-    using namespace std::string_literals;
-
     if (target > _ceiling)
     {
         target = _ceiling;
@@ -267,42 +273,37 @@ void Zone::setFloorHold(const std::string& ident, uint64_t target, bool hold)
 
     if (!hold)
     {
-        size_t removed = _floorHolds.erase(ident);
-        if (removed)
+        if (_floorHolds.erase(ident))
         {
             FlightRecorder::instance().log(
-                "zone-floor"s + getName(),
-                fmt::format("{} is removing floor hold", ident));
+                _floorRecorderId,
+                fmt::format("{} is removing floor hold", HoldIds::name(ident)));
         }
     }
     else
     {
-        if (!((_floorHolds.find(ident) != _floorHolds.end()) &&
-              (_floorHolds[ident] == target)))
+        auto result = _floorHolds.set(ident, target);
+        if (result != HoldArbiter::SetResult::unchanged)
         {
             FlightRecorder::instance().log(
-                "zone-floor"s + getName(),
-                fmt::format("{} is setting floor hold to {}", ident, target));
+                _floorRecorderId,
+                fmt::format("{} is setting floor hold to {}",
+                            HoldIds::name(ident), target));
         }
-        _floorHolds[ident] = target;
     }
 
-    if (!std::all_of(_floorChange.begin(), _floorChange.end(),
-                     [](const auto& entry) { return entry.second; }))
+    if (_floorChangeDenied != 0)
     {
         return;
     }
 
-    auto itHoldMax = std::max_element(_floorHolds.begin(), _floorHolds.end(),
-                                      [](const auto& aHold, const auto& bHold) {
-                                          return aHold.second < bHold.second;
-                                      });
-    if (itHoldMax == _floorHolds.end())
+    auto holdMax = _floorHolds.max();
+    if (!holdMax)
     {
         if (_floor != _defaultFloor)
         {
             FlightRecorder::instance().log(
-                "zone-floor"s + getName(),
+                _floorRecorderId,
                 fmt::format("No set floor exists, using default floor",
                             _defaultFloor));
         }
@@ -310,13 +311,13 @@ void Zone::setFloorHold(const std::string& ident, uint64_t target, bool hold)
     }
     else
     {
-        if (_floor != itHoldMax->second)
+        if (_floor != *holdMax)
         {
             FlightRecorder::instance().log(
-                "zone-floor"s + getName(),
-                fmt::format("Setting new floor to {}", itHoldMax->second));
+                _floorRecorderId,
+                fmt::format("Setting new floor to {}", *holdMax));
         }
-        _floor = itHoldMax->second;
+        _floor = *holdMax;
     }
 
     // Floor above target, update target to floor
@@ -329,8 +330,7 @@ void Zone::setFloorHold(const std::string& ident, uint64_t target, bool hold)
 void Zone::setFloor(uint64_t target)
 {
     // Check all entries are set to allow floor to be set
-    auto pred = [](const auto& entry) { return entry.second; };
-    if (std::all_of(_floorChange.begin(), _floorChange.end(), pred))
+    if (_floorChangeDenied == 0)
     {
         _floor = (target > _ceiling) ? _ceiling : target;
         // Floor above target, update target to floor
@@ -380,8 +380,7 @@ void Zone::requestDecrease(uint64_t targetDelta)
 void Zone::decTimerExpired()
 {
     // Check all entries are set to allow a decrease
-    auto pred = [](auto const& entry) { return entry.second; };
-    auto decAllowed = std::all_of(_decAllowed.begin(), _decAllowed.end(), pred);
+    auto decAllowed = (_decDenied == 0);
 
     // Only decrease targets when allowed, a requested decrease target delta
     // exists, where no requested increases exist and the increase timer is not
@@ -532,12 +531,44 @@ json Zone::dump() const
     output["floor_change"] = _floorChange;
     output["decrease_allowed"] = _decAllowed;
     output["persisted_props"] = _propsPersisted;
-    output["target_holds"] = _targetHolds;
-    output["floor_holds"] = _floorHolds;
+    output["target_holds"] = _targetHolds.getHolds();
+    output["floor_holds"] = _floorHolds.getHolds();
 
     return output;
 }
 
+ZoneState Zone::getState() const
+{
+    return {_target, _floor};
+}
+
+void Zone::restoreState(const ZoneState& state)
+{
+    const auto& [target, floor] = state;
+
+    setTarget(target);
+    setFloor(floor);
+}
+
+void Zone::setAllow(std::map<std::string, bool>& allows, size_t& denied,
+                    const std::string& ident, bool isAllow)
+{
+    // A new identifier starts out allowing the change
+    auto itAllow = allows.try_emplace(ident, true).first;
+    if (itAllow->second != isAllow)
+    {
+        itAllow->second = isAllow;
+        if (isAllow)
+        {
+            denied--;
+        }
+        else
+        {
+            denied++;
+        }
+    }
+}
+
 /**
  * Properties of interfaces supported by the zone configuration that return
  * a handler function that sets the zone's property value(s) and persist
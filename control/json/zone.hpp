@@ -18,6 +18,8 @@
 #include "config_base.hpp"
 #include "dbus_zone.hpp"
 #include "fan.hpp"
+#include "utils/hold_arbiter.hpp"
+#include "utils/timer_wheel.hpp"
 
 #include <nlohmann/json.hpp>
 #include <sdeventplus/event.hpp>
@@ -40,6 +42,17 @@ using json = nlohmann::json;
 /* Dbus event timer */
 using Timer = sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>;
 
+/**
+ * State of a zone kept across restarts
+ * Tuple constructed of:
+ *      uint64_t = Target
+ *      uint64_t = Floor
+ *
+ * The holds aren't kept, since the actions that set them are recreated on
+ * every load and set them again when they run.
+ */
+using ZoneState = std::tuple<uint64_t, uint64_t>;
+
 /**
  * @class Zone - Represents a configured fan control zone
  *
@@ -179,6 +192,56 @@ class Zone : public ConfigBase
         return _decDelta;
     };
 
+    /**
+     * @brief Get the zone's current ceiling
+     *
+     * @return - The ceiling target of the zone
+     */
+    inline const auto& getCeiling() const
+    {
+        return _ceiling;
+    }
+
+    /**
+     * @brief Get whether automatic fan control is active on the zone
+     *
+     * @return - Whether the zone's target is not being held
+     */
+    inline auto isActive() const
+    {
+        return _isActive;
+    }
+
+    /**
+     * @brief Get the zone's target holds
+     *
+     * @return - The target holds on the zone
+     */
+    inline const auto& getTargetHolds() const
+    {
+        return _targetHolds;
+    }
+
+    /**
+     * @brief Get the zone's floor holds
+     *
+     * @return - The floor holds on the zone
+     */
+    inline const auto& getFloorHolds() const
+    {
+        return _floorHolds;
+    }
+
+    /**
+     * @brief Get the fans of the zone
+     *
+     * @return - List of the fans in the zone
+     */
+    inline const auto& getFans() const
+    {
+        return _fans;
+    }
+
     /**
      * @brief Get the manager of the zone
      *
@@ -241,7 +304,7 @@ class Zone : public ConfigBase
      * @param[in] target - Target to hold fans at
      * @param[in] hold - Whether to hold(true) or release(false) a target hold
      */
-    void setTargetHold(const std::string& ident, uint64_t target, bool hold);
+    void setTargetHold(HoldId ident, uint64_t target, bool hold);
 
     /**
      * @brief Set the floor to the given target and increase target to the floor
@@ -261,7 +324,7 @@ class Zone : public ConfigBase
      * @param[in] target - Floor value
      * @param[in] hold - Whether to hold(true) or release(false) a hold
      */
-    void setFloorHold(const std::string& ident, uint64_t target, bool hold);
+    void setFloorHold(HoldId ident, uint64_t target, bool hold);
 
     /**
      * @brief Set the default floor to the given value
@@ -281,7 +344,7 @@ class Zone : public ConfigBase
      */
     inline void setFloorChangeAllow(const std::string& ident, bool isAllow)
     {
-        _floorChange[ident] = isAllow;
+        setAllow(_floorChange, _floorChangeDenied, ident, isAllow);
     }
 
     /**
@@ -292,7 +355,7 @@ class Zone : public ConfigBase
      */
     inline void setDecreaseAllow(const std::string& ident, bool isAllow)
     {
-        _decAllowed[ident] = isAllow;
+        setAllow(_decAllowed, _decDenied, ident, isAllow);
     }
 
     /**
@@ -412,7 +475,33 @@ class Zone : public ConfigBase
      */
     json dump() const;
 
+    /**
+     * @brief Get the zone's state to be kept across restarts
+     *
+     * @return The zone's target and floor
+     */
+    ZoneState getState() const;
+
+    /**
+     * @brief Seed the zone with a state kept across a restart
+     *
+     * @param[in] state - The zone's target and floor
+     */
+    void restoreState(const ZoneState& state);
+
   private:
+    /**
+     * @brief Set an identifier's allow state, keeping count of the
+     * identifiers not allowing
+     *
+     * @param[in] allows - Map of identifiers to their allow state
+     * @param[in] denied - Number of identifiers in the map not allowing
+     * @param[in] ident - The identifier
+     * @param[in] isAllow - Allow state according to the identifier
+     */
+    static void setAllow(std::map<std::string, bool>& allows, size_t& denied,
+                         const std::string& ident, bool isAllow);
+
     /* The zone's associated dbus object */
     std::unique_ptr<DBusZone> _dbusZone;
 
@@ -465,16 +554,26 @@ class Zone : public ConfigBase
     bool _isActive;
 
     /* The target increase timer object */
-    Timer _incTimer;
+    WheelTimer _incTimer;
 
     /* The target decrease timer object */
-    Timer _decTimer;
+    WheelTimer _decTimer;
+
+    /* Target holds by a string identifier */
+    HoldArbiter _targetHolds;
+
+    /* Floor holds by a string identifier */
+    HoldArbiter _floorHolds;
+
+    /* Number of identifiers in _floorChange not allowing floor changes */
+    size_t _floorChangeDenied;
 
-    /* Map of target holds by a string identifier */
-    std::unordered_map<std::string, uint64_t> _targetHolds;
+    /* Number of identifiers in _decAllowed not allowing decreases */
+    size_t _decDenied;
 
-    /* Map of floor holds by a string identifier */
-    std::unordered_map<std::string, uint64_t> _floorHolds;
+    /* Flight recorder IDs of the zone's target and floor messages */
+    const std::string _targetRecorderId;
+    const std::string _floorRecorderId;
 
     /* Interface to property mapping of their associated set property handler
      * function */
@@ -105,6 +105,13 @@ int main(int argc, char* argv[])
             std::bind(&json::Manager::sigUsr1Handler, &manager,
                       std::placeholders::_1, std::placeholders::_2));
 
+        // Enable SIGTERM handling to save a state snapshot before exiting
+        stdplus::signal::block(SIGTERM);
+        sdeventplus::source::Signal sigTerm(
+            event, SIGTERM,
+            std::bind(&json::Manager::sigtermHandler, &manager,
+                      std::placeholders::_1, std::placeholders::_2));
+
         phosphor::fan::util::SDBusPlus::getBus().request_name(CONTROL_BUSNAME);
 #else
         Manager manager(phosphor::fan::util::SDBusPlus::getBus(), event, mode);
@@ -0,0 +1,297 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <system_error>
+
+namespace phosphor::fan::control::telemetry
+{
+
+/* Shared memory file the fan control telemetry is published to */
+constexpr auto telemetryFile = "/run/phosphor-fan-control/telemetry";
+
+/* Identifies the layout of the telemetry region */
+constexpr uint32_t telemetryMagic = 0x46414E43; // "FANC"
+constexpr uint32_t telemetryVersion = 3;
+
+/* How often fan control publishes the telemetry */
+constexpr auto publishInterval = std::chrono::seconds(1);
+
+/* Age past which readers treat the telemetry as left by a dead writer */
+constexpr auto maxAge = 5 * publishInterval;
+
+/* Fixed layout limits */
+constexpr size_t maxNameLen = 64;
+constexpr size_t maxPathLen = 2 * maxNameLen;
+constexpr size_t maxZones = 16;
+constexpr size_t maxFans = 64;
+constexpr size_t maxFanSensors = 4;
+constexpr size_t maxActions = 256;
+
+/* Attempts a reader makes to get a consistent copy */
+constexpr size_t maxReadAttempts = 100000;
+
+struct ZoneEntry
+{
+    char name[maxNameLen];
+    uint64_t target;
+    uint64_t floor;
+    uint64_t ceiling;
+    /* Number of target holds and the highest held target */
+    uint32_t numTargetHolds;
+    uint64_t targetHold;
+    /* Number of floor holds and the highest held floor */
+    uint32_t numFloorHolds;
+    uint64_t floorHold;
+    /* Whether automatic fan control is active */
+    uint8_t active;
+};
+
+struct FanEntry
+{
+    char name[maxNameLen];
+    char zone[maxNameLen];
+    uint64_t target;
+    /* Number of target locks and the highest locked target */
+    uint32_t numLocks;
+    uint64_t lockedTarget;
+    /* Whether the target is a PWM duty cycle rather than an RPM */
+    uint8_t pwm;
+    /* Object paths of the sensors configured for the fan */
+    uint32_t numSensors;
+    char sensors[maxFanSensors][maxPathLen];
+};
+
+struct ActionEntry
+{
+    char name[2 * maxNameLen];
+    uint64_t runs;
+};
+
+/* Contents of the region written under the sequence lock */
+struct Payload
+{
+    /* CLOCK_MONOTONIC time of the last update in microseconds */
+    uint64_t updated;
+    uint32_t numZones;
+    uint32_t numFans;
+    uint32_t numActions;
+    ZoneEntry zones[maxZones];
+    FanEntry fans[maxFans];
+    ActionEntry actions[maxActions];
+};
+
+struct Region
+{
+    uint32_t magic;
+    uint32_t version;
+    /* Sequence count, odd while the payload is being written */
+    std::atomic<uint64_t> seq;
+    Payload payload;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Telemetry sequence count must be lock free");
+
+/**
+ * @brief Copy a name into a fixed size, null terminated field
+ *
+ * @param[out] dest - The name field
+ * @param[in] name - The name, truncated if too long
+ */
+template <size_t N>
+inline void setName(char (&dest)[N], const std::string& name)
+{
+    auto len = std::min(name.size(), N - 1);
+    std::memcpy(dest, name.data(), len);
+    dest[len] = '\0';
+}
+
+/**
+ * @class Writer
+ *
+ * Creates the telemetry region and publishes updates to it. Each update
+ * is written under a sequence lock so readers never block the writer.
+ */
+class Writer
+{
+  public:
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+    Writer(Writer&&) = delete;
+    Writer& operator=(Writer&&) = delete;
+
+    /**
+     * @brief Create and map the telemetry region
+     *
+     * @throws std::system_error when the region can't be created
+     */
+    Writer()
+    {
+        std::filesystem::path path{telemetryFile};
+        std::filesystem::create_directories(path.parent_path());
+
+        auto fd = open(telemetryFile, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(),
+                                    "Failed to open telemetry region");
+        }
+        if (ftruncate(fd, sizeof(Region)) < 0)
+        {
+            auto err = errno;
+            close(fd);
+            throw std::system_error(err, std::generic_category(),
+                                    "Failed to size telemetry region");
+        }
+        auto* addr = mmap(nullptr, sizeof(Region), PROT_READ | PROT_WRITE,
+                          MAP_SHARED, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED)
+        {
+            throw std::system_error(errno, std::generic_category(),
+                                    "Failed to map telemetry region");
+        }
+
+        _region = static_cast<Region*>(addr);
+        // Readers ignore the region until the header is valid
+        _region->magic = 0;
+        _region->version = telemetryVersion;
+        _region->seq.store(0, std::memory_order_relaxed);
+        std::memset(&_region->payload, 0, sizeof(Payload));
+        std::atomic_thread_fence(std::memory_order_release);
+        _region->magic = telemetryMagic;
+    }
+
+    ~Writer()
+    {
+        invalidate();
+        munmap(_region, sizeof(Region));
+    }
+
+    /**
+     * @brief Mark the region invalid and remove its file, so readers stop
+     * using it once fan control stops publishing
+     */
+    void invalidate()
+    {
+        _region->magic = 0;
+        std::atomic_thread_fence(std::memory_order_release);
+        unlink(telemetryFile);
+    }
+
+    /**
+     * @brief Publish an update of the payload
+     *
+     * @param[in] update - Function that fills in the payload
+     */
+    template <typename Func>
+    void publish(Func&& update)
+    {
+        auto seq = _region->seq.load(std::memory_order_relaxed);
+        _region->seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        update(_region->payload);
+
+        _region->seq.store(seq + 2, std::memory_order_release);
+    }
+
+  private:
+    /* The mapped telemetry region */
+    Region* _region;
+};
+
+/**
+ * @brief Read a consistent copy of the published telemetry
+ *
+ * @return The payload, or std::nullopt when fan control isn't publishing
+ *         a region of this version or hasn't updated it within maxAge
+ */
+inline std::optional<Payload> read()
+{
+    auto fd = open(telemetryFile, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return std::nullopt;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) < sizeof(Region))
+    {
+        close(fd);
+        return std::nullopt;
+    }
+    auto* addr = mmap(nullptr, sizeof(Region), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+    {
+        return std::nullopt;
+    }
+
+    const auto* region = static_cast<const Region*>(addr);
+    std::optional<Payload> payload;
+    if (region->magic == telemetryMagic &&
+        region->version == telemetryVersion)
+    {
+        // Retry until a copy is taken without the writer updating it, giving
+        // up if a writer died mid-update
+        Payload copy;
+        for (size_t attempt = 0; attempt < maxReadAttempts; attempt++)
+        {
+            auto seq = region->seq.load(std::memory_order_acquire);
+            if (seq & 1)
+            {
+                continue;
+            }
+            std::memcpy(&copy, &region->payload, sizeof(Payload));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (region->seq.load(std::memory_order_relaxed) == seq)
+            {
+                payload = copy;
+                break;
+            }
+        }
+    }
+    munmap(addr, sizeof(Region));
+
+    if (payload)
+    {
+        auto now = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch());
+        auto updated = std::chrono::microseconds(payload->updated);
+        if ((payload->updated == 0) || (now - updated > maxAge))
+        {
+            payload = std::nullopt;
+        }
+    }
+
+    return payload;
+}
+
+} // namespace phosphor::fan::control::telemetry
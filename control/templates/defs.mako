@@ -49,27 +49,10 @@ ${genParams(par=meth)}\
 </%def>\
 
 <%def name="genSSE(event)" buffered="True">
-Group
-{
-%for group in event['groups']:
-%for member in group['members']:
-    {"${member['object']}",
-    "${member['interface']}",
-    "${member['property']}"},
-%endfor
-%endfor
-},
+Group{GroupId{${group_id(event['groups'])}}},
 ActionData{
 %for e in event['action']:
-{Group{
-%for g in e['groups']:
-%for m in g['members']:
-    {"${m['object']}",
-    "${m['interface']}",
-    "${m['property']}"},
-%endfor
-%endfor
-},
+{Group{GroupId{${group_id(e['groups'])}}},
 std::vector<Action>{
 %for a in e['actions']:
 %if len(a['parameters']) != 0:
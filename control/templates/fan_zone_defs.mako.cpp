@@ -12,6 +12,12 @@ def indent(str, depth):
 #include "preconditions.hpp"
 #include "matches.hpp"
 #include "triggers.hpp"
+#include "zone.hpp"
+
+#include <array>
+#include <span>
+#include <string_view>
+#include <utility>
 
 using namespace phosphor::fan::control;
 
@@ -100,18 +106,9 @@ const std::vector<ZoneGroup> Manager::_zoneLayouts
                         (event['pc'] is not None):
                     SetSpeedEvent{
                         "${event['pc']['pcname']}",
-                        Group
-                        {
-                        %for group in event['pc']['pcgrps']:
-                        %for member in group['members']:
-                            {"${member['object']}",
-                            "${member['interface']}",
-                            "${member['property']}"},
-                        %endfor
-                        %endfor
-                        },
+                        Group{GroupId{${group_id(event['pc']['pcgrps'])}}},
                         ActionData{
-                        {Group{},
+                        {Group{GroupId{${group_id([])}}},
                         std::vector<Action>{
                         %for i, a in enumerate(event['pc']['pcact']):
                         make_action(
@@ -199,3 +196,43 @@ const std::vector<ZoneGroup> Manager::_zoneLayouts
     },
 %endfor
 };
+
+const size_t Zone::_numGroups{${len(group_ids)}};
+
+<%
+group_offsets = []
+num_members = 0
+for members in group_ids:
+    group_offsets.append((num_members, len(members)))
+    num_members += len(members)
+%>\
+namespace phosphor::fan::control
+{
+
+using namespace std::literals::string_view_literals;
+
+/* Every group's members, in group id order */
+constexpr std::array<GroupMemberDef, ${num_members}> groupMembers{{
+%for members in group_ids:
+%for member in members:
+    {"${member[0]}"sv, "${member[1]}"sv, "${member[2]}"sv},
+%endfor
+%endfor
+}};
+
+/* Each group's first member in groupMembers and its member count, by id */
+constexpr std::array<std::pair<size_t, size_t>, ${len(group_ids)}>
+    groupRanges{{
+%for first, count in group_offsets:
+        {${first}, ${count}},
+%endfor
+    }};
+
+std::span<const GroupMemberDef> getGroupMembers(GroupId id)
+{
+    const auto& [first, count] = groupRanges[static_cast<size_t>(id)];
+    return std::span<const GroupMemberDef>{groupMembers}.subspan(first,
+                                                                 count);
+}
+
+} // namespace phosphor::fan::control
@@ -0,0 +1,111 @@
+/* This is a generated file. */
+#include "compiled_config.hpp"
+
+#include <array>
+#include <string_view>
+#include <utility>
+
+namespace phosphor::fan::control::json::compiled
+{
+
+using namespace std::literals::string_view_literals;
+
+/* The configuration files' contents, by file name */
+constexpr std::array<std::pair<std::string_view, std::string_view>,
+                     ${len(configs)}>
+    configs{{
+%for name, text in configs:
+        {"${name}"sv,
+         R"${delimiter}(${text})${delimiter}"sv},
+%endfor
+    }};
+
+/* The groups' member paths */
+constexpr std::array<std::string_view, ${len(paths)}> paths{{
+%for path in paths:
+    ${path},
+%endfor
+}};
+
+%for g, group in enumerate(groups):
+constexpr std::array<std::string_view, ${len(group['profiles'])}> group${g}Profiles{{
+    %for profile in group['profiles']:
+    ${profile},
+    %endfor
+}};
+constexpr std::array<size_t, ${len(group['members'])}> group${g}Members{{
+    ${', '.join(str(member) for member in group['members'])}
+}};
+%endfor
+
+/* The groups */
+constexpr std::array<GroupDef, ${len(groups)}> groups{{
+%for g, group in enumerate(groups):
+    {${group['name']}, ${group['service']}, group${g}Profiles,
+     group${g}Members},
+%endfor
+}};
+
+%for t, table in enumerate(floor_tables):
+    %for f, fan_floors in enumerate(table):
+        %for fg, floor_group in enumerate(fan_floors['floor_groups']):
+constexpr std::array<FloorEntryDef, ${len(floor_group['floors'])}> floors${t}_${f}_${fg}{{
+            %for value, floor in floor_group['floors']:
+    {${value}, ${floor}},
+            %endfor
+}};
+        %endfor
+constexpr std::array<FloorGroupDef, ${len(fan_floors['floor_groups'])}> floors${t}_${f}{{
+        %for fg, floor_group in enumerate(fan_floors['floor_groups']):
+    {${floor_group['group']}, ${floor_group['parameter']}, floors${t}_${f}_${fg}},
+        %endfor
+}};
+    %endfor
+constexpr std::array<FanFloorsDef, ${len(table)}> floors${t}{{
+    %for f, fan_floors in enumerate(table):
+    {${fan_floors['key']}, ${fan_floors['offset_parameter']},
+     ${fan_floors['default_floor']}, floors${t}_${f}},
+    %endfor
+}};
+%endfor
+
+/* The mapped_floor actions' floor tables, by compiled_floors index */
+constexpr std::array<std::span<const FanFloorsDef>, ${len(floor_tables)}>
+    floorTables{{
+%for t in range(len(floor_tables)):
+        floors${t},
+%endfor
+    }};
+
+std::optional<std::string_view> getConfig(std::string_view fileName)
+{
+    for (const auto& [name, contents] : configs)
+    {
+        if (name == fileName)
+        {
+            return contents;
+        }
+    }
+    return std::nullopt;
+}
+
+std::span<const std::string_view> getPaths()
+{
+    return paths;
+}
+
+std::span<const GroupDef> getGroups()
+{
+    return groups;
+}
+
+std::optional<std::span<const FanFloorsDef>> getFloorTable(size_t index)
+{
+    if (index >= floorTables.size())
+    {
+        return std::nullopt;
+    }
+    return floorTables[index];
+}
+
+} // namespace phosphor::fan::control::json::compiled
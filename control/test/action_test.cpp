@@ -0,0 +1,466 @@
+#include "config.h"
+
+#include "../json/actions/action.hpp"
+#include "../json/fan.hpp"
+#include "../json/group.hpp"
+#include "../json/manager.hpp"
+#include "../json/zone.hpp"
+#include "mock_bus_interface.hpp"
+#include "sdeventplus.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <limits>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::fan::control::json;
+using namespace phosphor::fan;
+using json = nlohmann::json;
+
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+constexpr auto memberIntf = "xyz.openbmc_project.Test";
+constexpr auto memberProp = "Value";
+
+class ActionTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        auto bus = std::make_unique<NiceMock<MockBusInterface>>();
+        ON_CALL(*bus, getService(_, _)).WillByDefault(Return("test.service"));
+        ON_CALL(*bus, getTarget(_, _, _)).WillByDefault(Return(0));
+        mockBus = bus.get();
+        BusInterfaceBase::setInstance(std::move(bus));
+
+        zone = std::make_unique<Zone>(
+            json{{"name", zoneName}, {"poweron_target", 10000}},
+            util::SDEventPlus::getEvent(), nullptr);
+        for (size_t i = 0; i < 2; i++)
+        {
+            auto fanName = "fan" + std::to_string(i);
+            zone->addFan(std::make_unique<Fan>(
+                json{{"name", fanName},
+                     {"zone", zoneName},
+                     {"sensors", {fanName}},
+                     {"target_interface", "xyz.openbmc_project.Control"}}));
+        }
+    }
+
+    void TearDown() override
+    {
+        zone.reset();
+        BusInterfaceBase::setInstance(nullptr);
+    }
+
+    /**
+     * @brief Make a group of members unique to the test
+     */
+    std::vector<Group> makeGroups(size_t numMembers)
+    {
+        auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        members.clear();
+        for (size_t i = 0; i < numMembers; i++)
+        {
+            members.push_back(
+                fmt::format("/test/{}/member{}", info->name(), i));
+        }
+
+        Group group{json{{"name", "group"}, {"members", members}}};
+        group.setInterface(memberIntf);
+        group.setProperty(memberProp);
+        return {group};
+    }
+
+    void setMember(size_t index, PropertyVariantType value)
+    {
+        Manager::setProperty(members[index], memberIntf, memberProp,
+                             std::move(value));
+    }
+
+    std::unique_ptr<ActionBase> makeAction(const std::string& name,
+                                           json config,
+                                           const std::vector<Group>& groups)
+    {
+        config["name"] = name;
+        return ActionFactory::getAction(name, config, groups, {*zone});
+    }
+
+    static constexpr auto zoneName = "0";
+    NiceMock<MockBusInterface>* mockBus = nullptr;
+    std::unique_ptr<Zone> zone;
+    std::vector<std::string> members;
+};
+
+TEST_F(ActionTest, CountStateTarget)
+{
+    auto action = makeAction("count_state_before_target",
+                             {{"count", 2}, {"state", true}, {"target", 9000}},
+                             makeGroups(4));
+    zone->setTarget(5000);
+
+    setMember(0, true);
+    setMember(1, false);
+    action->run();
+    EXPECT_EQ(zone->getTarget(), 5000);
+
+    // Reaching the count holds the target
+    setMember(2, true);
+    action->run();
+    EXPECT_EQ(zone->getTarget(), 9000);
+    for (const auto& fan : zone->getFans())
+    {
+        EXPECT_EQ(fan->getTarget(), 9000);
+    }
+
+    zone->setTarget(4000);
+    EXPECT_EQ(zone->getTarget(), 9000);
+
+    // Dropping below the count releases it
+    setMember(0, false);
+    action->run();
+    zone->setTarget(4000);
+    EXPECT_EQ(zone->getTarget(), 4000);
+}
+
+TEST_F(ActionTest, CountStateFloor)
+{
+    auto action = makeAction(
+        "count_state_floor",
+        {{"count", 1}, {"state", "Fault"}, {"floor", 8000}}, makeGroups(3));
+
+    setMember(0, std::string{"OK"});
+    action->run(*zone);
+    EXPECT_EQ(zone->getTarget(), 0);
+
+    // The floor raises the target
+    setMember(1, std::string{"Fault"});
+    action->run(*zone);
+    EXPECT_EQ(zone->getTarget(), 8000);
+}
+
+TEST_F(ActionTest, NetTargetIncrease)
+{
+    auto action = makeAction("set_net_increase_target",
+                             {{"state", 50.0}, {"delta", 100}}, makeGroups(3));
+    zone->setTarget(1000);
+
+    // Nothing at or above the state
+    setMember(0, 40.0);
+    setMember(1, 45.0);
+    action->run();
+    EXPECT_EQ(zone->getTarget(), 1000);
+
+    // The largest increase requested wins
+    setMember(1, 52.0);
+    setMember(2, 55.0);
+    action->run();
+    EXPECT_EQ(zone->getIncDelta(), 500);
+    EXPECT_EQ(zone->getTarget(), 1500);
+}
+
+TEST_F(ActionTest, NetTargetDecrease)
+{
+    auto action = makeAction("set_net_decrease_target",
+                             {{"state", 50.0}, {"delta", 10}}, makeGroups(3));
+
+    // The smallest decrease requested wins
+    setMember(0, 40.0);
+    setMember(1, 45.0);
+    action->run(*zone);
+    EXPECT_EQ(zone->getDecDelta(), 50);
+
+    // Any member at or above the state prevents a decrease
+    setMember(2, 60.0);
+    action->run(*zone);
+    EXPECT_EQ(zone->getDecDelta(), 0);
+}
+
+TEST_F(ActionTest, NetTargetDecreaseWithinStep)
+{
+    auto action = makeAction("set_net_decrease_target",
+                             {{"state", 50.0}, {"delta", 10}}, makeGroups(2));
+
+    // Members less than a whole step below the state request no
+    // decrease, which the members after them then replace
+    setMember(0, 49.5);
+    setMember(1, 45.0);
+    action->run(*zone);
+    EXPECT_EQ(zone->getDecDelta(), 50);
+
+    zone->decTimerExpired();
+    setMember(0, 45.0);
+    setMember(1, 49.5);
+    action->run(*zone);
+    EXPECT_EQ(zone->getDecDelta(), 0);
+}
+
+TEST_F(ActionTest, CountStateMixedTypes)
+{
+    auto action = makeAction("count_state_floor",
+                             {{"count", 2}, {"state", 1.0}, {"floor", 8000}},
+                             makeGroups(3));
+
+    // An int never equals a double state
+    setMember(0, 1.0);
+    setMember(1, int64_t{1});
+    action->run(*zone);
+    EXPECT_EQ(zone->getTarget(), 0);
+
+    setMember(2, 1.0);
+    action->run(*zone);
+    EXPECT_EQ(zone->getTarget(), 8000);
+}
+
+TEST_F(ActionTest, MissingMembers)
+{
+    // Members not in the cache are skipped
+    auto action = makeAction("count_state_before_target",
+                             {{"count", 1}, {"state", true}, {"target", 9000}},
+                             makeGroups(2));
+    zone->setTarget(5000);
+    action->run(*zone);
+    EXPECT_EQ(zone->getTarget(), 5000);
+}
+
+TEST_F(ActionTest, GroupMaxNumeric)
+{
+    auto action = makeAction("set_parameter_from_group_max",
+                             {{"parameter_name", "group_max"}}, makeGroups(3));
+
+    setMember(0, 30.5);
+    setMember(1, 42.0);
+    action->run(*zone);
+    auto max = Manager::getParameter("group_max");
+    ASSERT_TRUE(max);
+    EXPECT_EQ(std::get<double>(*max), 42.0);
+
+    // NaNs drop the member's value
+    setMember(1, std::numeric_limits<double>::quiet_NaN());
+    action->run(*zone);
+    max = Manager::getParameter("group_max");
+    ASSERT_TRUE(max);
+    EXPECT_EQ(std::get<double>(*max), 30.5);
+
+    // Members of other types are compared as variants
+    setMember(0, int64_t{20});
+    setMember(2, int64_t{100});
+    action->run(*zone);
+    max = Manager::getParameter("group_max");
+    ASSERT_TRUE(max);
+    EXPECT_EQ(std::get<int64_t>(*max), 100);
+}
+
+TEST_F(ActionTest, CountStateTargetIncremental)
+{
+    auto action = makeAction("count_state_before_target",
+                             {{"count", 2}, {"state", true}, {"target", 9000}},
+                             makeGroups(4));
+    zone->setTarget(5000);
+
+    // The first run checks every member
+    setMember(0, true);
+    setMember(1, false);
+    action->run();
+    EXPECT_EQ(zone->getTarget(), 5000);
+
+    // Later runs only check the members that changed
+    setMember(2, true);
+    action->run();
+    EXPECT_EQ(zone->getTarget(), 9000);
+
+    // A member changing back and forth is counted once
+    setMember(1, true);
+    setMember(1, false);
+    setMember(0, false);
+    action->run();
+    zone->setTarget(4000);
+    EXPECT_EQ(zone->getTarget(), 4000);
+
+    setMember(3, true);
+    action->run();
+    EXPECT_EQ(zone->getTarget(), 9000);
+}
+
+TEST_F(ActionTest, NetTargetIncreaseIncremental)
+{
+    auto action = makeAction("set_net_increase_target",
+                             {{"state", 50.0}, {"delta", 100}}, makeGroups(3));
+    zone->setTarget(1000);
+
+    setMember(0, 40.0);
+    setMember(1, 52.0);
+    action->run();
+    EXPECT_EQ(zone->getIncDelta(), 200);
+
+    setMember(2, 55.0);
+    action->run();
+    EXPECT_EQ(zone->getIncDelta(), 500);
+
+    // Dropping the largest increase leaves the next largest
+    zone->incTimerExpired();
+    setMember(2, 40.0);
+    action->run();
+    EXPECT_EQ(zone->getIncDelta(), 200);
+
+    zone->incTimerExpired();
+    setMember(1, std::numeric_limits<double>::quiet_NaN());
+    action->run();
+    EXPECT_EQ(zone->getIncDelta(), 0);
+}
+
+TEST_F(ActionTest, CountStateTargetAllChanged)
+{
+    auto action = makeAction("count_state_before_target",
+                             {{"count", 2}, {"state", 1.0}, {"target", 9000}},
+                             makeGroups(3));
+    zone->setTarget(5000);
+    action->run();
+
+    // Every member changing recounts them all from the numeric column
+    setMember(0, 1.0);
+    setMember(1, 0.0);
+    setMember(2, 1.0);
+    action->run();
+    EXPECT_EQ(zone->getTarget(), 9000);
+
+    // leaving each member's state for the changes after
+    setMember(2, 0.0);
+    action->run();
+    zone->setTarget(4000);
+    EXPECT_EQ(zone->getTarget(), 4000);
+
+    setMember(1, 1.0);
+    action->run();
+    EXPECT_EQ(zone->getTarget(), 9000);
+}
+
+TEST_F(ActionTest, NetTargetIncreaseAllChanged)
+{
+    auto action = makeAction("set_net_increase_target",
+                             {{"state", 50.0}, {"delta", 100}}, makeGroups(3));
+    zone->setTarget(1000);
+    action->run();
+
+    // Every member changing rechecks them all from the numeric column
+    setMember(0, 51.0);
+    setMember(1, 53.0);
+    setMember(2, 52.0);
+    action->run();
+    EXPECT_EQ(zone->getIncDelta(), 300);
+
+    // leaving each member's increase for the changes after
+    zone->incTimerExpired();
+    setMember(1, 40.0);
+    action->run();
+    EXPECT_EQ(zone->getIncDelta(), 200);
+}
+
+TEST_F(ActionTest, MappedFloorIncremental)
+{
+    auto action = makeAction(
+        "mapped_floor",
+        {{"key_group", "group"},
+         {"default_floor", 2000},
+         {"fan_floors",
+          {{{"key", 30},
+            {"floors",
+             {{{"group", "group"},
+               {"floors", {{{"value", 25}, {"floor", 4000}}}}}}}},
+           {{"key", 50},
+            {"floors",
+             {{{"group", "group"},
+               {"floors", {{{"value", 45}, {"floor", 6000}}}}}}}}}}},
+        makeGroups(3));
+
+    setMember(0, 20.0);
+    setMember(1, 10.0);
+    action->run();
+    EXPECT_EQ(zone->getTarget(), 4000);
+
+    // The group maximum follows the changed member
+    setMember(1, 40.0);
+    action->run();
+    EXPECT_EQ(zone->getTarget(), 6000);
+}
+
+TEST_F(ActionTest, MissingOwnerTarget)
+{
+    auto action = makeAction("set_target_on_missing_owner",
+                             {{"target", 9000}}, makeGroups(2));
+    zone->setTarget(5000);
+
+    // Members not in the service tree have no owner
+    action->run();
+    EXPECT_EQ(zone->getTarget(), 9000);
+
+    // Finding an owner for one member still leaves the other missing
+    SubTree subTree{{members[0], {{"test.service", {memberIntf}}}}};
+    ON_CALL(*mockBus, getSubTree(_, memberIntf, _))
+        .WillByDefault(Return(subTree));
+    Manager::addServices(memberIntf, 0);
+    action->run();
+    zone->setTarget(4000);
+    EXPECT_EQ(zone->getTarget(), 9000);
+
+    subTree.emplace(members[1],
+                    std::map<std::string, std::vector<std::string>>{
+                        {"test.service", {memberIntf}}});
+    ON_CALL(*mockBus, getSubTree(_, memberIntf, _))
+        .WillByDefault(Return(subTree));
+    Manager::addServices(memberIntf, 0);
+    action->run();
+    zone->setTarget(4000);
+    EXPECT_EQ(zone->getTarget(), 4000);
+}
+
+TEST_F(ActionTest, HoldIdInternedOnce)
+{
+    HoldIds::clear();
+    auto action = makeAction("count_state_before_target",
+                             {{"count", 1}, {"state", true}, {"target", 9000}},
+                             makeGroups(2));
+    action->setEventName("event");
+    EXPECT_EQ(HoldIds::size(), 0);
+
+    // The hold name is interned once, with the event name, on first use
+    setMember(0, true);
+    action->run();
+    action->run();
+    ASSERT_EQ(HoldIds::size(), 1);
+    EXPECT_EQ(HoldIds::name(0), action->getUniqueName());
+    EXPECT_NE(action->getUniqueName().find("(event)"), std::string::npos);
+
+    // A group's hold of the same name is kept apart from the action's
+    EXPECT_EQ(HoldIds::intern(HoldScope::group, action->getUniqueName()), 1);
+    EXPECT_EQ(HoldIds::intern(HoldScope::action, action->getUniqueName()), 0);
+
+    // Reloading releases the identifiers for reuse
+    HoldIds::clear();
+    EXPECT_EQ(HoldIds::size(), 0);
+    EXPECT_EQ(HoldIds::intern(HoldScope::group, "group"), 0);
+}
+
+TEST_F(ActionTest, NestedSetParameters)
+{
+    json setParam{{"name", "set_parameter_from_group_max"},
+                  {"parameter_name", "nested_param"}};
+    json timerConf{{"timer", {{"interval", 1000000}, {"type", "oneshot"}}},
+                   {"actions", json::array({setParam, setParam})}};
+
+    // Running an action that runs others ends up setting their parameters
+    auto timer =
+        makeAction("call_actions_based_on_timer", timerConf, makeGroups(2));
+    EXPECT_EQ(timer->getSetParameters(),
+              std::vector<std::string>{"nested_param"});
+
+    timerConf["name"] = "call_actions_based_on_timer";
+    auto objects = makeAction("get_managed_objects",
+                              {{"actions", json::array({timerConf})}},
+                              makeGroups(2));
+    EXPECT_EQ(objects->getSetParameters(),
+              std::vector<std::string>{"nested_param"});
+}
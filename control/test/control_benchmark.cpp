@@ -0,0 +1,662 @@
+#include "config.h"
+
+#include "../json/actions/action.hpp"
+#include "../json/fan.hpp"
+#include "../json/group.hpp"
+#include "../json/manager.hpp"
+#include "../json/triggers/handlers.hpp"
+#include "../json/utils/group_reduction.hpp"
+#include "../json/utils/numeric_column.hpp"
+#include "../json/zone.hpp"
+#include "sdbusplus.hpp"
+#include "sdeventplus.hpp"
+
+#include <fmt/format.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+using namespace phosphor::fan::control::json;
+using namespace phosphor::fan;
+using json = nlohmann::json;
+
+constexpr auto memberIntf = "xyz.openbmc_project.Test";
+constexpr auto memberProp = "Value";
+constexpr auto memberService = "xyz.openbmc_project.Test.Service";
+constexpr auto objMgrIntf = "org.freedesktop.DBus.ObjectManager";
+constexpr auto objMgrPath = "/bench";
+
+/* Most a benchmark's time per member may grow from its smallest to its
+ * largest configuration in --check mode, well above linear scaling's 1
+ * and below the 10 of quadratic scaling over the member counts used */
+constexpr double maxPerItemGrowth = 5.0;
+
+/**
+ * @class FakeBusInterface
+ *
+ * Answers the bus calls without any D-Bus traffic, so the
+ * benchmarks only measure fan control itself.
+ */
+class FakeBusInterface : public BusInterfaceBase
+{
+  public:
+    std::string getService(const std::string&, const std::string&) override
+    {
+        return memberService;
+    }
+
+    SubTree getSubTree(const std::string&, const std::string& intf,
+                       int32_t) override
+    {
+        SubTree tree;
+        if (intf == objMgrIntf)
+        {
+            tree[objMgrPath][memberService] = {intf};
+            return tree;
+        }
+        for (const auto& path : paths)
+        {
+            tree[path][memberService] = {intf};
+        }
+        return tree;
+    }
+
+    std::vector<std::string> listNames() override
+    {
+        return {memberService};
+    }
+
+    PropertyVariantType getProperty(const std::string&, const std::string&,
+                                    const std::string&,
+                                    const std::string&) override
+    {
+        return 0.0;
+    }
+
+    ManagedObjects getManagedObjects(const std::string&,
+                                     const std::string&) override
+    {
+        return objects;
+    }
+
+    uint64_t getTarget(const std::string&, const std::string&,
+                       const std::string&) override
+    {
+        return 0;
+    }
+
+    void setTarget(const std::string&, const std::string&, const std::string&,
+                   uint64_t) override
+    {}
+
+    void publishTarget(const std::string&, const std::string&,
+                       const std::string&, uint64_t) override
+    {}
+
+    /* The paths returned from getSubTree */
+    std::vector<std::string> paths;
+
+    /* The objects returned from getManagedObjects */
+    ManagedObjects objects;
+};
+
+/**
+ * @brief Get the manager for the benchmarks that need one
+ *
+ * @return The manager, or nullptr when there's no D-Bus connection to
+ *         create it with
+ */
+static Manager* getManager()
+{
+    static auto manager = []() -> std::unique_ptr<Manager> {
+        try
+        {
+            return std::make_unique<Manager>(util::SDEventPlus::getEvent());
+        }
+        catch (const std::exception&)
+        {
+            return nullptr;
+        }
+    }();
+    return manager.get();
+}
+
+/**
+ * @brief The zone and group members an action benchmark runs against
+ */
+struct Fixture
+{
+    explicit Fixture(size_t numMembers, Manager* manager = nullptr)
+    {
+        auto bus = std::make_unique<FakeBusInterface>();
+        auto& fakeBus = *bus;
+        BusInterfaceBase::setInstance(std::move(bus));
+
+        zone = std::make_unique<Zone>(
+            json{{"name", "0"}, {"poweron_target", 10000}},
+            util::SDEventPlus::getEvent(), manager);
+        for (size_t i = 0; i < 4; i++)
+        {
+            auto fanName = "fan" + std::to_string(i);
+            zone->addFan(std::make_unique<Fan>(
+                json{{"name", fanName},
+                     {"zone", "0"},
+                     {"sensors", {fanName}},
+                     {"target_interface", "xyz.openbmc_project.Control"}}));
+        }
+
+        // All members below the states the actions look for,
+        // so that every member has to be checked
+        for (size_t i = 0; i < numMembers; i++)
+        {
+            members.push_back(fmt::format("/bench/member{}", i));
+            change(i, 0);
+            fakeBus.objects[members.back()][memberIntf][memberProp] =
+                value(i, 0);
+        }
+        fakeBus.paths = members;
+        Manager::addServices(memberIntf, 0);
+
+        groups.emplace_back(json{{"name", "bench"}, {"members", members}});
+        groups.back().setInterface(memberIntf);
+        groups.back().setProperty(memberProp);
+    }
+
+    ~Fixture()
+    {
+        zone.reset();
+        BusInterfaceBase::setInstance(nullptr);
+    }
+
+    std::unique_ptr<ActionBase> makeAction(const std::string& name,
+                                           json config)
+    {
+        config["name"] = name;
+        return ActionFactory::getAction(name, config, groups, {*zone});
+    }
+
+    /**
+     * @brief Change a member's cached value, as a signal would, keeping
+     *        it below the actions' states
+     *
+     * @param[in] index - The member's index
+     * @param[in] generation - Alternates the value between odd and even
+     *                         generations
+     */
+    void change(size_t index, size_t generation)
+    {
+        Manager::setProperty(members[index], memberIntf, memberProp,
+                             value(index, generation));
+    }
+
+    /**
+     * @brief Get the value a member is changed to
+     *
+     * @param[in] index - The member's index
+     * @param[in] generation - The generation of the change
+     *
+     * @return The member's value
+     */
+    static double value(size_t index, size_t generation)
+    {
+        return static_cast<double>(index % 50) + (generation % 2) * 0.5;
+    }
+
+    std::unique_ptr<Zone> zone;
+    std::vector<std::string> members;
+    std::vector<Group> groups;
+};
+
+/**
+ * @brief Run an action as its triggers do, after one member changed,
+ *        so actions that track their members' changes run from them
+ */
+static void runAction(benchmark::State& state, const std::string& name,
+                      const json& config)
+{
+    auto numMembers = static_cast<size_t>(state.range(0));
+    Fixture fixture{numMembers};
+    auto action = fixture.makeAction(name, config);
+    action->run();
+
+    size_t generation = 0;
+    for (auto _ : state)
+    {
+        fixture.change(generation % numMembers, generation / numMembers + 1);
+        action->run();
+        generation++;
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * @brief Run an action as its triggers do, after every member changed
+ */
+static void runActionAllChanged(benchmark::State& state,
+                                const std::string& name, const json& config)
+{
+    auto numMembers = static_cast<size_t>(state.range(0));
+    Fixture fixture{numMembers};
+    auto action = fixture.makeAction(name, config);
+    action->run();
+
+    size_t generation = 0;
+    for (auto _ : state)
+    {
+        generation++;
+        for (size_t i = 0; i < numMembers; i++)
+        {
+            fixture.change(i, generation);
+        }
+        action->run();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ZoneSetTarget(benchmark::State& state)
+{
+    Fixture fixture{0};
+    uint64_t target = 0;
+
+    for (auto _ : state)
+    {
+        fixture.zone->setTarget(target);
+        target = (target + 100) % 10000;
+    }
+}
+BENCHMARK(BM_ZoneSetTarget);
+
+BENCHMARK_CAPTURE(runAction, count_state_before_target,
+                  "count_state_before_target",
+                  json{{"count", 1}, {"state", 100.0}, {"target", 9000}})
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(1000);
+
+BENCHMARK_CAPTURE(runActionAllChanged, count_state_before_target,
+                  "count_state_before_target",
+                  json{{"count", 1}, {"state", 100.0}, {"target", 9000}})
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(1000);
+
+BENCHMARK_CAPTURE(runAction, count_state_floor, "count_state_floor",
+                  json{{"count", 1}, {"state", 100.0}, {"floor", 9000}})
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(1000);
+
+BENCHMARK_CAPTURE(runAction, set_net_increase_target,
+                  "set_net_increase_target",
+                  json{{"state", 100.0}, {"delta", 100}})
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(1000);
+
+BENCHMARK_CAPTURE(runActionAllChanged, set_net_increase_target,
+                  "set_net_increase_target",
+                  json{{"state", 100.0}, {"delta", 100}})
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(1000);
+
+BENCHMARK_CAPTURE(runAction, set_net_decrease_target,
+                  "set_net_decrease_target",
+                  json{{"state", 100.0}, {"delta", 100}})
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(1000);
+
+BENCHMARK_CAPTURE(runAction, set_parameter_from_group_max,
+                  "set_parameter_from_group_max",
+                  json{{"parameter_name", "bench_max"}})
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(1000);
+
+BENCHMARK_CAPTURE(runAction, override_fan_target, "override_fan_target",
+                  json{{"count", 1},
+                       {"state", 100.0},
+                       {"target", 9000},
+                       {"fans", {"fan0", "fan1"}}})
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(1000);
+
+BENCHMARK_CAPTURE(runAction, set_target_on_missing_owner,
+                  "set_target_on_missing_owner", json{{"target", 9000}})
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(1000);
+
+BENCHMARK_CAPTURE(runAction, default_floor_on_missing_owner,
+                  "default_floor_on_missing_owner", json::object())
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(1000);
+
+BENCHMARK_CAPTURE(runAction, set_request_target_base_with_max,
+                  "set_request_target_base_with_max", json::object())
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(1000);
+
+const json mappedFloorConfig = {
+    {"key_group", "bench"},
+    {"default_floor", 2000},
+    {"fan_floors",
+     {{{"key", 30},
+       {"floors",
+        {{{"group", "bench"},
+          {"floors", {{{"value", 25}, {"floor", 4000}}}}}}}},
+      {{"key", 60},
+       {"floors",
+        {{{"group", "bench"},
+          {"floors", {{{"value", 45}, {"floor", 6000}}}}}}}}}}};
+
+BENCHMARK_CAPTURE(runAction, mapped_floor, "mapped_floor", mappedFloorConfig)
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(1000);
+
+BENCHMARK_CAPTURE(runActionAllChanged, mapped_floor, "mapped_floor",
+                  mappedFloorConfig)
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(1000);
+
+// Its card lookups run from a settle timer after the triggers stop,
+// and find the cards through the mapper, so only its triggered runs
+// restarting that timer are measured
+BENCHMARK_CAPTURE(runAction, pcie_card_floors, "pcie_card_floors",
+                  json{{"settle_time", 1}})
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(1000);
+
+const json countStateAction = {{"name", "count_state_before_target"},
+                               {"count", 1},
+                               {"state", 100.0},
+                               {"target", 9000}};
+
+// With every member's service owned, each run stops the timer and
+// runs the actions it wraps
+BENCHMARK_CAPTURE(runAction, call_actions_based_on_timer,
+                  "call_actions_based_on_timer",
+                  json{{"timer", {{"interval", 1000000}, {"type", "oneshot"}}},
+                       {"actions", json::array({countStateAction})}})
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(1000);
+
+/**
+ * @brief Run get_managed_objects, refreshing the members from the
+ *        ObjectManager of their service before running the action it
+ *        wraps
+ */
+static void BM_GetManagedObjects(benchmark::State& state)
+{
+    auto* manager = getManager();
+    if (!manager)
+    {
+        state.SkipWithError("No D-Bus connection to create a Manager with");
+        return;
+    }
+
+    Fixture fixture{static_cast<size_t>(state.range(0)), manager};
+    auto action = fixture.makeAction(
+        "get_managed_objects",
+        json{{"actions", json::array({countStateAction})}});
+
+    for (auto _ : state)
+    {
+        action->run();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GetManagedObjects)->Arg(100)->Arg(500)->Arg(1000);
+
+/**
+ * @brief Handle PropertiesChanged signals from one member after another
+ *        as the signal triggers do, each running a tracked action
+ */
+static void BM_HandleSignal(benchmark::State& state)
+{
+    auto* manager = getManager();
+    if (!manager)
+    {
+        state.SkipWithError("No D-Bus connection to create a Manager with");
+        return;
+    }
+
+    auto numMembers = static_cast<size_t>(state.range(0));
+    Fixture fixture{numMembers, manager};
+    auto action = fixture.makeAction("count_state_before_target",
+                                     countStateAction);
+    action->run();
+
+    // Each member's signal packages, and its signals changing it to
+    // the values of even and odd generations
+    auto& bus = util::SDBusPlus::getBus();
+    std::vector<std::vector<SignalPkg>> pkgs(numMembers);
+    std::vector<sdbusplus::message::message> msgs;
+    uint64_t cookie = 1;
+    for (size_t i = 0; i < numMembers; i++)
+    {
+        const auto& path = fixture.members[i];
+        pkgs[i].emplace_back(trigger::signal::Handlers::propertiesChanged,
+                             SignalObject{path, memberIntf, memberProp},
+                             TriggerActions{std::ref(action)});
+        for (size_t generation = 0; generation < 2; generation++)
+        {
+            auto msg = bus.new_signal(path.c_str(),
+                                      "org.freedesktop.DBus.Properties",
+                                      "PropertiesChanged");
+            msg.append(std::string{memberIntf},
+                       std::map<std::string, PropertyVariantType>{
+                           {memberProp, Fixture::value(i, generation)}},
+                       std::vector<std::string>{});
+            // Sealed as if sent, so it can be read
+            sd_bus_message_seal(msg.get(), cookie++, 0);
+            msgs.push_back(std::move(msg));
+        }
+    }
+
+    size_t signal = 0;
+    for (auto _ : state)
+    {
+        auto member = signal % numMembers;
+        auto& msg = msgs[member * 2 + (signal / numMembers + 1) % 2];
+        manager->handleSignal(msg, &pkgs[member]);
+        sd_bus_message_rewind(msg.get(), true);
+        signal++;
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HandleSignal)->Arg(100)->Arg(500)->Arg(1000);
+
+/**
+ * @brief A group's numeric column range, with one member in eight
+ *        not cached
+ */
+struct ReductionFixture
+{
+    explicit ReductionFixture(size_t numMembers)
+    {
+        std::vector<std::string> members;
+        for (size_t i = 0; i < numMembers; i++)
+        {
+            members.push_back(fmt::format("/bench/reduce{}", i));
+        }
+        bool added = false;
+        range = column.addRange(members, added);
+        for (size_t i = 0; i < numMembers; i++)
+        {
+            if (i % 8 != 7)
+            {
+                column.set(members[i], static_cast<double>(i % 100));
+            }
+        }
+    }
+
+    NumericColumn column;
+    NumericRange range;
+};
+
+static void BM_CountEqual(benchmark::State& state)
+{
+    ReductionFixture fixture{static_cast<size_t>(state.range(0))};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(reduction::countEqual(fixture.range, 50.0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CountEqual)->RangeMultiplier(4)->Range(16, 1024);
+
+static void BM_CountAtOrAbove(benchmark::State& state)
+{
+    ReductionFixture fixture{static_cast<size_t>(state.range(0))};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            reduction::countAtOrAbove(fixture.range, 50.0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CountAtOrAbove)->RangeMultiplier(4)->Range(16, 1024);
+
+static void BM_MarkEqual(benchmark::State& state)
+{
+    ReductionFixture fixture{static_cast<size_t>(state.range(0))};
+    std::vector<uint8_t> atState(fixture.range.size);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            reduction::markEqual(fixture.range, 50.0, atState.data()));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MarkEqual)->RangeMultiplier(4)->Range(16, 1024);
+
+static void BM_DeltasAboveState(benchmark::State& state)
+{
+    ReductionFixture fixture{static_cast<size_t>(state.range(0))};
+    std::vector<uint64_t> deltas(fixture.range.size);
+    for (auto _ : state)
+    {
+        reduction::deltasAboveState(fixture.range, 50.0, 100, deltas.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DeltasAboveState)->RangeMultiplier(4)->Range(16, 1024);
+
+static void BM_MinDeltaBelowState(benchmark::State& state)
+{
+    ReductionFixture fixture{static_cast<size_t>(state.range(0))};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            reduction::minDeltaBelowState(fixture.range, 50.0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MinDeltaBelowState)->RangeMultiplier(4)->Range(16, 1024);
+
+/**
+ * @class GrowthReporter
+ *
+ * Reports the runs on the console as usual, and also keeps each
+ * benchmark's time per member by member count, to check how it scales.
+ */
+class GrowthReporter : public benchmark::ConsoleReporter
+{
+  public:
+    void ReportRuns(const std::vector<Run>& runs) override
+    {
+        ConsoleReporter::ReportRuns(runs);
+        for (const auto& run : runs)
+        {
+            // Only the benchmarks run at several member counts are checked
+            auto name = run.benchmark_name();
+            auto pos = name.rfind('/');
+            if ((run.run_type != Run::RT_Iteration) || (run.iterations == 0) ||
+                (pos == std::string::npos))
+            {
+                continue;
+            }
+            auto count = std::strtoul(name.c_str() + pos + 1, nullptr, 10);
+            if (count != 0)
+            {
+                perItem[name.substr(0, pos)][count] =
+                    run.GetAdjustedRealTime() / count;
+            }
+        }
+    }
+
+    /* Map of benchmarks to their time per member by member count */
+    std::map<std::string, std::map<unsigned long, double>> perItem;
+};
+
+/**
+ * @brief Runs the benchmarks, and with --check fails when the time per
+ *        member of any of them grows by more than maxPerItemGrowth from
+ *        its smallest to its largest member count, as when an action
+ *        becomes quadratic
+ */
+int main(int argc, char** argv)
+{
+    bool check = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--check") == 0)
+        {
+            check = true;
+            std::copy(argv + i + 1, argv + argc, argv + i);
+            argc--;
+            break;
+        }
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    GrowthReporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+    if (!check)
+    {
+        return 0;
+    }
+
+    int rc = 0;
+    for (const auto& [name, perItem] : reporter.perItem)
+    {
+        if (perItem.size() < 2)
+        {
+            continue;
+        }
+        auto growth = perItem.rbegin()->second / perItem.begin()->second;
+        if (growth > maxPerItemGrowth)
+        {
+            std::cerr << name << ": time per member grew " << growth
+                      << "x from " << perItem.begin()->first << " to "
+                      << perItem.rbegin()->first << " members" << std::endl;
+            rc = 1;
+        }
+    }
+    return rc;
+}
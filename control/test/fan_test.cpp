@@ -0,0 +1,205 @@
+#include "config.h"
+
+#include "../json/fan.hpp"
+#include "mock_bus_interface.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::fan::control::json;
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+constexpr auto targetIntf = "xyz.openbmc_project.Control.FanSpeed";
+
+class FanTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        auto bus = std::make_unique<NiceMock<MockBusInterface>>();
+        mockBus = bus.get();
+        ON_CALL(*mockBus, getService(_, _))
+            .WillByDefault(Return("xyz.openbmc_project.Hwmon"));
+        ON_CALL(*mockBus, getTarget(_, _, _)).WillByDefault(Return(5000));
+        BusInterfaceBase::setInstance(std::move(bus));
+
+        // A fake hwmon sysfs tree to write targets to
+        std::string dir = fs::temp_directory_path() / "fan_testXXXXXX";
+        ASSERT_NE(mkdtemp(dir.data()), nullptr);
+        sysfsDir = dir;
+    }
+
+    void TearDown() override
+    {
+        BusInterfaceBase::setInstance(nullptr);
+        fs::remove_all(sysfsDir);
+    }
+
+    /**
+     * @brief Create an attribute in the fake sysfs tree
+     *
+     * @param[in] path - The attribute's path within the tree
+     * @param[in] value - The attribute's contents
+     */
+    void writeAttr(const fs::path& path, const std::string& value)
+    {
+        fs::create_directories((sysfsDir / path).parent_path());
+        std::ofstream{sysfsDir / path} << value;
+    }
+
+    /**
+     * @brief Read the first line of an attribute in the fake sysfs tree
+     *
+     * @param[in] path - The attribute's path within the tree
+     */
+    std::string readAttr(const fs::path& path)
+    {
+        std::ifstream attr{sysfsDir / path};
+        std::string value;
+        std::getline(attr, value);
+        return value;
+    }
+
+    MockBusInterface* mockBus = nullptr;
+
+    fs::path sysfsDir;
+
+    const json fanConfig = {{"name", "fan0"},
+                            {"zone", "0"},
+                            {"sensors", {"fan0_0", "fan0_1"}},
+                            {"target_interface", targetIntf}};
+};
+
+TEST_F(FanTest, ReadsTargetOnCreate)
+{
+    EXPECT_CALL(*mockBus,
+                getService("/xyz/openbmc_project/sensors/fan_tach/fan0_0",
+                           targetIntf));
+    EXPECT_CALL(*mockBus,
+                getService("/xyz/openbmc_project/sensors/fan_tach/fan0_1",
+                           targetIntf));
+    // All of a fan's sensors have the same target, so only one is read
+    EXPECT_CALL(*mockBus, getTarget(_, _, targetIntf)).Times(1);
+
+    Fan fan{fanConfig};
+    EXPECT_EQ(fan.getTarget(), 5000);
+    EXPECT_EQ(fan.getZone(), "0");
+}
+
+TEST_F(FanTest, MissingConfig)
+{
+    auto config = fanConfig;
+    config.erase("target_interface");
+    EXPECT_THROW(Fan{config}, std::runtime_error);
+
+    config = fanConfig;
+    config.erase("sensors");
+    EXPECT_THROW(Fan{config}, std::runtime_error);
+}
+
+TEST_F(FanTest, WritesChangedTarget)
+{
+#ifdef CONTROL_USE_IO_THREAD
+    GTEST_SKIP() << "Targets are written from the I/O thread";
+#endif
+    Fan fan{fanConfig};
+
+    EXPECT_CALL(*mockBus, setTarget(_, _, targetIntf, 6000)).Times(2);
+    fan.setTarget(6000);
+    EXPECT_EQ(fan.getTarget(), 6000);
+
+    // Unchanged targets aren't rewritten
+    fan.setTarget(6000);
+}
+
+TEST_F(FanTest, SysfsTargetRewritesOverwritten)
+{
+    writeAttr("hwmon3/fan1_target", "0\n");
+    SysfsTarget attr{sysfsDir / "hwmon*/fan1_target"};
+    EXPECT_EQ(attr.getPath(), (sysfsDir / "hwmon3/fan1_target").string());
+
+    EXPECT_TRUE(attr.write(6000));
+    EXPECT_EQ(readAttr("hwmon3/fan1_target"), "6000");
+
+    // Something else writing the attribute doesn't stop the same target
+    // from being written again
+    writeAttr("hwmon3/fan1_target", "0\n");
+    EXPECT_TRUE(attr.write(6000));
+    EXPECT_EQ(readAttr("hwmon3/fan1_target"), "6000");
+
+    EXPECT_TRUE(attr.write(7000));
+    EXPECT_EQ(readAttr("hwmon3/fan1_target"), "7000");
+}
+
+TEST_F(FanTest, SysfsTargetMissing)
+{
+    SysfsTarget attr{sysfsDir / "hwmon*/fan1_target"};
+    EXPECT_FALSE(attr.write(6000));
+
+    // The attribute is opened once it shows up, as after a driver rebind
+    writeAttr("hwmon4/fan1_target", "0\n");
+    EXPECT_TRUE(attr.write(6000));
+    EXPECT_EQ(attr.getPath(), (sysfsDir / "hwmon4/fan1_target").string());
+    EXPECT_EQ(readAttr("hwmon4/fan1_target"), "6000");
+}
+
+TEST_F(FanTest, WritesSysfsTarget)
+{
+#ifdef CONTROL_USE_IO_THREAD
+    GTEST_SKIP() << "Targets are published from the I/O thread";
+#endif
+    writeAttr("hwmon3/pwm1", "0\n");
+    auto config = fanConfig;
+    config["sensors"] = {"fan0_0"};
+    config["sysfs_targets"] = {
+        {"fan0_0", (sysfsDir / "hwmon*/pwm1").string()}};
+    Fan fan{config};
+
+    // The target is written to sysfs, and the property is set without
+    // waiting on the service
+    EXPECT_CALL(*mockBus, setTarget(_, _, _, _)).Times(0);
+    EXPECT_CALL(*mockBus,
+                publishTarget(_, "/xyz/openbmc_project/sensors/fan_tach/fan0_0",
+                              targetIntf, 6000))
+        .Times(1);
+    fan.setTarget(6000);
+    // An unchanged target isn't written or published again
+    fan.setTarget(6000);
+    EXPECT_EQ(fan.getTarget(), 6000);
+    EXPECT_EQ(readAttr("hwmon3/pwm1"), "6000");
+}
+
+TEST_F(FanTest, SysfsTargetFallsBackToDBus)
+{
+#ifdef CONTROL_USE_IO_THREAD
+    GTEST_SKIP() << "Targets are written from the I/O thread";
+#endif
+    auto config = fanConfig;
+    config["sysfs_targets"] = {
+        {"fan0_0", (sysfsDir / "hwmon*/fan1_target").string()}};
+    Fan fan{config};
+
+    // Without the attribute, both sensors' targets are set on dbus
+    EXPECT_CALL(*mockBus, publishTarget(_, _, _, _)).Times(0);
+    EXPECT_CALL(*mockBus, setTarget(_, _, targetIntf, 6000)).Times(2);
+    fan.setTarget(6000);
+    EXPECT_EQ(fan.getTarget(), 6000);
+}
+
+TEST_F(FanTest, SysfsTargetUnknownSensor)
+{
+    auto config = fanConfig;
+    config["sysfs_targets"] = {
+        {"fan1_0", (sysfsDir / "hwmon*/fan1_target").string()}};
+    EXPECT_THROW(Fan{config}, std::runtime_error);
+}
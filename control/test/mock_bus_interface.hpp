@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../json/utils/bus_interface.hpp"
+
+#include <gmock/gmock.h>
+
+namespace phosphor::fan::control::json
+{
+
+class MockBusInterface : public BusInterfaceBase
+{
+  public:
+    MOCK_METHOD(std::string, getService,
+                (const std::string&, const std::string&), (override));
+    MOCK_METHOD(SubTree, getSubTree,
+                (const std::string&, const std::string&, int32_t),
+                (override));
+    MOCK_METHOD(std::vector<std::string>, listNames, (), (override));
+    MOCK_METHOD(PropertyVariantType, getProperty,
+                (const std::string&, const std::string&, const std::string&,
+                 const std::string&),
+                (override));
+    MOCK_METHOD(ManagedObjects, getManagedObjects,
+                (const std::string&, const std::string&), (override));
+    MOCK_METHOD(uint64_t, getTarget,
+                (const std::string&, const std::string&, const std::string&),
+                (override));
+    MOCK_METHOD(void, setTarget,
+                (const std::string&, const std::string&, const std::string&,
+                 uint64_t),
+                (override));
+    MOCK_METHOD(void, publishTarget,
+                (const std::string&, const std::string&, const std::string&,
+                 uint64_t),
+                (override));
+};
+
+} // namespace phosphor::fan::control::json
@@ -3,7 +3,9 @@
 #include <sdeventplus/clock.hpp>
 #include <sdeventplus/utility/timer.hpp>
 
+#include <span>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
@@ -41,7 +43,77 @@ using FanDefinition =
 constexpr auto pathPos = 0;
 constexpr auto intfPos = 1;
 constexpr auto propPos = 2;
-using Group = std::vector<std::tuple<std::string, std::string, std::string>>;
+
+/**
+ * @brief The dense integer id the generator assigns each distinct group
+ */
+enum class GroupId : size_t
+{
+};
+
+using GroupMemberDef =
+    std::tuple<std::string_view, std::string_view, std::string_view>;
+
+/**
+ * @brief Get the members of the group with the given id
+ *
+ * Defined by the generated configuration, which keeps the members of
+ * every group in a single constexpr table indexed by the group's id.
+ *
+ * @param[in] id - The group's id
+ *
+ * @return The group's object, interface and property names
+ */
+std::span<const GroupMemberDef> getGroupMembers(GroupId id);
+
+/**
+ * @class Group
+ * @brief The members of a group, along with the group's id
+ *
+ * Groups with the same members share the same id, so zones can keep
+ * per-group state in flat arrays indexed by it instead of having to
+ * compare the members.
+ */
+class Group :
+    public std::vector<std::tuple<std::string, std::string, std::string>>
+{
+  public:
+    Group() = delete;
+    Group(const Group&) = default;
+    Group& operator=(const Group&) = default;
+    Group(Group&&) = default;
+    Group& operator=(Group&&) = default;
+    ~Group() = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] id - The group's id, whose members are looked up in the
+     *                 generated group table
+     */
+    explicit Group(GroupId id) : _id(id)
+    {
+        const auto members = getGroupMembers(id);
+        reserve(members.size());
+        for (const auto& [object, interface, property] : members)
+        {
+            emplace_back(object, interface, property);
+        }
+    }
+
+    /**
+     * @brief Get the group's id
+     */
+    inline size_t id() const
+    {
+        return static_cast<size_t>(_id);
+    }
+
+  private:
+    /* The group's id */
+    GroupId _id;
+};
+
 using ZoneHandler = std::function<void(Zone&)>;
 using SignalHandler = std::function<void(sdbusplus::bus::bus&,
                                          sdbusplus::message::message&, Zone&)>;
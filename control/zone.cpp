@@ -59,7 +59,9 @@ Zone::Zone(Mode mode, sdbusplus::bus::bus& bus, const std::string& path,
     _incDelay(std::get<incDelayPos>(def)),
     _decInterval(std::get<decIntervalPos>(def)),
     _incTimer(event, std::bind(&Zone::incTimerExpired, this)),
-    _decTimer(event, std::bind(&Zone::decTimerExpired, this)), _eventLoop(event)
+    _decTimer(event, std::bind(&Zone::decTimerExpired, this)), _eventLoop(event),
+    _active(_numGroups, true), _floorChange(_numGroups, true),
+    _decAllowed(_numGroups, true), _services(_numGroups)
 {
     auto& fanDefs = std::get<fanListPos>(def);
 
@@ -124,7 +126,7 @@ void Zone::setFullSpeed()
 
 void Zone::setActiveAllow(const Group* group, bool isActiveAllow)
 {
-    _active[*(group)] = isActiveAllow;
+    _active[group->id()] = isActiveAllow;
     if (!isActiveAllow)
     {
         _isActive = false;
@@ -132,54 +134,40 @@ void Zone::setActiveAllow(const Group* group, bool isActiveAllow)
     else
     {
         // Check all entries are set to allow control active
-        auto actPred = [](auto const& entry) { return entry.second; };
-        _isActive = std::all_of(_active.begin(), _active.end(), actPred);
+        _isActive = std::all_of(_active.begin(), _active.end(),
+                                [](bool allow) { return allow; });
     }
 }
 
 void Zone::removeService(const Group* group, const std::string& name)
 {
-    try
-    {
-        auto& sNames = _services.at(*group);
-        auto it = std::find_if(sNames.begin(), sNames.end(),
-                               [&name](auto const& entry) {
-                                   return name == std::get<namePos>(entry);
-                               });
-        if (it != std::end(sNames))
-        {
-            // Remove service name from group
-            sNames.erase(it);
-        }
-    }
-    catch (const std::out_of_range& oore)
+    auto& sNames = _services[group->id()];
+    auto it = std::find_if(sNames.begin(), sNames.end(),
+                           [&name](auto const& entry) {
+                               return name == std::get<namePos>(entry);
+                           });
+    if (it != std::end(sNames))
     {
-        // No services for group found
+        // Remove service name from group
+        sNames.erase(it);
     }
 }
 
 void Zone::setServiceOwner(const Group* group, const std::string& name,
                            const bool hasOwner)
 {
-    try
+    auto& sNames = _services[group->id()];
+    auto it = std::find_if(sNames.begin(), sNames.end(),
+                           [&name](auto const& entry) {
+                               return name == std::get<namePos>(entry);
+                           });
+    if (it != std::end(sNames))
     {
-        auto& sNames = _services.at(*group);
-        auto it = std::find_if(sNames.begin(), sNames.end(),
-                               [&name](auto const& entry) {
-                                   return name == std::get<namePos>(entry);
-                               });
-        if (it != std::end(sNames))
-        {
-            std::get<hasOwnerPos>(*it) = hasOwner;
-        }
-        else
-        {
-            _services[*group].emplace_back(name, hasOwner);
-        }
+        std::get<hasOwnerPos>(*it) = hasOwner;
     }
-    catch (const std::out_of_range& oore)
+    else
     {
-        _services[*group].emplace_back(name, hasOwner);
+        sNames.emplace_back(name, hasOwner);
     }
 }
 
@@ -210,8 +198,8 @@ void Zone::setServices(const Group* group)
 void Zone::setFloor(uint64_t speed)
 {
     // Check all entries are set to allow floor to be set
-    auto pred = [](auto const& entry) { return entry.second; };
-    auto setFloor = std::all_of(_floorChange.begin(), _floorChange.end(), pred);
+    auto setFloor = std::all_of(_floorChange.begin(), _floorChange.end(),
+                                [](bool allow) { return allow; });
     if (setFloor)
     {
         _floorSpeed = speed;
@@ -262,8 +250,8 @@ void Zone::requestSpeedDecrease(uint64_t targetDelta)
 void Zone::decTimerExpired()
 {
     // Check all entries are set to allow a decrease
-    auto pred = [](auto const& entry) { return entry.second; };
-    auto decAllowed = std::all_of(_decAllowed.begin(), _decAllowed.end(), pred);
+    auto decAllowed = std::all_of(_decAllowed.begin(), _decAllowed.end(),
+                                  [](bool allow) { return allow; });
 
     // Only decrease speeds when allowed,
     // a requested decrease speed delta exists,
@@ -122,7 +122,7 @@ class Zone : public ThermalObject
      */
     inline void setFloorChangeAllow(const Group* group, bool isAllow)
     {
-        _floorChange[*(group)] = isAllow;
+        _floorChange[group->id()] = isAllow;
     }
 
     /**
@@ -133,7 +133,7 @@ class Zone : public ThermalObject
      */
     inline void setDecreaseAllow(const Group* group, bool isAllow)
     {
-        _decAllowed[*(group)] = isAllow;
+        _decAllowed[group->id()] = isAllow;
     }
 
     /**
@@ -322,7 +322,7 @@ class Zone : public ThermalObject
      */
     inline auto getGroupServices(const Group* group)
     {
-        return _services.at(*group);
+        return _services[group->id()];
     }
 
     /**
@@ -786,24 +786,29 @@ class Zone : public ThermalObject
     std::map<std::string, std::vector<std::string>> _persisted;
 
     /**
-     * @brief Map of active fan control allowed by groups
+     * @brief The number of distinct groups, generated
      */
-    std::map<const Group, bool> _active;
+    static const size_t _numGroups;
 
     /**
-     * @brief Map of floor change allowed by groups
+     * @brief Active fan control allowed, by group id
      */
-    std::map<const Group, bool> _floorChange;
+    std::vector<bool> _active;
 
     /**
-     * @brief Map of groups controlling decreases allowed
+     * @brief Floor change allowed, by group id
      */
-    std::map<const Group, bool> _decAllowed;
+    std::vector<bool> _floorChange;
 
     /**
-     * @brief Map of group service names
+     * @brief Decreases allowed, by group id
      */
-    std::map<const Group, std::vector<Service>> _services;
+    std::vector<bool> _decAllowed;
+
+    /**
+     * @brief Group service names, by group id
+     */
+    std::vector<std::vector<Service>> _services;
 
     /**
      * @brief Map tree of paths to services of interfaces
@@ -8,9 +8,12 @@
 #include <phosphor-logging/elog.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 
+#include <cerrno>
+#include <ctime>
 #include <memory>
 #include <string>
 #include <tuple>
+#include <vector>
 
 namespace evdevpp
 {
@@ -106,6 +109,67 @@ class EvDev
         return std::make_tuple(ev.type, ev.code, ev.value);
     }
 
+    /**
+     * @brief Get all of the pending events.
+     *
+     * Reads until the device has no more events queued, so it
+     * must be backed by a non-blocking file descriptor.  When the
+     * kernel reports dropped events, the device is resynced and
+     * the resulting state deltas are returned in their place.
+     */
+    auto drain()
+    {
+        std::vector<struct input_event> events;
+        auto flag = LIBEVDEV_READ_FLAG_NORMAL;
+        while (true)
+        {
+            struct input_event ev;
+            auto rc = libevdev_next_event(evdev.get(), flag, &ev);
+            if (rc == -EAGAIN)
+            {
+                if (flag == LIBEVDEV_READ_FLAG_SYNC)
+                {
+                    // Resync complete, pick up any newer events
+                    flag = LIBEVDEV_READ_FLAG_NORMAL;
+                    continue;
+                }
+                break;
+            }
+            if (rc < 0)
+            {
+                log<level::ERR>("Error in call to libevdev_next_event",
+                                entry("RC=%d", rc));
+                elog<InternalFailure>();
+            }
+
+            if (rc == LIBEVDEV_READ_STATUS_SYNC &&
+                flag == LIBEVDEV_READ_FLAG_NORMAL)
+            {
+                // SYN_DROPPED, switch to reading the sync deltas
+                flag = LIBEVDEV_READ_FLAG_SYNC;
+                continue;
+            }
+
+            if (ev.type == EV_SYN)
+                continue;
+
+            events.push_back(ev);
+        }
+        return events;
+    }
+
+    /** @brief Set the clock used for event timestamps. */
+    void setClockId(clockid_t clockId)
+    {
+        auto rc = libevdev_set_clock_id(evdev.get(), clockId);
+        if (rc)
+        {
+            log<level::ERR>("Error in call to libevdev_set_clock_id",
+                            entry("RC=%d", rc));
+            elog<InternalFailure>();
+        }
+    }
+
   private:
     EvDevPtr get()
     {
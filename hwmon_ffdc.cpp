@@ -3,11 +3,16 @@
 #include "logging.hpp"
 
 #include <fmt/format.h>
+#include <sys/klog.h>
 
-#include <array>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace phosphor::fan::monitor
@@ -18,26 +23,16 @@ namespace util
 
 namespace fs = std::filesystem;
 
-inline std::vector<std::string> executeCommand(const std::string& command)
-{
-    std::vector<std::string> output;
-    std::array<char, 128> buffer;
+// klogctl() actions, see syslog(2)
+constexpr int klogReadAll = 3;
+constexpr int klogSizeBuffer = 10;
 
-    std::unique_ptr<FILE, decltype(&pclose)> pipe(popen(command.c_str(), "r"),
-                                                  pclose);
-    if (!pipe)
-    {
-        getLogger().log(
-            fmt::format("popen() failed when running command: {}", command));
-        return output;
-    }
-    while (fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr)
-    {
-        output.emplace_back(buffer.data());
-    }
+// Upper bounds on how much of the kernel log is read and kept
+constexpr size_t maxKlogSize = 1024 * 1024;
+constexpr size_t maxDmesgLines = 100;
 
-    return output;
-}
+// Cached hwmon driver names, see refreshHwmonNames()
+std::optional<std::vector<std::string>> cachedHwmonNames;
 
 std::vector<std::string> getHwmonNameFFDC()
 {
@@ -85,43 +80,93 @@ std::vector<std::string> getHwmonNameFFDC()
 std::vector<std::string> getDmesgFFDC()
 {
     std::vector<std::string> output;
-    auto dmesgOutput = executeCommand("dmesg");
+
+    // Read the kernel log ring buffer directly instead of
+    // forking off dmesg and reading it back through a pipe.
+    auto size = klogctl(klogSizeBuffer, nullptr, 0);
+    if (size <= 0)
+    {
+        getLogger().log(fmt::format("klogctl() failed getting size: {}",
+                                    strerror(errno)));
+        return output;
+    }
+
+    std::string buffer(std::min(static_cast<size_t>(size), maxKlogSize), '\0');
+    size = klogctl(klogReadAll, buffer.data(), buffer.size());
+    if (size < 0)
+    {
+        getLogger().log(
+            fmt::format("klogctl() failed reading: {}", strerror(errno)));
+        return output;
+    }
+    buffer.resize(size);
 
     // Only pull in dmesg lines with interesting keywords.
     // One example is:
     // [   16.390603] max31785: probe of 7-0052 failed with error -110
     // using ' probe' to avoid 'modprobe'
-    std::vector<std::string> matches{" probe", "failed"};
+    const std::vector<std::string_view> matches{" probe", "failed"};
 
-    for (const auto& line : dmesgOutput)
+    std::string_view log{buffer};
+    while (!log.empty())
     {
+        auto pos = log.find('\n');
+        auto line = log.substr(0, pos);
+        log.remove_prefix((pos == std::string_view::npos) ? log.size()
+                                                            : pos + 1);
+
+        // Strip the '<N>' log level prefix dmesg wouldn't have shown
+        if (line.starts_with('<'))
+        {
+            if (auto end = line.find('>'); end != std::string_view::npos)
+            {
+                line.remove_prefix(end + 1);
+            }
+        }
+
         for (const auto& m : matches)
         {
-            if (line.find(m) != std::string::npos)
+            if (line.find(m) != std::string_view::npos)
             {
-                output.push_back(line);
-                if (output.back().back() == '\n')
-                {
-                    output.back().pop_back();
-                }
+                output.emplace_back(line);
                 break;
             }
         }
     }
 
+    // Keep only the most recent lines
+    if (output.size() > maxDmesgLines)
+    {
+        output.erase(output.begin(), output.end() - maxDmesgLines);
+    }
+
     return output;
 }
 
 } // namespace util
 
+void refreshHwmonNames()
+{
+    util::cachedHwmonNames = util::getHwmonNameFFDC();
+}
+
+void invalidateHwmonNames()
+{
+    util::cachedHwmonNames.reset();
+}
+
 nlohmann::json collectHwmonFFDC()
 {
     nlohmann::json ffdc;
 
-    auto hwmonNames = util::getHwmonNameFFDC();
-    if (!hwmonNames.empty())
+    if (!util::cachedHwmonNames)
+    {
+        refreshHwmonNames();
+    }
+
+    if (!util::cachedHwmonNames->empty())
     {
-        ffdc["hwmonNames"] = std::move(hwmonNames);
+        ffdc["hwmonNames"] = *util::cachedHwmonNames;
     }
 
     auto dmesg = util::getDmesgFFDC();
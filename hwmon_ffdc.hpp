@@ -7,11 +7,27 @@ namespace phosphor::fan::monitor
 /**
  * @brief Collects hwmon data for event log FFDC
  *
- * Makes a list of the loaded hwmon driver names, and
- * pulls interesting lines from dmesg.
+ * Uses the cached list of the loaded hwmon driver names, and
+ * pulls interesting lines from the kernel log buffer.
  *
  * @return json - The FFDC data
  */
 nlohmann::json collectHwmonFFDC();
 
+/**
+ * @brief Rebuilds the cached list of hwmon driver names
+ *
+ * Should be called when hwmon devices may have come or gone,
+ * so that collectHwmonFFDC() doesn't have to walk sysfs.
+ */
+void refreshHwmonNames();
+
+/**
+ * @brief Marks the cached list of hwmon driver names as stale
+ *
+ * The next collectHwmonFFDC() rebuilds it, so this is cheap enough
+ * to call whenever a sensor service comes or goes.
+ */
+void invalidateHwmonNames();
+
 } // namespace phosphor::fan::monitor
@@ -15,6 +15,7 @@
  */
 #include "fan.hpp"
 
+#include "inventory_snapshot.hpp"
 #include "logging.hpp"
 #include "sdbusplus.hpp"
 #include "system.hpp"
@@ -37,7 +38,7 @@ using namespace sdbusplus::bus::match;
 
 Fan::Fan(Mode mode, sdbusplus::bus::bus& bus, const sdeventplus::Event& event,
          std::unique_ptr<trust::Manager>& trust, const FanDefinition& def,
-         System& system) :
+         System& system, const InventorySnapshot& inventory) :
     _bus(bus),
     _name(std::get<fanNameField>(def)),
     _deviation(std::get<fanDeviationField>(def)),
@@ -74,7 +75,7 @@ Fan::Fan(Mode mode, sdbusplus::bus::bus& bus, const sdeventplus::Event& event,
             std::get<thresholdField>(s), std::get<ignoreAboveMaxField>(s),
             std::get<timeoutField>(def),
             std::get<nonfuncRotorErrDelayField>(def),
-            std::get<countIntervalField>(def), event));
+            std::get<countIntervalField>(def), event, inventory));
 
         _trustManager->registerSensor(_sensors.back());
     }
@@ -121,8 +122,13 @@ Fan::Fan(Mode mode, sdbusplus::bus::bus& bus, const sdeventplus::Event& event,
 
     try
     {
-        _present = util::SDBusPlus::getProperty<bool>(
-            util::INVENTORY_PATH + _name, util::INV_ITEM_IFACE, "Present");
+        auto present = inventory.getPresent(util::INVENTORY_PATH + _name);
+        if (!present)
+        {
+            present = util::SDBusPlus::getProperty<bool>(
+                util::INVENTORY_PATH + _name, util::INV_ITEM_IFACE, "Present");
+        }
+        _present = *present;
 
         if (!_present)
         {
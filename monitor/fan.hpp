@@ -19,6 +19,7 @@ namespace fan
 namespace monitor
 {
 
+class InventorySnapshot;
 class System;
 
 /**
@@ -79,10 +80,11 @@ class Fan
      * @param trust - the tach trust manager
      * @param def - the fan definition structure
      * @param system - Reference to the system object
+     * @param inventory - The inventory state at load time
      */
     Fan(Mode mode, sdbusplus::bus::bus& bus, const sdeventplus::Event& event,
         std::unique_ptr<trust::Manager>& trust, const FanDefinition& def,
-        System& system);
+        System& system, const InventorySnapshot& inventory);
 
     /**
      * @brief Callback function for when an input sensor changes
@@ -0,0 +1,161 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "inventory_snapshot.hpp"
+
+#include "sdbusplus.hpp"
+#include "utility.hpp"
+
+#include <phosphor-logging/log.hpp>
+
+#include <variant>
+#include <vector>
+
+namespace phosphor::fan::monitor
+{
+
+using namespace phosphor::logging;
+
+/* Only the bool properties are kept, the rest are skipped when read */
+using PropertyValue = std::variant<bool>;
+
+namespace
+{
+
+/**
+ * @brief Get a bool property out of a set of interface properties
+ *
+ * @param[in] properties - The interface's properties
+ * @param[in] property - The property
+ *
+ * @return The property value, or std::nullopt if it isn't there
+ */
+std::optional<bool>
+    findBool(const std::map<std::string, PropertyValue>& properties,
+             const std::string& property)
+{
+    auto itProp = properties.find(property);
+    if (itProp == properties.end())
+    {
+        return std::nullopt;
+    }
+    return std::get<bool>(itProp->second);
+}
+
+} // namespace
+
+InventorySnapshot::InventorySnapshot(sdbusplus::bus::bus& bus)
+{
+    // Map of the OperationalStatus object paths to the services holding them
+    std::map<std::string, std::vector<std::string>> objects;
+    try
+    {
+        auto subtree = util::SDBusPlus::getSubTreeRaw(
+            bus, util::INVENTORY_PATH, util::OPERATIONAL_STATUS_INTF, 0);
+        for (auto& [path, services] : subtree)
+        {
+            auto& pathServices = objects[path];
+            for (auto& service : services)
+            {
+                pathServices.push_back(service.first);
+            }
+        }
+    }
+    catch (const util::DBusError& e)
+    {
+        log<level::DEBUG>(e.what());
+    }
+
+    bool managed = false;
+    try
+    {
+        auto managedObjects =
+            util::SDBusPlus::getManagedObjects<PropertyValue>(
+                bus, util::INVENTORY_SVC, util::INVENTORY_PATH);
+        managed = true;
+        for (const auto& [path, intfs] : managedObjects)
+        {
+            auto itItem = intfs.find(util::INV_ITEM_IFACE);
+            if (itItem != intfs.end())
+            {
+                if (auto present = findBool(itItem->second, "Present"))
+                {
+                    _present[path.str] = *present;
+                }
+            }
+
+            auto itStatus = intfs.find(util::OPERATIONAL_STATUS_INTF);
+            if ((itStatus != intfs.end()) && objects.count(path.str))
+            {
+                if (auto functional = findBool(itStatus->second,
+                                               util::FUNCTIONAL_PROPERTY))
+                {
+                    _functional[path.str] = *functional;
+                }
+            }
+        }
+    }
+    catch (const util::DBusError& e)
+    {
+        log<level::DEBUG>(e.what());
+    }
+
+    // Read the objects that weren't in the inventory manager's
+    for (const auto& [path, services] : objects)
+    {
+        if ((_functional.find(path) != _functional.end()) || services.empty())
+        {
+            continue;
+        }
+        if (managed && (services.front() == util::INVENTORY_SVC))
+        {
+            // Held by the inventory manager without a Functional value
+            continue;
+        }
+        try
+        {
+            _functional[path] = util::SDBusPlus::getProperty<bool>(
+                bus, services.front(), path, util::OPERATIONAL_STATUS_INTF,
+                util::FUNCTIONAL_PROPERTY);
+        }
+        catch (const util::DBusError& e)
+        {
+            log<level::DEBUG>(e.what());
+        }
+    }
+}
+
+std::optional<bool>
+    InventorySnapshot::getFunctional(const std::string& path) const
+{
+    auto itFunctional = _functional.find(path);
+    if (itFunctional == _functional.end())
+    {
+        return std::nullopt;
+    }
+    return itFunctional->second;
+}
+
+std::optional<bool> InventorySnapshot::getPresent(const std::string& path) const
+{
+    auto itPresent = _present.find(path);
+    if (itPresent == _present.end())
+    {
+        return std::nullopt;
+    }
+    return itPresent->second;
+}
+
+} // namespace phosphor::fan::monitor
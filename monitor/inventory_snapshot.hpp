@@ -0,0 +1,87 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <sdbusplus/bus.hpp>
+
+#include <map>
+#include <optional>
+#include <string>
+
+namespace phosphor::fan::monitor
+{
+
+/**
+ * @class InventorySnapshot
+ *
+ * Reads the inventory state the fans and their rotors start out from in
+ * bulk when the configuration is loaded, instead of with a mapper lookup
+ * and a property read per fan and per rotor.
+ *
+ * A single mapper GetSubTree call finds the inventory objects that have
+ * an OperationalStatus interface, and the inventory manager is asked once
+ * for all of its managed objects. Only the objects other services hold
+ * are read individually.
+ */
+class InventorySnapshot
+{
+  public:
+    InventorySnapshot() = delete;
+    ~InventorySnapshot() = default;
+    InventorySnapshot(const InventorySnapshot&) = delete;
+    InventorySnapshot& operator=(const InventorySnapshot&) = delete;
+    InventorySnapshot(InventorySnapshot&&) = delete;
+    InventorySnapshot& operator=(InventorySnapshot&&) = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * Takes the snapshot.
+     *
+     * @param[in] bus - The sdbusplus bus object
+     */
+    explicit InventorySnapshot(sdbusplus::bus::bus& bus);
+
+    /**
+     * @brief Get an inventory object's functional state
+     *
+     * @param[in] path - The inventory object path
+     *
+     * @return The Functional property value, or std::nullopt if the
+     *         object doesn't have the OperationalStatus interface or
+     *         its value couldn't be read
+     */
+    std::optional<bool> getFunctional(const std::string& path) const;
+
+    /**
+     * @brief Get an inventory object's presence
+     *
+     * @param[in] path - The inventory object path
+     *
+     * @return The Present property value, or std::nullopt if it isn't
+     *         known, in which case it has to be read from the object
+     */
+    std::optional<bool> getPresent(const std::string& path) const;
+
+  private:
+    /* Map of the OperationalStatus object paths to their functional state */
+    std::map<std::string, bool> _functional;
+
+    /* Map of the inventory manager's item paths to their presence */
+    std::map<std::string, bool> _present;
+};
+
+} // namespace phosphor::fan::monitor
@@ -0,0 +1,80 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace phosphor::fan::monitor
+{
+
+// Mapping from object path to the services, with their interfaces,
+// hosting it, as returned by a mapper GetSubTree call
+using ServiceObjects =
+    std::map<std::string, std::map<std::string, std::vector<std::string>>>;
+
+// Set of sensors hosted by a single service
+template <typename Sensor>
+using SensorSet = std::set<std::shared_ptr<Sensor>>;
+
+// Mapping from service name to the sensors it hosts
+template <typename Sensor>
+using SensorIndex = std::map<std::string, SensorSet<Sensor>>;
+
+/**
+ * @brief Add sensors to the index of the services hosting them
+ *
+ * Each sensor is stored once per service that hosts it, so the
+ * per-service NameOwnerChanged matches can all share the one index by
+ * each referencing just their own service's entry.
+ *
+ * @param[in] sensors - The sensors to add, looked up by their name()
+ * @param[in] serviceObjects - The services hosting each sensor path
+ * @param[in,out] index - The index to add the sensors to
+ *
+ * @return The names of the sensors no service was found for
+ */
+template <typename Sensor>
+std::vector<std::string>
+    indexSensors(const std::vector<std::shared_ptr<Sensor>>& sensors,
+                 const ServiceObjects& serviceObjects,
+                 SensorIndex<Sensor>& index)
+{
+    std::vector<std::string> missing;
+
+    for (const auto& sensor : sensors)
+    {
+        const auto itServ = serviceObjects.find(sensor->name());
+        if (serviceObjects.end() == itServ || itServ->second.empty())
+        {
+            missing.push_back(sensor->name());
+            continue;
+        }
+
+        for (const auto& [serviceName, unused] : itServ->second)
+        {
+            // associate service name with sensor
+            index[serviceName].insert(sensor);
+        }
+    }
+
+    return missing;
+}
+
+} // namespace phosphor::fan::monitor
@@ -17,6 +17,7 @@
 
 #include "fan.hpp"
 #include "fan_defs.hpp"
+#include "inventory_snapshot.hpp"
 #include "tach_sensor.hpp"
 #include "trust_manager.hpp"
 #include "types.hpp"
@@ -90,7 +91,10 @@ void System::load()
         auto fanDefs = getFanDefinitions(jsonObj);
         // Retrieve and set trust groups within the trust manager
         setTrustMgr(getTrustGroups(jsonObj));
-        // Clear/set configured fan definitions
+        // Clear/set configured fan definitions, dropping the service
+        // subscriptions that reference the old fans' sensors first
+        _sensorMatch.clear();
+        _sensorMap.clear();
         _fans.clear();
         _fanHealth.clear();
         // Retrieve fan definitions and create fan objects to be monitored
@@ -98,6 +102,10 @@ void System::load()
         setFaultConfig(jsonObj);
         log<level::INFO>("Configuration loaded");
 
+        // Prime the hwmon FFDC cache so the offline fan controller
+        // path doesn't need to walk sysfs before powering off
+        refreshHwmonNames();
+
         _loaded = true;
 #ifdef MONITOR_USE_JSON
     }
@@ -120,9 +128,9 @@ void System::subscribeSensorsToServices()
 {
     namespace match = sdbusplus::bus::match;
 
+    // The matches reference entries in the map, so drop them first
     _sensorMatch.clear();
-
-    SensorMapType sensorMap;
+    _sensorMap.clear();
 
     // build a list of all interfaces, always including the value interface
     // using set automatically guards against duplicates
@@ -149,35 +157,23 @@ void System::subscribeSensorsToServices()
         for (const auto& fan : _fans)
         {
             // For every sensor in each fan
-            for (const auto& sensor : fan->sensors())
+            for (const auto& name :
+                 indexSensors(fan->sensors(), serviceObjects, _sensorMap))
             {
-                const auto itServ = serviceObjects.find(sensor->name());
-
-                if (serviceObjects.end() == itServ || itServ->second.empty())
-                {
-                    getLogger().log(
-                        fmt::format("Fan sensor entry {} not found in D-Bus",
-                                    sensor->name()),
-                        Logger::error);
-                    continue;
-                }
-
-                for (const auto& [serviceName, unused] : itServ->second)
-                {
-                    // associate service name with sensor
-                    sensorMap[serviceName].insert(sensor);
-                }
+                getLogger().log(
+                    fmt::format("Fan sensor entry {} not found in D-Bus", name),
+                    Logger::error);
             }
         }
 
-        // only create 1 match per service
-        for (const auto& [serviceName, unused] : sensorMap)
+        // only create 1 match per service, each referencing just
+        // that service's sensors instead of a copy of the whole map
+        for (const auto& [serviceName, sensors] : _sensorMap)
         {
-            // map its service name to the sensor
             _sensorMatch.emplace_back(std::make_unique<match::match>(
                 _bus, match::rules::nameOwnerChanged(serviceName),
                 std::bind(&System::tachSignalOffline, this,
-                          std::placeholders::_1, sensorMap)));
+                          std::placeholders::_1, std::cref(sensors))));
         }
     }
     catch (const util::DBusError&)
@@ -256,6 +252,9 @@ const std::vector<FanDefinition> System::getFanDefinitions(const json& jsonObj)
 
 void System::setFans(const std::vector<FanDefinition>& fanDefs)
 {
+    // Read the fans' and rotors' inventory state once for all of them
+    InventorySnapshot inventory{_bus};
+
     for (const auto& fanDef : fanDefs)
     {
         // Check if a condition exists on the fan
@@ -269,7 +268,8 @@ void System::setFans(const std::vector<FanDefinition>& fanDefs)
             }
         }
         _fans.emplace_back(
-            std::make_unique<Fan>(_mode, _bus, _event, _trust, fanDef, *this));
+            std::make_unique<Fan>(_mode, _bus, _event, _trust, fanDef, *this,
+                                  inventory));
 
         updateFanHealth(*(_fans.back()));
     }
@@ -280,7 +280,7 @@ void System::setFans(const std::vector<FanDefinition>& fanDefs)
 // to new state
 //
 void System::tachSignalOffline(sdbusplus::message::message& msg,
-                               SensorMapType const& sensorMap)
+                               const SensorSetType& sensors)
 {
     std::string serviceName, oldOwner, newOwner;
 
@@ -296,16 +296,16 @@ void System::tachSignalOffline(sdbusplus::message::message& msg,
                                 serviceName, stateStr),
                     Logger::info);
 
-    auto sensorItr(sensorMap.find(serviceName));
+    // The hwmon devices behind the service may have changed, so have the
+    // next FFDC collection walk sysfs again instead of doing it for every
+    // service that restarts
+    invalidateHwmonNames();
 
-    if (sensorItr != sensorMap.end())
+    // set all of the service's sensors to the new owner state
+    for (auto& sensor : sensors)
     {
-        // set all sensors' owner state to not-owned
-        for (auto& sensor : sensorItr->second)
-        {
-            sensor->setOwner(hasOwner);
-            sensor->getFan().process(*sensor);
-        }
+        sensor->setOwner(hasOwner);
+        sensor->getFan().process(*sensor);
     }
 }
 
@@ -19,6 +19,7 @@
 #include "fan_error.hpp"
 #include "power_off_rule.hpp"
 #include "power_state.hpp"
+#include "sensor_index.hpp"
 #include "tach_sensor.hpp"
 #include "trust_manager.hpp"
 #include "types.hpp"
@@ -37,9 +38,11 @@ namespace phosphor::fan::monitor
 
 using json = nlohmann::json;
 
+// Set of sensors hosted by a single service
+using SensorSetType = SensorSet<TachSensor>;
+
 // Mapping from service name to sensor
-using SensorMapType =
-    std::map<std::string, std::set<std::shared_ptr<TachSensor>>>;
+using SensorMapType = SensorIndex<TachSensor>;
 
 class System
 {
@@ -189,6 +192,15 @@ class System
      */
     ThermalAlertObject _thermalAlert;
 
+    /**
+     * @brief The service to sensors index shared by all of the
+     *        NameOwnerChanged matches in _sensorMatch.
+     *
+     * Each match references only its own service's entry, so this
+     * must outlive (and not be modified while) the matches exist.
+     */
+    SensorMapType _sensorMap;
+
     /**
      * @brief The tach sensors D-Bus match objects
      */
@@ -258,10 +270,10 @@ class System
      *
      * @param[in] msg - D-Bus message containing details (inc. service name)
      *
-     * @param[in] sensorMap - map providing sensor access for each service
+     * @param[in] sensors - the sensors hosted by the service in the message
      */
     void tachSignalOffline(sdbusplus::message::message& msg,
-                           const SensorMapType& sensorMap);
+                           const SensorSetType& sensors);
 
     /**
      * @brief The function that runs when the power state changes
@@ -16,6 +16,7 @@
 #include "tach_sensor.hpp"
 
 #include "fan.hpp"
+#include "inventory_snapshot.hpp"
 #include "sdbusplus.hpp"
 #include "utility.hpp"
 
@@ -76,7 +77,8 @@ TachSensor::TachSensor(Mode mode, sdbusplus::bus::bus& bus, Fan& fan,
                        int64_t offset, size_t method, size_t threshold,
                        bool ignoreAboveMax, size_t timeout,
                        const std::optional<size_t>& errorDelay,
-                       size_t countInterval, const sdeventplus::Event& event) :
+                       size_t countInterval, const sdeventplus::Event& event,
+                       const InventorySnapshot& inventory) :
     _bus(bus),
     _fan(fan), _name(FAN_SENSOR_PATH + id),
     _invName(fs::path(fan.getName()) / id), _hasTarget(hasTarget),
@@ -97,28 +99,10 @@ TachSensor::TachSensor(Mode mode, sdbusplus::bus::bus& bus, Fan& fan,
         _prevTargets.resize(MAX_PREV_TARGETS);
     }
 
-    _functional = true;
-
-    try
-    {
-        // see if any object paths in the inventory have the
-        // OperationalStatus interface.
-        auto subtree = util::SDBusPlus::getSubTreeRaw(
-            _bus, util::INVENTORY_PATH, util::OPERATIONAL_STATUS_INTF, 0);
-
-        // if the tach sensor's entry already exists, we for sure can
-        // read its functional state from the inventory
-        if (subtree.end() != subtree.find(util::INVENTORY_PATH + _invName))
-        {
-            _functional = util::SDBusPlus::getProperty<bool>(
-                _bus, util::INVENTORY_PATH + _invName,
-                util::OPERATIONAL_STATUS_INTF, util::FUNCTIONAL_PROPERTY);
-        }
-    }
-    catch (const util::DBusError& e)
-    {
-        log<level::DEBUG>(e.what());
-    }
+    // if the tach sensor's entry already exists, we for sure can
+    // read its functional state from the inventory
+    _functional =
+        inventory.getFunctional(util::INVENTORY_PATH + _invName).value_or(true);
 
     updateInventory(_functional);
 
@@ -22,6 +22,7 @@ namespace monitor
 {
 
 class Fan;
+class InventorySnapshot;
 
 constexpr auto FAN_SENSOR_PATH = "/xyz/openbmc_project/sensors/fan_tach/";
 
@@ -104,13 +105,15 @@ class TachSensor
      * @param[in] countInterval - In count mode interval
      *
      * @param[in] event - Event loop reference
+     * @param[in] inventory - The inventory state at load time
      */
     TachSensor(Mode mode, sdbusplus::bus::bus& bus, Fan& fan,
                const std::string& id, bool hasTarget, size_t funcDelay,
                const std::string& interface, double factor, int64_t offset,
                size_t method, size_t threshold, bool ignoreAboveMax,
                size_t timeout, const std::optional<size_t>& errorDelay,
-               size_t countInterval, const sdeventplus::Event& event);
+               size_t countInterval, const sdeventplus::Event& event,
+               const InventorySnapshot& inventory);
 
     /**
      * @brief Reads a property from the input message and stores it in value.
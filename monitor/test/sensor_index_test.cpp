@@ -0,0 +1,188 @@
+#include "../sensor_index.hpp"
+
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::fan::monitor;
+
+namespace
+{
+
+// Bytes allocated while counting is enabled
+bool counting = false;
+size_t allocated = 0;
+
+struct Sensor
+{
+    explicit Sensor(const std::string& path) : _name(path) {}
+
+    const std::string& name() const
+    {
+        return _name;
+    }
+
+    std::string _name;
+};
+
+using Sensors = std::vector<std::shared_ptr<Sensor>>;
+
+constexpr size_t numServices = 8;
+constexpr size_t rotorsPerFan = 2;
+
+std::string sensorPath(size_t fan, size_t rotor)
+{
+    return "/xyz/openbmc_project/sensors/fan_tach/fan" + std::to_string(fan) +
+           "_" + std::to_string(rotor);
+}
+
+// The fans' sensors, with fan N hosted by service N % numServices
+std::vector<Sensors> makeFans(size_t numFans, ServiceObjects& serviceObjects)
+{
+    std::vector<Sensors> fans(numFans);
+    for (size_t fan = 0; fan < numFans; fan++)
+    {
+        auto service = "xyz.openbmc_project.Hwmon-" +
+                       std::to_string(fan % numServices) + ".Hwmon1";
+        for (size_t rotor = 0; rotor < rotorsPerFan; rotor++)
+        {
+            auto path = sensorPath(fan, rotor);
+            fans[fan].push_back(std::make_shared<Sensor>(path));
+            serviceObjects[path][service] = {
+                "xyz.openbmc_project.Sensor.Value"};
+        }
+    }
+    return fans;
+}
+
+struct Owner
+{
+    void ownerChanged(int, const SensorSet<Sensor>& sensors)
+    {
+        count += sensors.size();
+    }
+
+    size_t count = 0;
+};
+
+struct Usage
+{
+    // Bytes allocated building the index
+    size_t index;
+    // Bytes allocated creating the per-service owner callbacks
+    size_t callbacks;
+};
+
+// Index the fans and create a callback per service the way System does
+Usage measure(size_t numFans, Owner& owner)
+{
+    ServiceObjects serviceObjects;
+    auto fans = makeFans(numFans, serviceObjects);
+
+    SensorIndex<Sensor> index;
+    std::vector<std::function<void(int)>> callbacks;
+    callbacks.reserve(numServices);
+
+    Usage usage;
+    allocated = 0;
+    counting = true;
+    for (const auto& sensors : fans)
+    {
+        EXPECT_TRUE(indexSensors(sensors, serviceObjects, index).empty());
+    }
+    usage.index = allocated;
+
+    allocated = 0;
+    for (const auto& [serviceName, sensors] : index)
+    {
+        callbacks.emplace_back(std::bind(&Owner::ownerChanged, &owner,
+                                         std::placeholders::_1,
+                                         std::cref(sensors)));
+    }
+    usage.callbacks = allocated;
+    counting = false;
+
+    EXPECT_EQ(index.size(), numServices);
+    for (auto& callback : callbacks)
+    {
+        callback(0);
+    }
+    return usage;
+}
+
+} // namespace
+
+void* operator new(size_t size)
+{
+    if (counting)
+    {
+        allocated += size;
+    }
+    if (auto* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+TEST(SensorIndexTest, MissingSensor)
+{
+    ServiceObjects serviceObjects;
+    auto fans = makeFans(1, serviceObjects);
+    serviceObjects.erase(sensorPath(0, 1));
+
+    SensorIndex<Sensor> index;
+    auto missing = indexSensors(fans[0], serviceObjects, index);
+
+    ASSERT_EQ(missing.size(), 1);
+    EXPECT_EQ(missing[0], sensorPath(0, 1));
+    ASSERT_EQ(index.size(), 1);
+    EXPECT_EQ(index.begin()->second.size(), 1);
+}
+
+TEST(SensorIndexTest, MultipleServices)
+{
+    ServiceObjects serviceObjects;
+    auto fans = makeFans(1, serviceObjects);
+    serviceObjects[sensorPath(0, 0)]["xyz.openbmc_project.Other"] = {};
+
+    SensorIndex<Sensor> index;
+    EXPECT_TRUE(indexSensors(fans[0], serviceObjects, index).empty());
+
+    ASSERT_EQ(index.size(), 2);
+    EXPECT_EQ(index["xyz.openbmc_project.Other"].size(), 1);
+}
+
+TEST(SensorIndexTest, Memory64Fans8Services)
+{
+    Owner owner64;
+    auto usage64 = measure(64, owner64);
+    EXPECT_EQ(owner64.count, 64 * rotorsPerFan);
+
+    Owner owner128;
+    auto usage128 = measure(128, owner128);
+    EXPECT_EQ(owner128.count, 128 * rotorsPerFan);
+
+    // Each sensor is only stored once, so the index grows linearly
+    EXPECT_GT(usage64.index, 0);
+    EXPECT_LE(usage128.index, 2 * usage64.index);
+
+    // The callbacks only reference their service's sensors, so they
+    // cost the same however many fans there are, and together less
+    // than a single service's share of the index
+    EXPECT_EQ(usage128.callbacks, usage64.callbacks);
+    EXPECT_LT(usage64.callbacks, usage64.index / numServices);
+}
@@ -25,6 +25,7 @@
 #include <xyz/openbmc_project/Common/Callout/error.hpp>
 #include <xyz/openbmc_project/Logging/Entry/server.hpp>
 
+#include <algorithm>
 #include <functional>
 #include <tuple>
 
@@ -39,29 +40,106 @@ const auto loggingService = "xyz.openbmc_project.Logging";
 const auto loggingPath = "/xyz/openbmc_project/logging";
 const auto loggingCreateIface = "xyz.openbmc_project.Logging.Create";
 
+std::map<std::string, std::weak_ptr<GpioDevice>> GpioDevice::devices;
+
+GpioDevice::GpioDevice(const std::string& device) :
+    evdevfd(open(device.c_str(), O_RDONLY | O_NONBLOCK)),
+    evdev(evdevpp::evdev::newFromFD(evdevfd()))
+{
+    // Use the same clock as the sdevent timers for the event timestamps
+    evdev.setClockId(CLOCK_MONOTONIC);
+}
+
+std::shared_ptr<GpioDevice> GpioDevice::get(const std::string& device)
+{
+    auto dev = devices[device].lock();
+    if (!dev)
+    {
+        dev = std::make_shared<GpioDevice>(device);
+        devices[device] = dev;
+    }
+    return dev;
+}
+
+void GpioDevice::addListener(Gpio& gpio)
+{
+    if (std::find(listeners.begin(), listeners.end(), &gpio) !=
+        listeners.end())
+    {
+        return;
+    }
+
+    listeners.push_back(&gpio);
+
+    if (!source)
+    {
+        source.emplace(sdeventplus::Event::get_default(), evdevfd(), EPOLLIN,
+                       std::bind(&GpioDevice::ioCallback, this));
+    }
+}
+
+void GpioDevice::removeListener(Gpio& gpio)
+{
+    std::erase(listeners, &gpio);
+
+    if (listeners.empty())
+    {
+        source.reset();
+    }
+}
+
+void GpioDevice::ioCallback()
+{
+    // Read everything queued, e.g. when a whole tray of
+    // fans is seated at once, instead of one event per wakeup.
+    auto events = evdev.drain();
+
+    // Copy in case a listener is removed as a result of an update
+    auto gpios = listeners;
+    for (auto gpio : gpios)
+    {
+        std::vector<struct input_event> pinEvents;
+        std::copy_if(events.begin(), events.end(),
+                     std::back_inserter(pinEvents), [gpio](const auto& ev) {
+                         return ev.type == EV_KEY && ev.code == gpio->getPin();
+                     });
+
+        if (!pinEvents.empty())
+        {
+            gpio->eventsReceived(pinEvents);
+        }
+    }
+}
+
 Gpio::Gpio(const std::string& physDevice, const std::string& device,
-           unsigned int physPin) :
+           unsigned int physPin, std::chrono::milliseconds debounce) :
     currentState(false),
-    evdevfd(open(device.c_str(), O_RDONLY | O_NONBLOCK)),
-    evdev(evdevpp::evdev::newFromFD(evdevfd())), phys(physDevice), pin(physPin)
+    inputDevice(GpioDevice::get(device)), phys(physDevice), pin(physPin),
+    debounce(debounce)
 {}
 
+Gpio::~Gpio()
+{
+    inputDevice->removeListener(*this);
+}
+
 bool Gpio::start()
 {
-    source.emplace(sdeventplus::Event::get_default(), evdevfd(), EPOLLIN,
-                   std::bind(&Gpio::ioCallback, this));
+    inputDevice->addListener(*this);
     currentState = present();
     return currentState;
 }
 
 void Gpio::stop()
 {
-    source.reset();
+    inputDevice->removeListener(*this);
+    pending.reset();
+    debounceTimer.reset();
 }
 
 bool Gpio::present()
 {
-    return evdev.fetch(EV_KEY, pin) != 0;
+    return inputDevice->present(pin);
 }
 
 void Gpio::fail()
@@ -75,18 +153,57 @@ void Gpio::fail()
         GPIO::CALLOUT_DEVICE_PATH(phys.c_str()));
 }
 
-void Gpio::ioCallback()
+void Gpio::eventsReceived(const std::vector<struct input_event>& events)
 {
-    unsigned int type, code, value;
+    using namespace std::chrono;
 
-    std::tie(type, code, value) = evdev.next();
-    if (type != EV_KEY || code != pin)
+    for (const auto& ev : events)
     {
+        auto time = seconds{ev.input_event_sec} +
+                    microseconds{ev.input_event_usec};
+
+        // The previous state settled if it held for the whole
+        // window before this event came in.
+        if (pending && (time - pending->second >= debounce))
+        {
+            settle(pending->first);
+        }
+
+        pending = std::make_pair(ev.value != 0, time);
+    }
+
+    if (debounce.count() == 0)
+    {
+        settle(pending->first);
+        pending.reset();
         return;
     }
 
-    bool newState = value != 0;
+    // Wait out the rest of the window for the latest state
+    auto now = duration_cast<microseconds>(
+        steady_clock::now().time_since_epoch());
+    auto remaining = std::max(debounce - (now - pending->second),
+                              microseconds{0});
+
+    if (!debounceTimer)
+    {
+        debounceTimer.emplace(sdeventplus::Event::get_default(),
+                              std::bind(&Gpio::debounceExpired, this));
+    }
+    debounceTimer->restartOnce(remaining);
+}
+
+void Gpio::debounceExpired()
+{
+    if (pending)
+    {
+        settle(pending->first);
+        pending.reset();
+    }
+}
 
+void Gpio::settle(bool newState)
+{
     if (currentState != newState)
     {
         getPolicy().stateChanged(newState, *this);
@@ -4,9 +4,15 @@
 #include "psensor.hpp"
 #include "utility.hpp"
 
+#include <sdeventplus/clock.hpp>
 #include <sdeventplus/source/io.hpp>
+#include <sdeventplus/utility/timer.hpp>
 
+#include <chrono>
+#include <map>
+#include <memory>
 #include <optional>
+#include <vector>
 
 namespace phosphor
 {
@@ -15,6 +21,82 @@ namespace fan
 namespace presence
 {
 class RedundancyPolicy;
+class Gpio;
+
+/**
+ * @class GpioDevice
+ * @brief A gpio-keys input device shared by Gpio sensors.
+ *
+ * All of the Gpio sensors on the same input device share the one
+ * file descriptor and sdevent io source.  Every wakeup drains all
+ * of the pending events and hands each sensor the events for its pin.
+ */
+class GpioDevice
+{
+  public:
+    GpioDevice() = delete;
+    GpioDevice(const GpioDevice&) = delete;
+    GpioDevice& operator=(const GpioDevice&) = delete;
+    GpioDevice(GpioDevice&&) = delete;
+    GpioDevice& operator=(GpioDevice&&) = delete;
+    ~GpioDevice() = default;
+
+    /**
+     * @brief Construct a gpio-keys input device.
+     *
+     * Event timestamps are taken from the monotonic clock.
+     *
+     * @param[in] device - The gpio-keys input device.
+     */
+    explicit GpioDevice(const std::string& device);
+
+    /**
+     * @brief Get the shared device object for the input device,
+     *        creating it if necessary.
+     *
+     * @param[in] device - The gpio-keys input device.
+     */
+    static std::shared_ptr<GpioDevice> get(const std::string& device);
+
+    /**
+     * @brief Start delivering events for the sensor's pin to it.
+     *
+     * @param[in] gpio - The sensor.
+     */
+    void addListener(Gpio& gpio);
+
+    /**
+     * @brief Stop delivering events to the sensor.
+     *
+     * @param[in] gpio - The sensor.
+     */
+    void removeListener(Gpio& gpio);
+
+    /** @brief Get the current state of the pin. */
+    bool present(unsigned int pin)
+    {
+        return evdev.fetch(EV_KEY, pin) != 0;
+    }
+
+  private:
+    /** @brief sdevent io callback. */
+    void ioCallback();
+
+    /** Gpio event device file descriptor. */
+    util::FileDescriptor evdevfd;
+
+    /** Gpio event device. */
+    evdevpp::evdev::EvDev evdev;
+
+    /** The sensors receiving events. */
+    std::vector<Gpio*> listeners;
+
+    /** sdevent io handle, only enabled while there are listeners. */
+    std::optional<sdeventplus::source::IO> source;
+
+    /** The devices in use, by input device path. */
+    static std::map<std::string, std::weak_ptr<GpioDevice>> devices;
+};
 
 /**
  * @class Gpio
@@ -36,7 +118,7 @@ class Gpio : public PresenceSensor
     Gpio& operator=(const Gpio&) = delete;
     Gpio(Gpio&&) = delete;
     Gpio& operator=(Gpio&&) = delete;
-    ~Gpio() = default;
+    ~Gpio();
 
     /**
      * @brief Construct a gpio sensor.
@@ -44,9 +126,13 @@ class Gpio : public PresenceSensor
      * @param[in] physDevice - The physical gpio device path.
      * @param[in] device - The gpio-keys input device.
      * @param[in] physPin - The physical gpio pin number.
+     * @param[in] debounce - How long a new pin state must hold,
+     *                       going by the event timestamps, before
+     *                       it is reported.
      */
     Gpio(const std::string& physDevice, const std::string& device,
-         unsigned int physPin);
+         unsigned int physPin,
+         std::chrono::milliseconds debounce = std::chrono::milliseconds{0});
 
     /**
      * @brief start
@@ -86,21 +172,41 @@ class Gpio : public PresenceSensor
      */
     void logConflict(const std::string& fanInventoryPath) const override;
 
+    /** @brief The gpio pin number. */
+    unsigned int getPin() const
+    {
+        return pin;
+    }
+
+    /**
+     * @brief Called by the device with the events for this pin
+     *        read during a single wakeup, oldest first.
+     *
+     * @param[in] events - The pin's events
+     */
+    void eventsReceived(const std::vector<struct input_event>& events);
+
   private:
+    using Timer = sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>;
+
     /** @brief Get the policy associated with this sensor. */
     virtual RedundancyPolicy& getPolicy() = 0;
 
-    /** @brief sdevent io callback. */
-    void ioCallback();
+    /**
+     * @brief Report the new state to the policy if it changed.
+     *
+     * @param[in] newState - The settled state
+     */
+    void settle(bool newState);
+
+    /** @brief Debounce timer callback. */
+    void debounceExpired();
 
     /** The current state of the sensor. */
     bool currentState;
 
-    /** Gpio event device file descriptor. */
-    util::FileDescriptor evdevfd;
-
-    /** Gpio event device. */
-    evdevpp::evdev::EvDev evdev;
+    /** The shared gpio event device. */
+    std::shared_ptr<GpioDevice> inputDevice;
 
     /** Physical gpio device. */
     std::string phys;
@@ -108,8 +214,14 @@ class Gpio : public PresenceSensor
     /** Gpio pin number. */
     unsigned int pin;
 
-    /** sdevent io handle. */
-    std::optional<sdeventplus::source::IO> source;
+    /** The debounce window. */
+    std::chrono::milliseconds debounce;
+
+    /** The last, not yet settled, state and its event timestamp. */
+    std::optional<std::pair<bool, std::chrono::microseconds>> pending;
+
+    /** Fires when the pending state has held for the debounce window. */
+    std::optional<Timer> debounceTimer;
 };
 
 /**
@@ -271,10 +271,17 @@ std::unique_ptr<PresenceSensor> getGpio(size_t fanIndex, const json& method)
     auto devpath = method["devpath"].get<std::string>();
     auto key = method["key"].get<unsigned int>();
 
+    std::chrono::milliseconds debounce{0};
+    if (method.contains("debounce_time"))
+    {
+        debounce = std::chrono::milliseconds{
+            method["debounce_time"].get<uint64_t>()};
+    }
+
     try
     {
         return std::make_unique<PolicyAccess<Gpio, JsonConfig>>(
-            fanIndex, physpath, devpath, key);
+            fanIndex, physpath, devpath, key, debounce);
     }
     catch (const sdbusplus::exception_t& e)
     {
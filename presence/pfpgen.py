@@ -140,6 +140,7 @@ class Gpio(Sensor, Renderer):
         self.key = kw.pop('key')
         self.physpath = kw.pop('physpath')
         self.devpath = kw.pop('devpath')
+        self.debounce = kw.pop('debounce_time', 0)
         kw['name'] = 'gpio-{}'.format(self.key)
         super(Gpio, self).__init__(**kw)
 
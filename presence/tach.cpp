@@ -22,6 +22,7 @@
 
 #include <phosphor-logging/log.hpp>
 
+#include <algorithm>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -40,34 +41,129 @@ static const auto tachNamespace = "/xyz/openbmc_project/sensors/fan_tach/"s;
 static const auto tachIface = "xyz.openbmc_project.Sensor.Value"s;
 static const auto tachProperty = "Value"s;
 
-Tach::Tach(const std::vector<std::string>& sensors) : currentState(false)
+// How long a cached reading is trusted before it is read from D-Bus again.
+// Tach sensors only signal when their value changes, so a fan sitting at
+// the same speed will eventually need a live read.
+static constexpr auto maxReadingAge = std::chrono::seconds{10};
+
+TachCache::TachCache() :
+    match(util::SDBusPlus::getBus(),
+          "type='signal',member='PropertiesChanged',"
+          "path_namespace='" +
+              tachNamespace.substr(0, tachNamespace.size() - 1) +
+              "',arg0='" + tachIface + "'",
+          std::bind(&TachCache::propertiesChanged, this,
+                    std::placeholders::_1))
+{}
+
+std::shared_ptr<TachCache> TachCache::get()
+{
+    static std::weak_ptr<TachCache> instance;
+
+    auto cache = instance.lock();
+    if (!cache)
+    {
+        cache = std::shared_ptr<TachCache>(new TachCache());
+        instance = cache;
+    }
+    return cache;
+}
+
+double TachCache::reading(const std::string& sensor)
+{
+    auto now = std::chrono::steady_clock::now();
+    auto it = readings.find(sensor);
+    if ((it != readings.end()) && (now - it->second.second < maxReadingAge))
+    {
+        return it->second.first;
+    }
+
+    auto value = util::SDBusPlus::getProperty<double>(tachNamespace + sensor,
+                                                      tachIface, tachProperty);
+    readings[sensor] = std::make_pair(value, now);
+    return value;
+}
+
+void TachCache::subscribe(const std::string& sensor, Tach& tach)
+{
+    auto& tachs = subscribers[sensor];
+    if (std::find(tachs.begin(), tachs.end(), &tach) == tachs.end())
+    {
+        tachs.push_back(&tach);
+    }
+}
+
+void TachCache::unsubscribe(Tach& tach)
+{
+    for (auto& [sensor, tachs] : subscribers)
+    {
+        std::erase(tachs, &tach);
+    }
+}
+
+void TachCache::propertiesChanged(sdbusplus::message::message& msg)
+{
+    std::string iface;
+    util::Properties<double> properties;
+    msg.read(iface, properties);
+
+    // Find the Value property containing the speed.
+    auto it = properties.find(tachProperty);
+    if (it == properties.end())
+    {
+        return;
+    }
+
+    std::string path = msg.get_path();
+    if (!path.starts_with(tachNamespace))
+    {
+        return;
+    }
+    auto sensor = path.substr(tachNamespace.size());
+    auto value = std::get<double>(it->second);
+
+    readings[sensor] = std::make_pair(value, std::chrono::steady_clock::now());
+
+    auto subs = subscribers.find(sensor);
+    if (subs != subscribers.end())
+    {
+        // Copy in case a Tach unsubscribes as a result of the change
+        auto tachs = subs->second;
+        for (auto tach : tachs)
+        {
+            tach->readingChanged(sensor, value);
+        }
+    }
+}
+
+Tach::Tach(const std::vector<std::string>& sensors) :
+    cache(TachCache::get()), currentState(false)
 {
     // Initialize state.
     for (const auto& s : sensors)
     {
-        state.emplace_back(s, nullptr, 0);
+        state.emplace_back(s, 0);
     }
 }
 
+Tach::~Tach()
+{
+    cache->unsubscribe(*this);
+}
+
 bool Tach::start()
 {
-    for (size_t i = 0; i < state.size(); ++i)
+    for (auto& s : state)
     {
-        auto& s = state[i];
-        auto tachPath = tachNamespace + std::get<std::string>(s);
+        const auto& sensor = std::get<std::string>(s);
 
-        // Register for signal callbacks.
-        std::get<1>(s) = std::make_unique<sdbusplus::bus::match::match>(
-            util::SDBusPlus::getBus(),
-            sdbusplus::bus::match::rules::propertiesChanged(tachPath,
-                                                            tachIface),
-            [this, i](auto& msg) { this->propertiesChanged(i, msg); });
+        // Register for reading changes.
+        cache->subscribe(sensor, *this);
 
         // Get an initial tach speed.
         try
         {
-            std::get<double>(s) = util::SDBusPlus::getProperty<double>(
-                tachPath, tachIface, tachProperty);
+            std::get<double>(s) = cache->reading(sensor);
         }
         catch (const std::exception&)
         {
@@ -75,7 +171,8 @@ bool Tach::start()
 
             std::get<double>(s) = 0;
             log<level::INFO>(
-                fmt::format("Unable to read fan tach sensor {}", tachPath)
+                fmt::format("Unable to read fan tach sensor {}",
+                            tachNamespace + sensor)
                     .c_str());
         }
     }
@@ -90,56 +187,38 @@ bool Tach::start()
 
 void Tach::stop()
 {
-    for (auto& s : state)
-    {
-        // De-register signal callbacks.
-        std::get<1>(s) = nullptr;
-    }
+    // De-register reading change callbacks.
+    cache->unsubscribe(*this);
 }
 
 bool Tach::present()
 {
-    // Live query the tach readings.
-    std::vector<double> values;
-    for (const auto& s : state)
-    {
-        values.push_back(util::SDBusPlus::getProperty<double>(
-            tachNamespace + std::get<std::string>(s), tachIface, tachProperty));
-    }
-
-    return std::any_of(values.begin(), values.end(),
-                       [](const auto& v) { return v != 0; });
-}
-
-void Tach::propertiesChanged(size_t sensor, sdbusplus::message::message& msg)
-{
-    std::string iface;
-    util::Properties<double> properties;
-    msg.read(iface, properties);
-
-    propertiesChanged(sensor, properties);
+    // Use the cached tach readings, which fall back
+    // to a live query when they are stale.
+    return std::any_of(state.begin(), state.end(), [this](const auto& s) {
+        return cache->reading(std::get<std::string>(s)) != 0;
+    });
 }
 
-void Tach::propertiesChanged(size_t sensor,
-                             const util::Properties<double>& props)
+void Tach::readingChanged(const std::string& sensor, double value)
 {
-    // Find the Value property containing the speed.
-    auto it = props.find(tachProperty);
-    if (it != props.end())
+    for (auto& s : state)
     {
-        auto& s = state[sensor];
-        std::get<double>(s) = std::get<double>(it->second);
-
-        auto newState =
-            std::any_of(state.begin(), state.end(),
-                        [](const auto& s) { return std::get<double>(s) != 0; });
-
-        if (currentState != newState)
+        if (std::get<std::string>(s) == sensor)
         {
-            getPolicy().stateChanged(newState, *this);
-            currentState = newState;
+            std::get<double>(s) = value;
         }
     }
+
+    auto newState =
+        std::any_of(state.begin(), state.end(),
+                    [](const auto& s) { return std::get<double>(s) != 0; });
+
+    if (currentState != newState)
+    {
+        getPolicy().stateChanged(newState, *this);
+        currentState = newState;
+    }
 }
 
 void Tach::logConflict(const std::string& fanInventoryPath) const
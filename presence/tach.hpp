@@ -6,6 +6,9 @@
 #include <sdbusplus/bus/match.hpp>
 #include <sdbusplus/message.hpp>
 
+#include <chrono>
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -16,6 +19,79 @@ namespace fan
 namespace presence
 {
 class RedundancyPolicy;
+class Tach;
+
+/**
+ * @class TachCache
+ * @brief Process wide cache of the fan tach sensor readings.
+ *
+ * A single PropertiesChanged match over the whole fan tach sensor
+ * namespace keeps the readings current and forwards them to the
+ * Tach sensors that subscribed to them, so presence checks can be
+ * answered without going out to D-Bus.
+ */
+class TachCache
+{
+  public:
+    TachCache(const TachCache&) = delete;
+    TachCache& operator=(const TachCache&) = delete;
+    TachCache(TachCache&&) = delete;
+    TachCache& operator=(TachCache&&) = delete;
+    ~TachCache() = default;
+
+    /**
+     * @brief Get the cache instance, creating it if necessary
+     */
+    static std::shared_ptr<TachCache> get();
+
+    /**
+     * @brief Get the sensor's reading
+     *
+     * Cached readings older than the staleness bound, and sensors
+     * that haven't been read yet, are read from D-Bus instead.
+     *
+     * @param[in] sensor - The fan tach sensor name
+     *
+     * @return The tach reading
+     */
+    double reading(const std::string& sensor);
+
+    /**
+     * @brief Have the sensor's reading changes forwarded to the Tach
+     *
+     * @param[in] sensor - The fan tach sensor name
+     * @param[in] tach - The Tach sensor to forward them to
+     */
+    void subscribe(const std::string& sensor, Tach& tach);
+
+    /**
+     * @brief Stop forwarding any reading changes to the Tach
+     *
+     * @param[in] tach - The Tach sensor
+     */
+    void unsubscribe(Tach& tach);
+
+  private:
+    TachCache();
+
+    /**
+     * @brief Properties changed handler for all tach sensors
+     *
+     * @param[in] msg - The sdbusplus signal message.
+     */
+    void propertiesChanged(sdbusplus::message::message& msg);
+
+    /** @brief The readings and when they were last updated, by sensor. */
+    std::map<std::string,
+             std::pair<double, std::chrono::steady_clock::time_point>>
+        readings;
+
+    /** @brief The Tach sensors subscribed to each sensor. */
+    std::map<std::string, std::vector<Tach*>> subscribers;
+
+    /** @brief The match on all tach sensor Value changes. */
+    sdbusplus::bus::match::match match;
+};
 
 /**
  * @class Tach
@@ -38,7 +114,7 @@ class Tach : public PresenceSensor
     Tach& operator=(const Tach&) = delete;
     Tach(Tach&&) = delete;
     Tach& operator=(Tach&&) = delete;
-    ~Tach() = default;
+    ~Tach();
 
     /**
      * @brief ctor
@@ -78,34 +154,25 @@ class Tach : public PresenceSensor
      */
     void logConflict(const std::string& fanInventoryPath) const override;
 
-  private:
     /**
-     * @brief Get the policy associated with this sensor.
-     */
-    virtual RedundancyPolicy& getPolicy() = 0;
-
-    /**
-     * @brief Properties changed handler for tach sensor updates.
+     * @brief Called by the TachCache when a tach reading changes.
      *
      * @param[in] sensor - The sensor that changed.
-     * @param[in] props - The properties that changed.
+     * @param[in] value - The new tach reading.
      */
-    void
-        propertiesChanged(size_t sensor,
-                          const phosphor::fan::util::Properties<double>& props);
+    void readingChanged(const std::string& sensor, double value);
 
+  private:
     /**
-     * @brief Properties changed handler for tach sensor updates.
-     *
-     * @param[in] sensor - The sensor that changed.
-     * @param[in] msg - The sdbusplus signal message.
+     * @brief Get the policy associated with this sensor.
      */
-    void propertiesChanged(size_t sensor, sdbusplus::message::message& msg);
+    virtual RedundancyPolicy& getPolicy() = 0;
+
+    /** @brief array of tach sensor names and tach values. */
+    std::vector<std::tuple<std::string, double>> state;
 
-    /** @brief array of tach sensors dbus matches, and tach values. */
-    std::vector<std::tuple<
-        std::string, std::unique_ptr<sdbusplus::bus::match::match>, double>>
-        state;
+    /** @brief The shared tach reading cache. */
+    std::shared_ptr<TachCache> cache;
 
     /** The current state of the sensor. */
     bool currentState;
@@ -1,2 +1,3 @@
 std::make_unique<PolicyAccess<Gpio, ConfigPolicy>>(
-${indent(1)}${g.policy}, "${g.physpath}"s, "${g.devpath}"s, ${g.key})\
+${indent(1)}${g.policy}, "${g.physpath}"s, "${g.devpath}"s, ${g.key},
+${indent(1)}std::chrono::milliseconds{${g.debounce}})\
@@ -0,0 +1,257 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "alarm_snapshot.hpp"
+
+#include "sdbusplus.hpp"
+
+#include <fmt/format.h>
+
+#include <phosphor-logging/log.hpp>
+
+#include <algorithm>
+#include <variant>
+
+namespace sensor::monitor
+{
+
+using namespace phosphor::logging;
+using namespace phosphor::fan::util;
+
+constexpr auto objectManagerInterface = "org.freedesktop.DBus.ObjectManager";
+constexpr auto propertiesInterface = "org.freedesktop.DBus.Properties";
+
+/* The threshold interfaces hold alarm bools and threshold values */
+using PropertyValue = std::variant<bool, double, int64_t, uint64_t, int32_t,
+                                   uint32_t, int16_t, uint16_t, uint8_t,
+                                   std::string>;
+
+namespace
+{
+
+/**
+ * @brief Find the ObjectManager managing an object
+ *
+ * @param[in] objMgrPaths - Paths of a service's ObjectManagers
+ * @param[in] path - The object path
+ *
+ * @return The closest ObjectManager path at or above the object, or
+ *         std::nullopt if the object isn't managed
+ */
+std::optional<std::string>
+    findObjectManager(const std::vector<std::string>& objMgrPaths,
+                      const std::string& path)
+{
+    std::optional<std::string> objMgr;
+    for (const auto& objMgrPath : objMgrPaths)
+    {
+        auto isAncestor =
+            (objMgrPath == "/") ||
+            ((path.compare(0, objMgrPath.size(), objMgrPath) == 0) &&
+             ((path.size() == objMgrPath.size()) ||
+              (path[objMgrPath.size()] == '/')));
+        if (isAncestor && (!objMgr || (objMgrPath.size() > objMgr->size())))
+        {
+            objMgr = objMgrPath;
+        }
+    }
+    return objMgr;
+}
+
+/**
+ * @brief Keep the bool alarm properties of a set of interface properties
+ *
+ * @param[in] properties - The interface's properties
+ * @param[out] alarms - Filled in with the alarm properties' values
+ */
+void addAlarms(const std::map<std::string, PropertyValue>& properties,
+               std::map<std::string, bool>& alarms)
+{
+    for (const auto& [property, value] : properties)
+    {
+        if (const auto* alarm = std::get_if<bool>(&value))
+        {
+            alarms[property] = *alarm;
+        }
+    }
+}
+
+} // namespace
+
+AlarmSnapshot::AlarmSnapshot(sdbusplus::bus::bus& bus,
+                             const std::vector<std::string>& interfaces)
+{
+    // Find the sensors along with the ObjectManagers of their services
+    auto subTreeIntfs = interfaces;
+    subTreeIntfs.emplace_back(objectManagerInterface);
+    auto objects = SDBusPlus::getSubTreeRaw(bus, "/", subTreeIntfs, 0);
+
+    // Map of services to their ObjectManager paths
+    std::map<std::string, std::vector<std::string>> objMgrs;
+    // Map of services to their sensors' paths and threshold interfaces
+    std::map<std::string, std::map<std::string, std::vector<std::string>>>
+        sensors;
+    for (const auto& [path, services] : objects)
+    {
+        for (const auto& [service, serviceIntfs] : services)
+        {
+            for (const auto& intf : serviceIntfs)
+            {
+                if (intf == objectManagerInterface)
+                {
+                    objMgrs[service].push_back(path);
+                }
+                else if (std::find(interfaces.begin(), interfaces.end(),
+                                   intf) != interfaces.end())
+                {
+                    sensors[service][path].push_back(intf);
+                }
+            }
+        }
+    }
+
+    for (const auto& [service, sensorIntfs] : sensors)
+    {
+        // Group the service's sensors by the ObjectManager managing them
+        std::map<std::string, std::vector<std::string>> managed;
+        std::vector<std::string> unmanaged;
+        for (const auto& sensor : sensorIntfs)
+        {
+            const auto& sensorPath = sensor.first;
+            auto objMgr = findObjectManager(objMgrs[service], sensorPath);
+            if (objMgr)
+            {
+                managed[*objMgr].push_back(sensorPath);
+            }
+            else
+            {
+                unmanaged.push_back(sensorPath);
+            }
+        }
+
+        for (const auto& [objMgr, sensorPaths] : managed)
+        {
+            try
+            {
+                auto managedObjects =
+                    SDBusPlus::getManagedObjects<PropertyValue>(bus, service,
+                                                                objMgr);
+                for (const auto& sensorPath : sensorPaths)
+                {
+                    auto itObject = managedObjects.find(
+                        sdbusplus::message::object_path{sensorPath});
+                    if (itObject == managedObjects.end())
+                    {
+                        continue;
+                    }
+                    for (const auto& intf : sensorIntfs.at(sensorPath))
+                    {
+                        auto itIntf = itObject->second.find(intf);
+                        if (itIntf != itObject->second.end())
+                        {
+                            addAlarms(itIntf->second,
+                                      _alarms[sensorPath][intf]);
+                        }
+                    }
+                }
+            }
+            catch (const std::exception& e)
+            {
+                log<level::INFO>(
+                    fmt::format("Unable to get managed objects of {} from {}, "
+                                "reading its sensors individually",
+                                objMgr, service)
+                        .c_str());
+                unmanaged.insert(unmanaged.end(), sensorPaths.begin(),
+                                 sensorPaths.end());
+            }
+        }
+
+        for (const auto& sensorPath : unmanaged)
+        {
+            readSensor(bus, service, sensorPath, sensorIntfs.at(sensorPath));
+        }
+    }
+}
+
+void AlarmSnapshot::readSensor(sdbusplus::bus::bus& bus,
+                               const std::string& service,
+                               const std::string& sensorPath,
+                               const std::vector<std::string>& interfaces)
+{
+    for (const auto& intf : interfaces)
+    {
+        try
+        {
+            auto properties =
+                SDBusPlus::callMethodAndRead<
+                    std::map<std::string, PropertyValue>>(
+                    bus, service, sensorPath, propertiesInterface, "GetAll",
+                    intf);
+            addAlarms(properties, _alarms[sensorPath][intf]);
+        }
+        catch (const std::exception& e)
+        {
+            // The sensor went away since the mapper lookup
+            continue;
+        }
+    }
+}
+
+std::vector<std::string>
+    AlarmSnapshot::getPaths(const std::string& interface) const
+{
+    std::vector<std::string> paths;
+    for (const auto& [sensorPath, intfs] : _alarms)
+    {
+        if (intfs.find(interface) != intfs.end())
+        {
+            paths.push_back(sensorPath);
+        }
+    }
+    return paths;
+}
+
+bool AlarmSnapshot::hasInterface(const std::string& sensorPath,
+                                 const std::string& interface) const
+{
+    auto itSensor = _alarms.find(sensorPath);
+    return (itSensor != _alarms.end()) &&
+           (itSensor->second.find(interface) != itSensor->second.end());
+}
+
+std::optional<bool> AlarmSnapshot::getAlarm(const std::string& sensorPath,
+                                            const std::string& interface,
+                                            const std::string& property) const
+{
+    auto itSensor = _alarms.find(sensorPath);
+    if (itSensor == _alarms.end())
+    {
+        return std::nullopt;
+    }
+    auto itIntf = itSensor->second.find(interface);
+    if (itIntf == itSensor->second.end())
+    {
+        return std::nullopt;
+    }
+    auto itAlarm = itIntf->second.find(property);
+    if (itAlarm == itIntf->second.end())
+    {
+        return std::nullopt;
+    }
+    return itAlarm->second;
+}
+
+} // namespace sensor::monitor
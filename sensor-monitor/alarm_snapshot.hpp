@@ -0,0 +1,114 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <sdbusplus/bus.hpp>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace sensor::monitor
+{
+
+/**
+ * @class AlarmSnapshot
+ *
+ * Reads the alarm properties of every sensor implementing any of the
+ * given threshold interfaces in bulk, instead of with a mapper lookup and
+ * a property read per alarm.
+ *
+ * A single mapper GetSubTree call finds the sensors along with the
+ * ObjectManagers of the services owning them. Each of those services is
+ * then asked once per ObjectManager for all of its managed objects. Only
+ * the sensors of services without an ObjectManager are read individually,
+ * with a GetAll call per threshold interface.
+ */
+class AlarmSnapshot
+{
+  public:
+    AlarmSnapshot() = delete;
+    ~AlarmSnapshot() = default;
+    AlarmSnapshot(const AlarmSnapshot&) = delete;
+    AlarmSnapshot& operator=(const AlarmSnapshot&) = delete;
+    AlarmSnapshot(AlarmSnapshot&&) = delete;
+    AlarmSnapshot& operator=(AlarmSnapshot&&) = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * Takes the snapshot.
+     *
+     * @param[in] bus - The sdbusplus bus object
+     * @param[in] interfaces - The threshold interfaces to read
+     */
+    AlarmSnapshot(sdbusplus::bus::bus& bus,
+                  const std::vector<std::string>& interfaces);
+
+    /**
+     * @brief Get the paths of the sensors implementing an interface
+     *
+     * @param[in] interface - The threshold interface
+     *
+     * @return The sensor paths
+     */
+    std::vector<std::string> getPaths(const std::string& interface) const;
+
+    /**
+     * @brief Get whether a sensor implements an interface
+     *
+     * @param[in] sensorPath - The sensor path
+     * @param[in] interface - The threshold interface
+     *
+     * @return Whether the interface was found on the sensor
+     */
+    bool hasInterface(const std::string& sensorPath,
+                      const std::string& interface) const;
+
+    /**
+     * @brief Get the value of an alarm property
+     *
+     * @param[in] sensorPath - The sensor path
+     * @param[in] interface - The threshold interface
+     * @param[in] property - The alarm property
+     *
+     * @return The alarm value, or std::nullopt if the sensor doesn't
+     *         have the property
+     */
+    std::optional<bool> getAlarm(const std::string& sensorPath,
+                                 const std::string& interface,
+                                 const std::string& property) const;
+
+  private:
+    /**
+     * @brief Read a sensor's threshold interfaces one at a time
+     *
+     * @param[in] bus - The sdbusplus bus object
+     * @param[in] service - The service owning the sensor
+     * @param[in] sensorPath - The sensor path
+     * @param[in] interfaces - The threshold interfaces on the sensor
+     */
+    void readSensor(sdbusplus::bus::bus& bus, const std::string& service,
+                    const std::string& sensorPath,
+                    const std::vector<std::string>& interfaces);
+
+    /* Map of sensor paths to their threshold interfaces' alarm values */
+    std::map<std::string, std::map<std::string, std::map<std::string, bool>>>
+        _alarms;
+};
+
+} // namespace sensor::monitor
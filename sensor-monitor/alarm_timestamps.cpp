@@ -0,0 +1,483 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "alarm_timestamps.hpp"
+
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <unistd.h>
+
+#include <cereal/archives/json.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/tuple.hpp>
+#include <cereal/types/vector.hpp>
+#include <phosphor-logging/log.hpp>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <tuple>
+
+namespace sensor::monitor
+{
+
+using namespace phosphor::logging;
+namespace fs = std::filesystem;
+
+/* Identifies the journal file format */
+constexpr std::array<uint8_t, 4> journalMagic{'S', 'A', 'J', '1'};
+
+/* Size of a record's payload length and checksum */
+constexpr size_t recordHeaderSize = sizeof(uint16_t) + sizeof(uint32_t);
+
+/* Size of a record's payload not counting the sensor path */
+constexpr size_t recordFixedSize = 3 + sizeof(uint64_t);
+
+/* How long after a change the journal is synced, so that
+ * a burst of changes from flapping alarms shares a sync */
+constexpr std::chrono::seconds syncDelay{1};
+
+/* Fewest records in the journal before it's compacted */
+constexpr size_t compactMinRecords = 64;
+
+namespace
+{
+
+/**
+ * @brief Computes the FNV-1a checksum of a record payload
+ *
+ * @param[in] data - The payload
+ * @param[in] size - The payload size
+ *
+ * @return The checksum
+ */
+uint32_t checksum(const uint8_t* data, size_t size)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Writes a whole buffer to a file
+ *
+ * @param[in] fd - The file descriptor
+ * @param[in] buffer - The data
+ *
+ * @return If all of the data was written
+ */
+bool writeAll(int fd, const std::vector<uint8_t>& buffer)
+{
+    size_t written = 0;
+    while (written < buffer.size())
+    {
+        auto rc = ::write(fd, buffer.data() + written, buffer.size() - written);
+        if (rc < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        written += rc;
+    }
+    return true;
+}
+
+/**
+ * @brief Reads a journal file
+ *
+ * @param[in] path - The journal path
+ *
+ * @return The journal's contents
+ */
+std::vector<uint8_t> readJournal(const fs::path& path)
+{
+    std::ifstream stream{path.c_str(), std::ios::binary};
+    return {std::istreambuf_iterator<char>(stream),
+            std::istreambuf_iterator<char>()};
+}
+
+/**
+ * @brief Gets the size of the record at an offset into a journal
+ *
+ * @param[in] data - The journal's contents
+ * @param[in] offset - The record's offset
+ *
+ * @return The record's size including its header, or 0 if the record
+ *         is incomplete or corrupted
+ */
+size_t recordSize(const std::vector<uint8_t>& data, size_t offset)
+{
+    if (offset + recordHeaderSize > data.size())
+    {
+        return 0;
+    }
+
+    uint16_t size;
+    uint32_t sum;
+    std::memcpy(&size, &data[offset], sizeof(size));
+    std::memcpy(&sum, &data[offset + sizeof(size)], sizeof(sum));
+    if ((size < recordFixedSize) ||
+        (offset + recordHeaderSize + size > data.size()) ||
+        (checksum(&data[offset + recordHeaderSize], size) != sum))
+    {
+        return 0;
+    }
+    return recordHeaderSize + size;
+}
+
+/**
+ * @brief Gets the length of a journal up to the end of its last
+ *        complete record
+ *
+ * @param[in] data - The journal's contents
+ *
+ * @return The length, or 0 if the data isn't a journal
+ */
+size_t completeLength(const std::vector<uint8_t>& data)
+{
+    if ((data.size() < journalMagic.size()) ||
+        !std::equal(journalMagic.begin(), journalMagic.end(), data.begin()))
+    {
+        return 0;
+    }
+
+    size_t offset = journalMagic.size();
+    while (auto size = recordSize(data, offset))
+    {
+        offset += size;
+    }
+    return offset;
+}
+
+} // namespace
+
+AlarmTimestamps::AlarmTimestamps(sdeventplus::Event& event) :
+    syncTimer(event, std::bind(&AlarmTimestamps::sync, this))
+{
+    load();
+}
+
+AlarmTimestamps::~AlarmTimestamps()
+{
+    if (fd != -1)
+    {
+        if (unsynced)
+        {
+            fdatasync(fd);
+        }
+        close(fd);
+    }
+}
+
+void AlarmTimestamps::load()
+{
+    fs::path dir{SENSOR_MONITOR_PERSIST_ROOT_PATH};
+
+    auto legacy = !fs::exists(dir / journalFilename) &&
+                  fs::exists(dir / timestampsFilename);
+    if (legacy)
+    {
+        loadLegacy(dir / timestampsFilename);
+    }
+    else if (fs::exists(dir / journalFilename))
+    {
+        loadJournal(dir / journalFilename);
+    }
+
+    // Start out with a journal holding only the current timestamps
+    compact();
+
+    if (legacy && (fd != -1))
+    {
+        // The journal replaces the JSON file from now on
+        std::error_code ec;
+        fs::remove(dir / timestampsFilename, ec);
+    }
+}
+
+void AlarmTimestamps::loadJournal(const fs::path& path)
+{
+    auto data = readJournal(path);
+
+    if ((data.size() < journalMagic.size()) ||
+        !std::equal(journalMagic.begin(), journalMagic.end(), data.begin()))
+    {
+        log<level::ERR>(
+            fmt::format("Discarding invalid shutdown timestamps journal {}",
+                        path.string())
+                .c_str());
+        return;
+    }
+
+    size_t offset = journalMagic.size();
+    while (auto size = recordSize(data, offset))
+    {
+        const auto* payload = &data[offset + recordHeaderSize];
+        auto op = static_cast<Op>(payload[0]);
+        AlarmKey key{std::string{reinterpret_cast<const char*>(
+                                     payload + recordFixedSize),
+                                 size - recordHeaderSize - recordFixedSize},
+                     static_cast<ShutdownType>(payload[1]),
+                     static_cast<AlarmType>(payload[2])};
+        uint64_t timestamp;
+        std::memcpy(&timestamp, payload + 3, sizeof(timestamp));
+
+        switch (op)
+        {
+            case Op::add:
+                timestamps[key] = timestamp;
+                break;
+            case Op::erase:
+                timestamps.erase(key);
+                break;
+            case Op::clear:
+                timestamps.clear();
+                break;
+        }
+
+        offset += size;
+    }
+
+    if (offset != data.size())
+    {
+        // Most likely the last record was torn by a power loss, which
+        // the compaction after loading gets rid of.
+        log<level::INFO>(
+            fmt::format("Dropped {} bytes from the end of the shutdown "
+                        "timestamps journal",
+                        data.size() - offset)
+                .c_str());
+    }
+}
+
+void AlarmTimestamps::loadLegacy(const fs::path& path)
+{
+    std::vector<std::tuple<std::string, int, int, uint64_t>> times;
+
+    try
+    {
+        std::ifstream stream{path.c_str()};
+        cereal::JSONInputArchive iarchive{stream};
+        iarchive(times);
+
+        for (const auto& [sensorPath, shutdownType, alarmType, timestamp] :
+             times)
+        {
+            timestamps.emplace(
+                AlarmKey{sensorPath, static_cast<ShutdownType>(shutdownType),
+                         static_cast<AlarmType>(alarmType)},
+                timestamp);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>(
+            fmt::format("Unable to restore persisted times ({})", e.what())
+                .c_str());
+    }
+}
+
+void AlarmTimestamps::serialize(std::vector<uint8_t>& buffer, Op op,
+                                const AlarmKey& key, uint64_t timestamp)
+{
+    const auto& [sensorPath, shutdownType, alarmType] = key;
+    auto size = static_cast<uint16_t>(recordFixedSize + sensorPath.size());
+
+    auto start = buffer.size();
+    buffer.resize(start + recordHeaderSize + size);
+    auto* record = &buffer[start];
+    auto* payload = record + recordHeaderSize;
+
+    payload[0] = static_cast<uint8_t>(op);
+    payload[1] = static_cast<uint8_t>(shutdownType);
+    payload[2] = static_cast<uint8_t>(alarmType);
+    std::memcpy(payload + 3, &timestamp, sizeof(timestamp));
+    std::memcpy(payload + recordFixedSize, sensorPath.data(),
+                sensorPath.size());
+
+    auto sum = checksum(payload, size);
+    std::memcpy(record, &size, sizeof(size));
+    std::memcpy(record + sizeof(size), &sum, sizeof(sum));
+}
+
+void AlarmTimestamps::append(Op op, const AlarmKey& key, uint64_t timestamp)
+{
+    if (fd == -1)
+    {
+        openJournal();
+        if (fd == -1)
+        {
+            return;
+        }
+    }
+
+    std::vector<uint8_t> buffer;
+    serialize(buffer, op, key, timestamp);
+    if (!writeAll(fd, buffer))
+    {
+        log<level::ERR>(
+            fmt::format("Failed writing shutdown timestamps journal: {}",
+                        strerror(errno))
+                .c_str());
+
+        // Drop any of the record that was written, as the records
+        // appended after it would be lost behind it on the next load.
+        // If that fails too, reopening the journal truncates it.
+        if (ftruncate(fd, journalEnd) != 0)
+        {
+            close(fd);
+            fd = -1;
+        }
+        return;
+    }
+    journalEnd += buffer.size();
+    records++;
+
+    unsynced = true;
+    if (!syncTimer.isEnabled())
+    {
+        syncTimer.restartOnce(syncDelay);
+    }
+}
+
+void AlarmTimestamps::sync()
+{
+    if ((records >= compactMinRecords) && (records > 4 * timestamps.size()))
+    {
+        // Compaction leaves the journal synced
+        compact();
+        return;
+    }
+
+    if ((fd != -1) && unsynced)
+    {
+        if (fdatasync(fd) != 0)
+        {
+            log<level::ERR>(
+                fmt::format("Failed syncing shutdown timestamps journal: {}",
+                            strerror(errno))
+                    .c_str());
+        }
+        unsynced = false;
+    }
+}
+
+void AlarmTimestamps::compact()
+{
+    fs::path dir{SENSOR_MONITOR_PERSIST_ROOT_PATH};
+    auto path = dir / journalFilename;
+    auto tmpPath = dir / (std::string{journalFilename} + ".tmp");
+
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+
+    std::vector<uint8_t> buffer{journalMagic.begin(), journalMagic.end()};
+    for (const auto& [key, timestamp] : timestamps)
+    {
+        serialize(buffer, Op::add, key, timestamp);
+    }
+
+    // Write a new journal next to the old one and rename it into place,
+    // so there is always a complete journal on flash.
+    int tmpFd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                     0644);
+    if (tmpFd == -1)
+    {
+        log<level::ERR>(
+            fmt::format("Unable to create shutdown timestamps journal {}: {}",
+                        tmpPath.string(), strerror(errno))
+                .c_str());
+        return;
+    }
+
+    auto written = writeAll(tmpFd, buffer) && (fdatasync(tmpFd) == 0);
+    close(tmpFd);
+
+    if (!written || (rename(tmpPath.c_str(), path.c_str()) != 0))
+    {
+        log<level::ERR>(
+            fmt::format("Unable to write shutdown timestamps journal {}: {}",
+                        path.string(), strerror(errno))
+                .c_str());
+        fs::remove(tmpPath, ec);
+        return;
+    }
+
+    if (fd != -1)
+    {
+        close(fd);
+        fd = -1;
+    }
+    records = timestamps.size();
+    unsynced = false;
+    openJournal();
+}
+
+void AlarmTimestamps::openJournal()
+{
+    fs::path dir{SENSOR_MONITOR_PERSIST_ROOT_PATH};
+    auto path = dir / journalFilename;
+
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+
+    fd = open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+    if (fd == -1)
+    {
+        log<level::ERR>(
+            fmt::format("Unable to open shutdown timestamps journal {}: {}",
+                        path.string(), strerror(errno))
+                .c_str());
+        return;
+    }
+
+    // Cut off anything after the last complete record, like a record
+    // torn by an earlier failed write, so the records appended next
+    // aren't lost behind it on the next load.  A new file, or one
+    // without a valid header, is started over with the header.
+    auto length = completeLength(readJournal(path));
+    if (lseek(fd, 0, SEEK_END) != static_cast<off_t>(length))
+    {
+        if (ftruncate(fd, length) != 0)
+        {
+            log<level::ERR>(
+                fmt::format("Unable to truncate shutdown timestamps "
+                            "journal {}: {}",
+                            path.string(), strerror(errno))
+                    .c_str());
+            close(fd);
+            fd = -1;
+            return;
+        }
+    }
+
+    if (length == 0)
+    {
+        std::vector<uint8_t> header{journalMagic.begin(), journalMagic.end()};
+        writeAll(fd, header);
+        length = header.size();
+    }
+    journalEnd = length;
+}
+
+} // namespace sensor::monitor
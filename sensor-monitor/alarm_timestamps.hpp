@@ -18,20 +18,17 @@
 
 #include "types.hpp"
 
-#include <fmt/format.h>
+#include <sys/types.h>
 
-#include <cereal/archives/json.hpp>
-#include <cereal/types/string.hpp>
-#include <cereal/types/tuple.hpp>
-#include <cereal/types/vector.hpp>
-#include <phosphor-logging/log.hpp>
 #include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
 #include <sdeventplus/utility/timer.hpp>
 
+#include <cstdint>
 #include <filesystem>
-#include <fstream>
+#include <functional>
 #include <map>
-#include <tuple>
+#include <vector>
 
 namespace sensor::monitor
 {
@@ -44,11 +41,19 @@ namespace sensor::monitor
  * while a timer is running.  In the case where the process starts
  * when a timer was previously running and an alarm is still active,
  * a new timer can be started with just the remaining time.
+ *
+ * The timestamps are persisted in a binary journal that each change
+ * is appended to, instead of rewriting all of them every time.  The
+ * journal is synced to flash shortly after a change so a burst of
+ * changes shares a single sync, and is compacted down to just the
+ * current timestamps once it's mostly made up of stale records.
+ * A record torn by a power loss is detected by its checksum and
+ * dropped when the journal is loaded.
  */
 class AlarmTimestamps
 {
   public:
-    ~AlarmTimestamps() = default;
+    AlarmTimestamps() = delete;
     AlarmTimestamps(const AlarmTimestamps&) = delete;
     AlarmTimestamps& operator=(const AlarmTimestamps&) = delete;
     AlarmTimestamps(AlarmTimestamps&&) = delete;
@@ -58,11 +63,17 @@ class AlarmTimestamps
      * @brief Constructor
      *
      * Loads any saved timestamps
+     *
+     * @param[in] event - The sdeventplus event object
      */
-    AlarmTimestamps()
-    {
-        load();
-    }
+    explicit AlarmTimestamps(sdeventplus::Event& event);
+
+    /**
+     * @brief Destructor
+     *
+     * Syncs any unsynced changes.
+     */
+    ~AlarmTimestamps();
 
     /**
      * @brief Adds an entry to the timestamps map and persists it.
@@ -78,7 +89,7 @@ class AlarmTimestamps
         auto result = timestamps.emplace(key, timestamp);
         if (result.second)
         {
-            save();
+            append(Op::add, key, timestamp);
         }
     }
 
@@ -92,7 +103,7 @@ class AlarmTimestamps
         size_t removed = timestamps.erase(key);
         if (removed)
         {
-            save();
+            append(Op::erase, key, 0);
         }
     }
 
@@ -101,8 +112,9 @@ class AlarmTimestamps
      */
     void erase(std::map<AlarmKey, uint64_t>::const_iterator& entry)
     {
+        auto key = entry->first;
         timestamps.erase(entry);
-        save();
+        append(Op::erase, key, 0);
     }
 
     /**
@@ -113,7 +125,7 @@ class AlarmTimestamps
         if (!timestamps.empty())
         {
             timestamps.clear();
-            save();
+            append(Op::clear, AlarmKey{}, 0);
         }
     }
 
@@ -122,45 +134,25 @@ class AlarmTimestamps
      *        for.  This is used on startup when an alarm could have cleared
      *        during a restart to get rid of the old entries.
      *
-     * @param[in] alarms - The current alarms map.
+     * @param[in] isTimerRunning - Returns if an alarm's timer is running
      */
-    void prune(
-        const std::map<AlarmKey, std::unique_ptr<sdeventplus::utility::Timer<
-                                     sdeventplus::ClockId::Monotonic>>>& alarms)
+    void prune(const std::function<bool(const AlarmKey&)>& isTimerRunning)
     {
-        auto size = timestamps.size();
-
-        auto isTimerStopped = [&alarms](const AlarmKey& key) {
-            auto alarm = alarms.find(key);
-            if (alarm != alarms.end())
-            {
-                auto& timer = alarm->second;
-                if (timer && timer->isEnabled())
-                {
-                    return false;
-                }
-            }
-            return true;
-        };
-
         auto it = timestamps.begin();
 
         while (it != timestamps.end())
         {
-            if (isTimerStopped(it->first))
+            if (!isTimerRunning(it->first))
             {
+                auto key = it->first;
                 it = timestamps.erase(it);
+                append(Op::erase, key, 0);
             }
             else
             {
                 ++it;
             }
         }
-
-        if (size != timestamps.size())
-        {
-            save();
-        }
     }
 
     /**
@@ -172,92 +164,115 @@ class AlarmTimestamps
     }
 
     /**
-     * @brief Saves the timestamps map in the filesystem using cereal.
-     *
-     * Since cereal doesn't understand the AlarmType or ShutdownType
-     * enums, they are converted to ints before being written.
+     * @brief Syncs the journal to flash, compacting it first if
+     *        it has grown enough.
      */
-    void save()
+    void sync();
+
+  private:
+    static constexpr auto timestampsFilename = "shutdownAlarmStartTimes";
+    static constexpr auto journalFilename = "shutdownAlarmStartTimes.journal";
+
+    /**
+     * @brief The journal record operations
+     */
+    enum class Op : uint8_t
     {
-        std::filesystem::path path =
-            std::filesystem::path{SENSOR_MONITOR_PERSIST_ROOT_PATH} /
-            timestampsFilename;
+        add = 1,
+        erase = 2,
+        clear = 3
+    };
 
-        if (!std::filesystem::exists(path.parent_path()))
-        {
-            std::filesystem::create_directory(path.parent_path());
-        }
+    /**
+     * @brief Loads the saved timestamps from the filesystem, from the
+     *        journal or else from the JSON file older code saved them in.
+     */
+    void load();
 
-        std::vector<std::tuple<std::string, int, int, uint64_t>> times;
+    /**
+     * @brief Replays the journal records into the timestamps map.
+     *
+     * Stops at the first incomplete or corrupted record, which the
+     * compaction done after loading then leaves out.
+     *
+     * @param[in] path - The journal path
+     */
+    void loadJournal(const std::filesystem::path& path);
 
-        for (const auto& [key, time] : timestamps)
-        {
-            times.emplace_back(std::get<std::string>(key),
-                               static_cast<int>(std::get<ShutdownType>(key)),
-                               static_cast<int>(std::get<AlarmType>(key)),
-                               time);
-        }
+    /**
+     * @brief Loads the timestamps from the JSON file that older code
+     *        saved them in with cereal.
+     *
+     * As cereal doesn't understand the ShutdownType or AlarmType enums
+     * they have to have been saved as ints and converted.
+     *
+     * @param[in] path - The JSON file path
+     */
+    void loadLegacy(const std::filesystem::path& path);
 
-        std::ofstream stream{path.c_str()};
-        cereal::JSONOutputArchive oarchive{stream};
+    /**
+     * @brief Appends a record to the journal and schedules a sync.
+     *
+     * @param[in] op - The operation
+     * @param[in] key - The AlarmKey value
+     * @param[in] timestamp - The timestamp, for an add
+     */
+    void append(Op op, const AlarmKey& key, uint64_t timestamp);
 
-        oarchive(times);
-    }
+    /**
+     * @brief Rewrites the journal with only an add record
+     *        for each current timestamp.
+     */
+    void compact();
 
-  private:
-    static constexpr auto timestampsFilename = "shutdownAlarmStartTimes";
+    /**
+     * @brief Opens the journal for appending, creating it if needed.
+     *
+     * Truncates the journal to the end of its last complete record.
+     */
+    void openJournal();
 
     /**
-     * @brief Loads the saved timestamps from the filesystem.
+     * @brief Serializes a record onto the end of a buffer.
      *
-     * As with save(), cereal doesn't understand the ShutdownType or AlarmType
-     * enums so they have to have been saved as ints and converted.
+     * @param[in,out] buffer - The buffer
+     * @param[in] op - The operation
+     * @param[in] key - The AlarmKey value
+     * @param[in] timestamp - The timestamp, for an add
      */
-    void load()
-    {
+    static void serialize(std::vector<uint8_t>& buffer, Op op,
+                          const AlarmKey& key, uint64_t timestamp);
 
-        std::vector<std::tuple<std::string, int, int, uint64_t>> times;
+    /**
+     * @brief The map of AlarmKeys and time start times.
+     */
+    std::map<AlarmKey, uint64_t> timestamps;
 
-        std::filesystem::path path =
-            std::filesystem::path{SENSOR_MONITOR_PERSIST_ROOT_PATH} /
-            timestampsFilename;
+    /**
+     * @brief The journal file descriptor, or -1 if it isn't open
+     */
+    int fd = -1;
 
-        if (!std::filesystem::exists(path))
-        {
-            return;
-        }
+    /**
+     * @brief Length of the journal up to the end of its last
+     *        complete record
+     */
+    off_t journalEnd = 0;
 
-        try
-        {
-            std::ifstream stream{path.c_str()};
-            cereal::JSONInputArchive iarchive{stream};
-            iarchive(times);
+    /**
+     * @brief Number of records in the journal
+     */
+    size_t records = 0;
 
-            for (const auto& [path, shutdownType, alarmType, timestamp] : times)
-            {
-                timestamps.emplace(
-                    AlarmKey{path, static_cast<ShutdownType>(shutdownType),
-                             static_cast<AlarmType>(alarmType)},
-                    timestamp);
-            }
-        }
-        catch (const std::exception& e)
-        {
-            // Include possible exception when removing file, otherwise ec = 0
-            using namespace phosphor::logging;
-            std::error_code ec;
-            std::filesystem::remove(path, ec);
-            log<level::ERR>(
-                fmt::format("Unable to restore persisted times ({}, ec: {})",
-                            e.what(), ec.value())
-                    .c_str());
-        }
-    }
+    /**
+     * @brief If there are appended records that haven't been synced
+     */
+    bool unsynced = false;
 
     /**
-     * @brief The map of AlarmKeys and time start times.
+     * @brief The timer that batches journal syncs
      */
-    std::map<AlarmKey, uint64_t> timestamps;
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> syncTimer;
 };
 
 } // namespace sensor::monitor
@@ -0,0 +1,289 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "association_cache.hpp"
+
+#include "sdbusplus.hpp"
+
+#include <fmt/format.h>
+
+#include <phosphor-logging/log.hpp>
+
+#include <algorithm>
+#include <array>
+#include <set>
+#include <variant>
+
+namespace sensor::monitor
+{
+
+using namespace phosphor::logging;
+using namespace phosphor::fan::util;
+
+constexpr auto sensorsPath = "/xyz/openbmc_project/sensors";
+constexpr auto assocInterface = "xyz.openbmc_project.Association";
+constexpr auto endpointsProperty = "endpoints";
+
+using Endpoints = std::vector<std::string>;
+using EndpointsProperty = std::variant<Endpoints>;
+
+// Different implementations handle the association to the FRU
+// differently:
+//  * phosphor-inventory-manager uses the 'inventory' association
+//    to point to the FRU.
+//  * dbus-sensors/entity-manager uses the 'chassis' association'.
+//  * For virtual sensors, no association.
+const std::array<std::string, 2> assocTypes{"inventory", "chassis"};
+
+namespace
+{
+
+/**
+ * @brief Get whether a path is one of the callout association objects
+ *
+ * @param[in] path - The object path
+ *
+ * @return If the path's last segment is a callout association type
+ */
+bool isCalloutAssociation(const std::string& path)
+{
+    auto pos = path.find_last_of('/');
+    return (pos != std::string::npos) &&
+           (std::find(assocTypes.begin(), assocTypes.end(),
+                      path.substr(pos + 1)) != assocTypes.end());
+}
+
+} // namespace
+
+AssociationCache::AssociationCache(sdbusplus::bus::bus& bus) :
+    bus(bus),
+    ifacesAddedMatch(bus,
+                     "type='signal',member='InterfacesAdded',arg0path="
+                     "'/xyz/openbmc_project/sensors/'",
+                     std::bind(&AssociationCache::interfacesAdded, this,
+                               std::placeholders::_1)),
+    ifacesRemovedMatch(bus,
+                       "type='signal',member='InterfacesRemoved',arg0path="
+                       "'/xyz/openbmc_project/sensors/'",
+                       std::bind(&AssociationCache::interfacesRemoved, this,
+                                 std::placeholders::_1)),
+    endpointsChangedMatch(bus,
+                          "type='signal',member='PropertiesChanged',"
+                          "path_namespace='/xyz/openbmc_project/sensors',"
+                          "arg0='xyz.openbmc_project.Association'",
+                          std::bind(&AssociationCache::propertiesChanged,
+                                    this, std::placeholders::_1))
+{
+    load();
+}
+
+void AssociationCache::load()
+{
+    try
+    {
+        auto objects =
+            SDBusPlus::getSubTreeRaw(bus, sensorsPath, assocInterface, 0);
+        for (const auto& [path, pathServices] : objects)
+        {
+            if (isCalloutAssociation(path) && !pathServices.empty())
+            {
+                services[path] = pathServices.begin()->first;
+            }
+        }
+    }
+    catch (const DBusError& e)
+    {
+        log<level::ERR>(
+            fmt::format("Unable to find sensor associations: {}", e.what())
+                .c_str());
+        return;
+    }
+    loaded = true;
+
+    // Read all endpoints of a service at once when it has an ObjectManager,
+    // otherwise they're read when first needed.
+    std::set<std::string> owners;
+    for (const auto& [path, service] : services)
+    {
+        owners.insert(service);
+    }
+    for (const auto& service : owners)
+    {
+        try
+        {
+            auto objects = SDBusPlus::getManagedObjects<EndpointsProperty>(
+                bus, service, "/");
+            for (const auto& [path, interfaces] : objects)
+            {
+                auto itIntf = interfaces.find(assocInterface);
+                if (itIntf == interfaces.end() ||
+                    services.find(path) == services.end())
+                {
+                    continue;
+                }
+                auto itProp = itIntf->second.find(endpointsProperty);
+                if (itProp != itIntf->second.end())
+                {
+                    endpoints[path] = std::get<Endpoints>(itProp->second);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            continue;
+        }
+    }
+}
+
+const std::vector<std::string>&
+    AssociationCache::getEndpoints(const std::string& assocPath)
+{
+    static const Endpoints none;
+
+    auto itEndpoints = endpoints.find(assocPath);
+    if (itEndpoints != endpoints.end())
+    {
+        return itEndpoints->second;
+    }
+
+    auto itService = services.find(assocPath);
+    if (itService == services.end())
+    {
+        // The association doesn't exist
+        return none;
+    }
+
+    try
+    {
+        auto value = SDBusPlus::getProperty<Endpoints>(
+            bus, itService->second, assocPath, assocInterface,
+            endpointsProperty);
+        return endpoints.emplace(assocPath, std::move(value)).first->second;
+    }
+    catch (const DBusError& e)
+    {
+        return none;
+    }
+}
+
+std::string AssociationCache::getCallout(const std::string& sensorPath)
+{
+    if (!loaded)
+    {
+        load();
+    }
+
+    for (const auto& assocType : assocTypes)
+    {
+        auto assocPath = sensorPath + "/" + assocType;
+        if (!loaded)
+        {
+            // Without the mapper's view of the associations, look each
+            // one up directly.
+            try
+            {
+                auto value = SDBusPlus::getProperty<Endpoints>(
+                    bus, assocPath, assocInterface, endpointsProperty);
+                if (!value.empty())
+                {
+                    return value[0];
+                }
+            }
+            catch (const DBusServiceError& e)
+            {
+                // The association doesn't exist
+            }
+            continue;
+        }
+
+        const auto& assocEndpoints = getEndpoints(assocPath);
+        if (!assocEndpoints.empty())
+        {
+            return assocEndpoints[0];
+        }
+    }
+
+    return std::string{};
+}
+
+void AssociationCache::interfacesAdded(sdbusplus::message::message& msg)
+{
+    sdbusplus::message::object_path path;
+    msg.read(path);
+
+    // Only the association objects are read any further, since the
+    // other objects' properties don't fit the endpoints variant.
+    if (!isCalloutAssociation(path))
+    {
+        return;
+    }
+
+    std::map<std::string, std::map<std::string, EndpointsProperty>> interfaces;
+    msg.read(interfaces);
+
+    auto itIntf = interfaces.find(assocInterface);
+    if (itIntf == interfaces.end())
+    {
+        return;
+    }
+
+    services[path] = msg.get_sender();
+    auto itProp = itIntf->second.find(endpointsProperty);
+    if (itProp != itIntf->second.end())
+    {
+        endpoints[path] = std::get<Endpoints>(itProp->second);
+    }
+    else
+    {
+        endpoints.erase(path);
+    }
+}
+
+void AssociationCache::interfacesRemoved(sdbusplus::message::message& msg)
+{
+    sdbusplus::message::object_path path;
+    std::vector<std::string> interfaces;
+
+    msg.read(path, interfaces);
+
+    if (std::find(interfaces.begin(), interfaces.end(), assocInterface) !=
+        interfaces.end())
+    {
+        services.erase(path);
+        endpoints.erase(path);
+    }
+}
+
+void AssociationCache::propertiesChanged(sdbusplus::message::message& msg)
+{
+    std::string path = msg.get_path();
+    if (!isCalloutAssociation(path))
+    {
+        return;
+    }
+
+    std::string interface;
+    std::map<std::string, EndpointsProperty> properties;
+    msg.read(interface, properties);
+
+    auto itProp = properties.find(endpointsProperty);
+    if (itProp != properties.end())
+    {
+        services[path] = msg.get_sender();
+        endpoints[path] = std::get<Endpoints>(itProp->second);
+    }
+}
+
+} // namespace sensor::monitor
@@ -0,0 +1,140 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace sensor::monitor
+{
+
+/**
+ * @class AssociationCache
+ *
+ * Caches the 'inventory' and 'chassis' association endpoints of the
+ * sensors, used to find the FRU to call out in threshold event logs.
+ *
+ * The association objects under the sensors are found with a single mapper
+ * GetSubTree call, and their endpoints read in bulk with GetManagedObjects
+ * where the owning service supports it. The rest are read on first use.
+ * The cache is kept current by watching for association objects being
+ * added and removed and for their endpoints changing.
+ */
+class AssociationCache
+{
+  public:
+    AssociationCache() = delete;
+    ~AssociationCache() = default;
+    AssociationCache(const AssociationCache&) = delete;
+    AssociationCache& operator=(const AssociationCache&) = delete;
+    AssociationCache(AssociationCache&&) = delete;
+    AssociationCache& operator=(AssociationCache&&) = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] bus - The sdbusplus bus object
+     */
+    explicit AssociationCache(sdbusplus::bus::bus& bus);
+
+    /**
+     * @brief Get the inventory FRU to call out for a sensor
+     *
+     * @param[in] sensorPath - The sensor object path
+     *
+     * @return The inventory path, or an empty string if there is no
+     *         association to one
+     */
+    std::string getCallout(const std::string& sensorPath);
+
+  private:
+    /**
+     * @brief Find the association objects and read their endpoints
+     */
+    void load();
+
+    /**
+     * @brief Get the endpoints of an association, reading them if they
+     *        aren't cached yet
+     *
+     * @param[in] assocPath - The association object path
+     *
+     * @return The endpoints, empty if the association doesn't exist
+     */
+    const std::vector<std::string>& getEndpoints(const std::string& assocPath);
+
+    /**
+     * @brief The InterfacesAdded handler for the sensor objects
+     *
+     * @param[in] msg - The signal message payload.
+     */
+    void interfacesAdded(sdbusplus::message::message& msg);
+
+    /**
+     * @brief The InterfacesRemoved handler for the sensor objects
+     *
+     * @param[in] msg - The signal message payload.
+     */
+    void interfacesRemoved(sdbusplus::message::message& msg);
+
+    /**
+     * @brief The PropertiesChanged handler for the association objects
+     *
+     * @param[in] msg - The signal message payload.
+     */
+    void propertiesChanged(sdbusplus::message::message& msg);
+
+    /**
+     * @brief The sdbusplus bus object
+     */
+    sdbusplus::bus::bus& bus;
+
+    /**
+     * @brief If the association objects have been found
+     */
+    bool loaded = false;
+
+    /**
+     * @brief Map of association object paths to their owning service
+     */
+    std::map<std::string, std::string> services;
+
+    /**
+     * @brief Map of association object paths to their endpoints
+     */
+    std::map<std::string, std::vector<std::string>> endpoints;
+
+    /**
+     * @brief The InterfacesAdded match object
+     */
+    sdbusplus::bus::match::match ifacesAddedMatch;
+
+    /**
+     * @brief The InterfacesRemoved match object
+     */
+    sdbusplus::bus::match::match ifacesRemovedMatch;
+
+    /**
+     * @brief The PropertiesChanged match object
+     */
+    sdbusplus::bus::match::match endpointsChangedMatch;
+};
+
+} // namespace sensor::monitor
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "alarm_snapshot.hpp"
 #include "power_state.hpp"
 #include "shutdown_alarm_monitor.hpp"
 #include "threshold_alarm_logger.hpp"
@@ -20,6 +21,8 @@
 #include <sdbusplus/bus.hpp>
 #include <sdeventplus/event.hpp>
 
+#include <memory>
+
 using namespace sensor::monitor;
 
 int main(int argc, char* argv[])
@@ -36,9 +39,18 @@ int main(int argc, char* argv[])
         std::make_shared<phosphor::fan::PGoodState>();
 #endif
 
-    ShutdownAlarmMonitor shutdownMonitor{bus, event, powerState};
+    // Read the current alarm values for both monitors in one bulk scan
+    auto interfaces = ShutdownAlarmMonitor::getInterfaces();
+    auto thresholdInterfaces = ThresholdAlarmLogger::getInterfaces();
+    interfaces.insert(interfaces.end(), thresholdInterfaces.begin(),
+                      thresholdInterfaces.end());
+    auto snapshot = std::make_unique<AlarmSnapshot>(bus, interfaces);
+
+    ShutdownAlarmMonitor shutdownMonitor{bus, event, powerState, *snapshot};
+
+    ThresholdAlarmLogger logger{bus, event, powerState, *snapshot};
 
-    ThresholdAlarmLogger logger{bus, event, powerState};
+    snapshot.reset();
 
     return event.loop();
 }
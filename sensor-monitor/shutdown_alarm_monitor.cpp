@@ -86,7 +86,7 @@ using namespace sdbusplus::bus::match;
 
 ShutdownAlarmMonitor::ShutdownAlarmMonitor(
     sdbusplus::bus::bus& bus, sdeventplus::Event& event,
-    std::shared_ptr<PowerState> powerState) :
+    std::shared_ptr<PowerState> powerState, const AlarmSnapshot& snapshot) :
     bus(bus),
     event(event), _powerState(std::move(powerState)),
     hardShutdownMatch(bus,
@@ -102,20 +102,26 @@ ShutdownAlarmMonitor::ShutdownAlarmMonitor(
                       "arg0='" +
                           shutdownInterfaces.at(ShutdownType::soft) + "'",
                       std::bind(&ShutdownAlarmMonitor::propertiesChanged, this,
-                                std::placeholders::_1))
+                                std::placeholders::_1)),
+    timer(event, std::bind(&ShutdownAlarmMonitor::deadlineReached, this)),
+    timestamps(event)
 {
     _powerState->addCallback("shutdownMon",
                              std::bind(&ShutdownAlarmMonitor::powerStateChanged,
                                        this, std::placeholders::_1));
-    findAlarms();
+    findAlarms(snapshot);
 
     if (_powerState->isPowerOn())
     {
-        checkAlarms();
+        checkAlarms(snapshot);
 
         // Get rid of any previous saved timestamps that don't
         // apply anymore.
-        timestamps.prune(alarms);
+        timestamps.prune([this](const AlarmKey& alarmKey) {
+            auto alarm = alarms.find(alarmKey);
+            return (alarm != alarms.end()) && alarm->second &&
+                   (deadlines.count({*alarm->second, alarmKey}) != 0);
+        });
     }
     else
     {
@@ -123,38 +129,43 @@ ShutdownAlarmMonitor::ShutdownAlarmMonitor(
     }
 }
 
-void ShutdownAlarmMonitor::findAlarms()
+std::vector<std::string> ShutdownAlarmMonitor::getInterfaces()
+{
+    std::vector<std::string> interfaces;
+    for (const auto& [shutdownType, interface] : shutdownInterfaces)
+    {
+        interfaces.push_back(interface);
+    }
+    return interfaces;
+}
+
+void ShutdownAlarmMonitor::findAlarms(const AlarmSnapshot& snapshot)
 {
     // Find all shutdown threshold ifaces currently on D-Bus.
     for (const auto& [shutdownType, interface] : shutdownInterfaces)
     {
-        auto paths = SDBusPlus::getSubTreePathsRaw(bus, "/", interface, 0);
+        auto paths = snapshot.getPaths(interface);
 
         std::for_each(
             paths.begin(), paths.end(), [this, shutdownType](const auto& path) {
                 alarms.emplace(AlarmKey{path, shutdownType, AlarmType::high},
-                               nullptr);
+                               std::nullopt);
                 alarms.emplace(AlarmKey{path, shutdownType, AlarmType::low},
-                               nullptr);
+                               std::nullopt);
             });
     }
 }
 
-void ShutdownAlarmMonitor::checkAlarms()
+void ShutdownAlarmMonitor::checkAlarms(const AlarmSnapshot& snapshot)
 {
-    for (auto& [alarmKey, timer] : alarms)
+    for (auto& [alarmKey, deadline] : alarms)
     {
         const auto& [sensorPath, shutdownType, alarmType] = alarmKey;
         const auto& interface = shutdownInterfaces.at(shutdownType);
-        auto propertyName = alarmProperties.at(shutdownType).at(alarmType);
-        bool value;
+        const auto& propertyName =
+            alarmProperties.at(shutdownType).at(alarmType);
 
-        try
-        {
-            value = SDBusPlus::getProperty<bool>(bus, sensorPath, interface,
-                                                 propertyName);
-        }
-        catch (const DBusServiceError& e)
+        if (!snapshot.hasInterface(sensorPath, interface))
         {
             // The sensor isn't on D-Bus anymore
             log<level::INFO>(fmt::format("No {} interface on {} anymore.",
@@ -163,7 +174,12 @@ void ShutdownAlarmMonitor::checkAlarms()
             continue;
         }
 
-        checkAlarm(value, alarmKey);
+        // Sensors may only implement one of the high and low alarms
+        auto value = snapshot.getAlarm(sensorPath, interface, propertyName);
+        if (value)
+        {
+            checkAlarm(*value, alarmKey);
+        }
     }
 }
 
@@ -195,7 +211,7 @@ void ShutdownAlarmMonitor::propertiesChanged(
         auto alarm = alarms.find(alarmKey);
         if (alarm == alarms.end())
         {
-            alarms.emplace(alarmKey, nullptr);
+            alarms.emplace(alarmKey, std::nullopt);
         }
         checkAlarm(std::get<bool>(properties.at(lowAlarmName)), alarmKey);
     }
@@ -207,7 +223,7 @@ void ShutdownAlarmMonitor::propertiesChanged(
         auto alarm = alarms.find(alarmKey);
         if (alarm == alarms.end())
         {
-            alarms.emplace(alarmKey, nullptr);
+            alarms.emplace(alarmKey, std::nullopt);
         }
         checkAlarm(std::get<bool>(properties.at(highAlarmName)), alarmKey);
     }
@@ -222,17 +238,17 @@ void ShutdownAlarmMonitor::checkAlarm(bool value, const AlarmKey& alarmKey)
     }
 
     // Start or stop the timer if necessary.
-    auto& timer = alarm->second;
+    const auto& deadline = alarm->second;
     if (value)
     {
-        if (!timer)
+        if (!deadline)
         {
             startTimer(alarmKey);
         }
     }
     else
     {
-        if (timer)
+        if (deadline)
         {
             stopTimer(alarmKey);
         }
@@ -314,13 +330,10 @@ void ShutdownAlarmMonitor::startTimer(const AlarmKey& alarmKey)
                     shutdownDelay.count(), propertyName, sensorPath, *value)
             .c_str());
 
-    auto& timer = alarm->second;
-
-    timer = std::make_unique<
-        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>(
-        event, std::bind(&ShutdownAlarmMonitor::timerExpired, this, alarmKey));
-
-    timer->restartOnce(shutdownDelay);
+    auto deadline = std::chrono::steady_clock::now() + shutdownDelay;
+    alarm->second = deadline;
+    deadlines.emplace(deadline, alarmKey);
+    armTimer();
 
     // Note that if this key is already in the timestamps map because
     // the timer was already running the timestamp wil not be updated.
@@ -348,13 +361,52 @@ void ShutdownAlarmMonitor::stopTimer(const AlarmKey& alarmKey)
                     propertyName, sensorPath, value)
             .c_str());
 
-    auto& timer = alarm->second;
-    timer->setEnabled(false);
-    timer.reset();
+    // The deadline is already gone if the timer expired
+    deadlines.erase({*alarm->second, alarmKey});
+    alarm->second.reset();
+    armTimer();
 
     timestamps.erase(alarmKey);
 }
 
+void ShutdownAlarmMonitor::armTimer()
+{
+    if (deadlines.empty())
+    {
+        timer.setEnabled(false);
+        return;
+    }
+
+    // Rounded up, as the timer firing before the deadline would find
+    // nothing expired and just restart itself
+    auto remaining = std::get<Deadline>(*deadlines.begin()) -
+                     std::chrono::steady_clock::now();
+    timer.restartOnce(
+        std::max(std::chrono::ceil<std::chrono::milliseconds>(remaining),
+                 std::chrono::milliseconds{0}));
+}
+
+void ShutdownAlarmMonitor::deadlineReached()
+{
+    auto now = std::chrono::steady_clock::now();
+    std::vector<AlarmKey> expired;
+
+    // The alarms keep their deadline so the timer isn't restarted until
+    // the alarm clears, the same as if it were still running.
+    while (!deadlines.empty() &&
+           (std::get<Deadline>(*deadlines.begin()) <= now))
+    {
+        expired.push_back(std::get<AlarmKey>(*deadlines.begin()));
+        deadlines.erase(deadlines.begin());
+    }
+    armTimer();
+
+    for (const auto& alarmKey : expired)
+    {
+        timerExpired(alarmKey);
+    }
+}
+
 void ShutdownAlarmMonitor::createBmcDump() const
 {
     try
@@ -399,21 +451,18 @@ void ShutdownAlarmMonitor::powerStateChanged(bool powerStateOn)
 {
     if (powerStateOn)
     {
-        checkAlarms();
+        AlarmSnapshot snapshot{bus, getInterfaces()};
+        checkAlarms(snapshot);
     }
     else
     {
         timestamps.clear();
 
-        // Cancel and delete all timers
-        std::for_each(alarms.begin(), alarms.end(), [](auto& alarm) {
-            auto& timer = alarm.second;
-            if (timer)
-            {
-                timer->setEnabled(false);
-                timer.reset();
-            }
-        });
+        // Cancel all timers
+        std::for_each(alarms.begin(), alarms.end(),
+                      [](auto& alarm) { alarm.second.reset(); });
+        deadlines.clear();
+        timer.setEnabled(false);
     }
 }
 
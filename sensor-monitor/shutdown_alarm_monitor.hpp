@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #pragma once
+#include "alarm_snapshot.hpp"
 #include "alarm_timestamps.hpp"
 #include "power_state.hpp"
 #include "types.hpp"
@@ -26,6 +27,7 @@
 
 #include <chrono>
 #include <optional>
+#include <set>
 
 namespace sensor::monitor
 {
@@ -45,6 +47,9 @@ namespace sensor::monitor
  *
  * Event logs are also created when the alarms trip and clear.
  *
+ * All of the running timers share a single event loop timer, which is
+ * armed for the earliest of their deadlines.
+ *
  * Note that the SoftShutdown alarm code actually implements a hard shutdown.
  * This is because in the system this is being written for, the host is
  * driving the shutdown process (i.e. doing a soft shutdown) based on an alert
@@ -56,6 +61,8 @@ namespace sensor::monitor
 class ShutdownAlarmMonitor
 {
   public:
+    using Deadline = std::chrono::steady_clock::time_point;
+
     ShutdownAlarmMonitor() = delete;
     ~ShutdownAlarmMonitor() = default;
     ShutdownAlarmMonitor(const ShutdownAlarmMonitor&) = delete;
@@ -69,9 +76,18 @@ class ShutdownAlarmMonitor
      * @param[in] bus - The sdbusplus bus object
      * @param[in] event - The sdeventplus event object
      * @param[in] powerState - The PowerState object
+     * @param[in] snapshot - Snapshot of the current alarm values
      */
     ShutdownAlarmMonitor(sdbusplus::bus::bus& bus, sdeventplus::Event& event,
-                         std::shared_ptr<phosphor::fan::PowerState> powerState);
+                         std::shared_ptr<phosphor::fan::PowerState> powerState,
+                         const AlarmSnapshot& snapshot);
+
+    /**
+     * @brief Get the shutdown threshold interfaces monitored
+     *
+     * @return The interface names
+     */
+    static std::vector<std::string> getInterfaces();
 
   private:
     /**
@@ -95,17 +111,22 @@ class ShutdownAlarmMonitor
     void checkAlarm(bool value, const AlarmKey& alarmKey);
 
     /**
-     * @brief Checks all currently known alarm properties on D-Bus.
+     * @brief Checks all currently known alarm properties against
+     *        a snapshot of their values on D-Bus.
      *
      * May result in starting or stopping shutdown timers.
+     *
+     * @param[in] snapshot - Snapshot of the current alarm values
      */
-    void checkAlarms();
+    void checkAlarms(const AlarmSnapshot& snapshot);
 
     /**
-     * @brief Finds all shutdown alarm interfaces currently on
-     *        D-Bus and adds them to the alarms map.
+     * @brief Finds all shutdown alarm interfaces in the snapshot
+     *        and adds them to the alarms map.
+     *
+     * @param[in] snapshot - Snapshot of the current alarm values
      */
-    void findAlarms();
+    void findAlarms(const AlarmSnapshot& snapshot);
 
     /**
      * @brief Starts a shutdown timer.
@@ -122,7 +143,21 @@ class ShutdownAlarmMonitor
     void stopTimer(const AlarmKey& alarmKey);
 
     /**
-     * @brief The function called when the timer expires.
+     * @brief Arms the timer for the earliest deadline, or
+     *        disables it if there are none.
+     */
+    void armTimer();
+
+    /**
+     * @brief The function called when the timer for the earliest
+     *        deadline expires.
+     *
+     * Calls timerExpired() for every alarm whose deadline has passed.
+     */
+    void deadlineReached();
+
+    /**
+     * @brief The function called when an alarm's timer expires.
      *
      * @param[in] alarmKey - The alarm key
      */
@@ -194,11 +229,20 @@ class ShutdownAlarmMonitor
     sdbusplus::bus::match::match softShutdownMatch;
 
     /**
-     * @brief The map of alarms.
+     * @brief The map of alarms to the deadline of their timer, if
+     *        it was started.
+     */
+    std::map<AlarmKey, std::optional<Deadline>> alarms;
+
+    /**
+     * @brief The deadlines of the running timers, earliest first.
+     */
+    std::set<std::tuple<Deadline, AlarmKey>> deadlines;
+
+    /**
+     * @brief The timer for the earliest deadline.
      */
-    std::map<AlarmKey, std::unique_ptr<sdeventplus::utility::Timer<
-                           sdeventplus::ClockId::Monotonic>>>
-        alarms;
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> timer;
 
     /**
      * @brief The running alarm timer timestamps.
@@ -13,16 +13,22 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "config.h"
+
 #include "threshold_alarm_logger.hpp"
 
 #include "sdbusplus.hpp"
 
 #include <fmt/format.h>
+#include <systemd/sd-bus.h>
 #include <unistd.h>
 
 #include <phosphor-logging/log.hpp>
 #include <xyz/openbmc_project/Logging/Entry/server.hpp>
 
+#include <cstring>
+#include <set>
+
 namespace sensor::monitor
 {
 
@@ -42,7 +48,29 @@ constexpr auto loggingPath = "/xyz/openbmc_project/logging";
 constexpr auto loggingCreateIface = "xyz.openbmc_project.Logging.Create";
 constexpr auto errorNameBase = "xyz.openbmc_project.Sensor.Threshold.Error.";
 constexpr auto valueInterface = "xyz.openbmc_project.Sensor.Value";
-constexpr auto assocInterface = "xyz.openbmc_project.Association";
+constexpr auto mapperService = "xyz.openbmc_project.ObjectMapper";
+constexpr auto mapperPath = "/xyz/openbmc_project/object_mapper";
+constexpr auto mapperInterface = "xyz.openbmc_project.ObjectMapper";
+
+/* Most event logs that can be waiting to be created before the ones for
+ * alarms that already have one waiting are dropped */
+constexpr size_t maxPendingLogs = 256;
+
+/* Event logs created per event loop iteration, so signals are still
+ * handled in between when many alarms trip at once */
+constexpr size_t logsPerIteration = 8;
+
+/* How long to collect alarms for before creating their event logs,
+ * with 0 meaning each alarm is logged on its own right away */
+constexpr std::chrono::milliseconds aggregationWindow{
+    THRESHOLD_ALARM_AGGREGATION_WINDOW_MS};
+
+/* Fewest alarms with the same error name in a window that are
+ * reported with a summary event log */
+constexpr size_t minAggregatedAlarms = THRESHOLD_ALARM_AGGREGATION_MIN_ALARMS;
+
+/* If alarms reported with a summary event log still get their own */
+constexpr bool perSensorLogs = THRESHOLD_ALARM_PER_SENSOR_LOGS;
 
 using ErrorData = std::tuple<ErrorName, Entry::Level>;
 
@@ -82,9 +110,63 @@ const std::map<InterfaceName, std::map<PropertyName, std::map<bool, ErrorData>>>
             {false,
              ErrorData{"PerfLossLowClear", Entry::Level::Informational}}}}}}};
 
+namespace
+{
+
+/**
+ * @brief Handles the reply of an event log Create call
+ *
+ * @param[in] reply - The reply message
+ *
+ * @return 0 so the reply is considered handled
+ */
+int eventLogCreated(sd_bus_message* reply, void* /*userdata*/,
+                    sd_bus_error* /*error*/)
+{
+    if (sd_bus_message_is_method_error(reply, nullptr))
+    {
+        const auto* error = sd_bus_message_get_error(reply);
+        log<level::ERR>(
+            fmt::format("Failed to create threshold event log: {}",
+                        (error && error->message) ? error->message : "")
+                .c_str());
+    }
+    return 0;
+}
+
+/**
+ * @brief Finds the error data for an alarm value
+ *
+ * @param[in] interface - The threshold interface
+ * @param[in] alarmProperty - The alarm property name
+ * @param[in] alarmValue - The alarm value
+ *
+ * @return The error data, or nullptr if it isn't a threshold alarm
+ */
+const ErrorData* findErrorData(const std::string& interface,
+                               const std::string& alarmProperty,
+                               bool alarmValue)
+{
+    auto it = thresholdData.find(interface);
+    if (it == thresholdData.end())
+    {
+        return nullptr;
+    }
+
+    auto properties = it->second.find(alarmProperty);
+    if (properties == it->second.end())
+    {
+        return nullptr;
+    }
+
+    return &properties->second.at(alarmValue);
+}
+
+} // namespace
+
 ThresholdAlarmLogger::ThresholdAlarmLogger(
     sdbusplus::bus::bus& bus, sdeventplus::Event& event,
-    std::shared_ptr<PowerState> powerState) :
+    std::shared_ptr<PowerState> powerState, const AlarmSnapshot& snapshot) :
     bus(bus),
     event(event), _powerState(std::move(powerState)),
     warningMatch(bus,
@@ -112,27 +194,33 @@ ThresholdAlarmLogger::ThresholdAlarmLogger(
                        "type='signal',member='InterfacesRemoved',arg0path="
                        "'/xyz/openbmc_project/sensors/'",
                        std::bind(&ThresholdAlarmLogger::interfacesRemoved, this,
-                                 std::placeholders::_1))
+                                 std::placeholders::_1)),
+    associations(bus),
+    aggregationTimer(event,
+                     std::bind(&ThresholdAlarmLogger::aggregateEventLogs, this))
 {
     _powerState->addCallback("thresholdMon",
                              std::bind(&ThresholdAlarmLogger::powerStateChanged,
                                        this, std::placeholders::_1));
 
     // check for any currently asserted threshold alarms
-    std::for_each(
-        thresholdData.begin(), thresholdData.end(),
-        [this](const auto& thresholdInterface) {
-            const auto& interface = thresholdInterface.first;
-            auto objects =
-                SDBusPlus::getSubTreeRaw(this->bus, "/", interface, 0);
-            std::for_each(objects.begin(), objects.end(),
-                          [interface, this](const auto& object) {
-                              const auto& path = object.first;
-                              const auto& service =
-                                  object.second.begin()->first;
-                              checkThresholds(interface, path, service);
-                          });
-        });
+    for (const auto& [interface, properties] : thresholdData)
+    {
+        for (const auto& path : snapshot.getPaths(interface))
+        {
+            checkThresholds(interface, path, snapshot);
+        }
+    }
+}
+
+std::vector<std::string> ThresholdAlarmLogger::getInterfaces()
+{
+    std::vector<std::string> interfaces;
+    for (const auto& [interface, properties] : thresholdData)
+    {
+        interfaces.push_back(interface);
+    }
+    return interfaces;
 }
 
 void ThresholdAlarmLogger::propertiesChanged(sdbusplus::message::message& msg)
@@ -196,12 +284,16 @@ void ThresholdAlarmLogger::interfacesRemoved(sdbusplus::message::message& msg)
         {
             alarms.erase(InterfaceKey{path, interface});
         }
+        else if (interface == valueInterface)
+        {
+            valueServices.erase(path);
+        }
     }
 }
 
 void ThresholdAlarmLogger::checkThresholds(const std::string& interface,
                                            const std::string& sensorPath,
-                                           const std::string& service)
+                                           const AlarmSnapshot& snapshot)
 {
     auto properties = thresholdData.find(interface);
     if (properties == thresholdData.end())
@@ -211,26 +303,22 @@ void ThresholdAlarmLogger::checkThresholds(const std::string& interface,
 
     for (const auto& [property, unused] : properties->second)
     {
-        try
-        {
-            auto alarmValue = SDBusPlus::getProperty<bool>(
-                bus, service, sensorPath, interface, property);
-            alarms[InterfaceKey(sensorPath, interface)][property] = alarmValue;
-
-            // This is just for checking alarms on startup,
-            // so only look for active alarms.
-            if (alarmValue && _powerState->isPowerOn())
-            {
-                createEventLog(sensorPath, interface, property, alarmValue);
-            }
-        }
-        catch (const sdbusplus::exception::exception& e)
+        auto alarmValue = snapshot.getAlarm(sensorPath, interface, property);
+        if (!alarmValue)
         {
             // Sensor daemons that get their direction from entity manager
             // may only be putting either the high alarm or low alarm on
             // D-Bus, not both.
             continue;
         }
+        alarms[InterfaceKey(sensorPath, interface)][property] = *alarmValue;
+
+        // This is just for checking alarms on startup,
+        // so only look for active alarms.
+        if (*alarmValue && _powerState->isPowerOn())
+        {
+            createEventLog(sensorPath, interface, property, *alarmValue);
+        }
     }
 }
 
@@ -238,6 +326,187 @@ void ThresholdAlarmLogger::createEventLog(const std::string& sensorPath,
                                           const std::string& interface,
                                           const std::string& alarmProperty,
                                           bool alarmValue)
+{
+    PendingLog pendingLog{sensorPath, interface, alarmProperty, alarmValue};
+
+    if (aggregationWindow.count() == 0)
+    {
+        if (!coalesceEventLog(pendingLogs, pendingLog))
+        {
+            queueEventLog(std::move(pendingLog));
+        }
+        return;
+    }
+
+    if (!coalesceEventLog(windowLogs, pendingLog))
+    {
+        windowLogs.push_back(std::move(pendingLog));
+    }
+
+    if (!aggregationTimer.isEnabled())
+    {
+        aggregationTimer.restartOnce(aggregationWindow);
+    }
+}
+
+std::deque<ThresholdAlarmLogger::PendingLog>::const_reverse_iterator
+    ThresholdAlarmLogger::findQueuedLog(const std::deque<PendingLog>& logs,
+                                        const PendingLog& pendingLog)
+{
+    return std::find_if(logs.rbegin(), logs.rend(), [&](const auto& queued) {
+        return (queued.sensorPath == pendingLog.sensorPath) &&
+               (queued.interface == pendingLog.interface) &&
+               (queued.property == pendingLog.property);
+    });
+}
+
+bool ThresholdAlarmLogger::coalesceEventLog(const std::deque<PendingLog>& logs,
+                                            const PendingLog& pendingLog)
+{
+    // Only a repeat of the alarm's latest queued value is dropped, so a
+    // set followed by a clear still logs both
+    auto queued = findQueuedLog(logs, pendingLog);
+    return (queued != logs.rend()) && (queued->value == pendingLog.value);
+}
+
+void ThresholdAlarmLogger::queueEventLog(PendingLog&& pendingLog)
+{
+    // Every alarm can always queue an event log, as when many are
+    // found at startup, so only alarms that keep changing before their
+    // event logs are created can fill the queue
+    if ((pendingLogs.size() >= maxPendingLogs) &&
+        (findQueuedLog(pendingLogs, pendingLog) != pendingLogs.rend()))
+    {
+        if (droppedLogs++ == 0)
+        {
+            log<level::ERR>("Threshold event log queue is full, dropping "
+                            "event logs");
+        }
+        return;
+    }
+
+    pendingLogs.push_back(std::move(pendingLog));
+    if (!logSource)
+    {
+        logSource = std::make_unique<sdeventplus::source::Defer>(
+            event, std::bind(&ThresholdAlarmLogger::processEventLogs, this,
+                             std::placeholders::_1));
+    }
+}
+
+void ThresholdAlarmLogger::aggregateEventLogs()
+{
+    // The error name is made from the sensor type and the alarm,
+    // so alarms with the same one share a type and severity.
+    std::vector<std::optional<ErrorName>> errorNames;
+    std::map<ErrorName, std::vector<PendingLog>> groups;
+    for (const auto& windowLog : windowLogs)
+    {
+        auto type = getSensorType(windowLog.sensorPath);
+        const auto* errorData = findErrorData(
+            windowLog.interface, windowLog.property, windowLog.value);
+        if (skipSensorType(type) || !errorData)
+        {
+            errorNames.emplace_back(std::nullopt);
+            continue;
+        }
+
+        auto errorName = type + std::get<ErrorName>(*errorData);
+        groups[errorName].push_back(windowLog);
+        errorNames.emplace_back(std::move(errorName));
+    }
+
+    // Keep the window's order for the alarms logged individually
+    for (size_t i = 0; i < windowLogs.size(); i++)
+    {
+        if (!errorNames[i] ||
+            (groups[*errorNames[i]].size() < minAggregatedAlarms) ||
+            perSensorLogs)
+        {
+            queueEventLog(std::move(windowLogs[i]));
+        }
+    }
+    windowLogs.clear();
+
+    for (const auto& [errorName, logs] : groups)
+    {
+        if (logs.size() >= minAggregatedAlarms)
+        {
+            commitSummaryLog(logs);
+        }
+    }
+}
+
+void ThresholdAlarmLogger::commitSummaryLog(const std::vector<PendingLog>& logs)
+{
+    const auto& first = logs.front();
+    const auto* errorData =
+        findErrorData(first.interface, first.property, first.value);
+    const auto& [name, severity] = *errorData;
+    auto type = getSensorType(first.sensorPath);
+    type.front() = toupper(type.front());
+    std::string errorName = errorNameBase + type + name;
+
+    std::string sensors;
+    std::set<std::string> callouts;
+    for (const auto& pendingLog : logs)
+    {
+        if (!sensors.empty())
+        {
+            sensors += ' ';
+        }
+        sensors += pendingLog.sensorPath;
+        callouts.insert(associations.getCallout(pendingLog.sensorPath));
+    }
+
+    std::map<std::string, std::string> ad;
+    ad.emplace("SENSOR_NAME", first.sensorPath);
+    ad.emplace("SENSOR_COUNT", std::to_string(logs.size()));
+    ad.emplace("SENSORS", sensors);
+    ad.emplace("_PID", std::to_string(getpid()));
+
+    // Only call out a FRU if it's the one behind all of the sensors
+    if ((callouts.size() == 1) && !callouts.begin()->empty())
+    {
+        ad.emplace("CALLOUT_INVENTORY_PATH", *callouts.begin());
+    }
+
+    log<level::INFO>(fmt::format("Threshold Event {} {} = {} on {} sensors",
+                                 type, first.property, first.value,
+                                 logs.size())
+                         .c_str());
+
+    sendEventLog(errorName, convertForMessage(severity), ad);
+}
+
+void ThresholdAlarmLogger::processEventLogs(
+    sdeventplus::source::EventBase& /*source*/)
+{
+    for (size_t i = 0; (i < logsPerIteration) && !pendingLogs.empty(); i++)
+    {
+        auto pendingLog = std::move(pendingLogs.front());
+        pendingLogs.pop_front();
+        commitEventLog(pendingLog.sensorPath, pendingLog.interface,
+                       pendingLog.property, pendingLog.value);
+    }
+
+    if (pendingLogs.empty())
+    {
+        if (droppedLogs != 0)
+        {
+            log<level::ERR>(
+                fmt::format("Dropped {} threshold event logs", droppedLogs)
+                    .c_str());
+            droppedLogs = 0;
+        }
+        logSource.reset();
+    }
+}
+
+void ThresholdAlarmLogger::commitEventLog(const std::string& sensorPath,
+                                          const std::string& interface,
+                                          const std::string& alarmProperty,
+                                          bool alarmValue)
 {
     std::map<std::string, std::string> ad;
 
@@ -266,30 +535,7 @@ void ThresholdAlarmLogger::createEventLog(const std::string& sensorPath,
     ad.emplace("SENSOR_NAME", sensorPath);
     ad.emplace("_PID", std::to_string(getpid()));
 
-    try
-    {
-        auto sensorValue = SDBusPlus::getProperty<double>(
-            bus, sensorPath, valueInterface, "Value");
-
-        ad.emplace("SENSOR_VALUE", std::to_string(sensorValue));
-
-        log<level::INFO>(
-            fmt::format("Threshold Event {} {} = {} (sensor value {})",
-                        sensorPath, alarmProperty, alarmValue, sensorValue)
-                .c_str());
-    }
-    catch (const DBusServiceError& e)
-    {
-        // If the sensor was just added, the Value interface for it may
-        // not be in the mapper yet.  This could only happen if the sensor
-        // application was started up after this one and the value exceeded the
-        // threshold immediately.
-        log<level::INFO>(fmt::format("Threshold Event {} {} = {}", sensorPath,
-                                     alarmProperty, alarmValue)
-                             .c_str());
-    }
-
-    auto callout = getCallout(sensorPath);
+    auto callout = associations.getCallout(sensorPath);
     if (!callout.empty())
     {
         ad.emplace("CALLOUT_INVENTORY_PATH", callout);
@@ -304,8 +550,152 @@ void ThresholdAlarmLogger::createEventLog(const std::string& sensorPath,
     type.front() = toupper(type.front());
     std::string errorName = errorNameBase + type + name;
 
-    SDBusPlus::callMethod(loggingService, loggingPath, loggingCreateIface,
-                          "Create", errorName, convertForMessage(severity), ad);
+    // The event log is sent once the sensor value has been read
+    getSensorValue(
+        sensorPath,
+        [this, sensorPath, alarmProperty, alarmValue, errorName,
+         severity = convertForMessage(severity),
+         ad = std::move(ad)](std::optional<double> sensorValue) mutable {
+            if (sensorValue)
+            {
+                ad.emplace("SENSOR_VALUE", std::to_string(*sensorValue));
+
+                log<level::INFO>(
+                    fmt::format("Threshold Event {} {} = {} (sensor value {})",
+                                sensorPath, alarmProperty, alarmValue,
+                                *sensorValue)
+                        .c_str());
+            }
+            else
+            {
+                log<level::INFO>(fmt::format("Threshold Event {} {} = {}",
+                                             sensorPath, alarmProperty,
+                                             alarmValue)
+                                     .c_str());
+            }
+
+            sendEventLog(errorName, severity, ad);
+        });
+}
+
+void ThresholdAlarmLogger::sendEventLog(
+    const std::string& errorName, const std::string& severity,
+    const std::map<std::string, std::string>& ad)
+{
+    auto msg = bus.new_method_call(loggingService, loggingPath,
+                                   loggingCreateIface, "Create");
+    msg.append(errorName, severity, ad);
+
+    // The reply is handled by eventLogCreated, so don't wait on it here
+    auto rc = sd_bus_call_async(bus.get(), nullptr, msg.get(), eventLogCreated,
+                                nullptr, 0);
+    if (rc < 0)
+    {
+        log<level::ERR>(fmt::format("Failed to send {} event log for {}: {}",
+                                    errorName, ad.at("SENSOR_NAME"),
+                                    strerror(-rc))
+                            .c_str());
+    }
+}
+
+void ThresholdAlarmLogger::getSensorValue(const std::string& sensorPath,
+                                          ValueCallback&& callback)
+{
+    auto read = std::make_unique<ValueRead>(
+        ValueRead{this, sensorPath, std::move(callback)});
+
+    int rc = 0;
+    auto service = valueServices.find(sensorPath);
+    if (service == valueServices.end())
+    {
+        auto msg = bus.new_method_call(mapperService, mapperPath,
+                                       mapperInterface, "GetObject");
+        msg.append(sensorPath, std::vector<std::string>{valueInterface});
+        rc = sd_bus_call_async(bus.get(), nullptr, msg.get(),
+                               valueServiceFound, read.get(), 0);
+    }
+    else
+    {
+        auto msg = bus.new_method_call(
+            service->second.c_str(), sensorPath.c_str(),
+            "org.freedesktop.DBus.Properties", "Get");
+        msg.append(valueInterface, "Value");
+        rc = sd_bus_call_async(bus.get(), nullptr, msg.get(), sensorValueRead,
+                               read.get(), 0);
+    }
+
+    if (rc < 0)
+    {
+        read->callback(std::nullopt);
+        return;
+    }
+
+    // Now owned by the reply handler
+    read.release();
+}
+
+int ThresholdAlarmLogger::valueServiceFound(sd_bus_message* reply,
+                                            void* userdata,
+                                            sd_bus_error* /*error*/)
+{
+    std::unique_ptr<ValueRead> read{static_cast<ValueRead*>(userdata)};
+
+    // If the sensor was just added, the Value interface for it may
+    // not be in the mapper yet.  This could only happen if the sensor
+    // application was started up after this one and the value exceeded the
+    // threshold immediately.
+    std::map<std::string, std::vector<std::string>> services;
+    if (!sd_bus_message_is_method_error(reply, nullptr))
+    {
+        try
+        {
+            sdbusplus::message::message msg{reply};
+            msg.read(services);
+        }
+        catch (const std::exception& e)
+        {
+            services.clear();
+        }
+    }
+
+    if (services.empty())
+    {
+        read->callback(std::nullopt);
+        return 0;
+    }
+
+    read->logger->valueServices[read->sensorPath] = services.begin()->first;
+    read->logger->getSensorValue(read->sensorPath, std::move(read->callback));
+    return 0;
+}
+
+int ThresholdAlarmLogger::sensorValueRead(sd_bus_message* reply,
+                                          void* userdata,
+                                          sd_bus_error* /*error*/)
+{
+    std::unique_ptr<ValueRead> read{static_cast<ValueRead*>(userdata)};
+
+    std::optional<double> value;
+    if (!sd_bus_message_is_method_error(reply, nullptr))
+    {
+        try
+        {
+            sdbusplus::message::message msg{reply};
+            std::variant<double> variant;
+            msg.read(variant);
+            value = std::get<double>(variant);
+        }
+        catch (const std::exception& e)
+        {}
+    }
+
+    if (!value)
+    {
+        // Look the service up again next time, in case it changed
+        read->logger->valueServices.erase(read->sensorPath);
+    }
+    read->callback(value);
+    return 0;
 }
 
 std::string ThresholdAlarmLogger::getSensorType(std::string sensorPath)
@@ -329,41 +719,6 @@ bool ThresholdAlarmLogger::skipSensorType(const std::string& type)
     return (type == "utilization");
 }
 
-std::string ThresholdAlarmLogger::getCallout(const std::string& sensorPath)
-{
-    const std::array<std::string, 2> assocTypes{"inventory", "chassis"};
-
-    // Different implementations handle the association to the FRU
-    // differently:
-    //  * phosphor-inventory-manager uses the 'inventory' association
-    //    to point to the FRU.
-    //  * dbus-sensors/entity-manager uses the 'chassis' association'.
-    //  * For virtual sensors, no association.
-
-    for (const auto& assocType : assocTypes)
-    {
-        auto assocPath = sensorPath + "/" + assocType;
-
-        try
-        {
-            auto endpoints = SDBusPlus::getProperty<std::vector<std::string>>(
-                bus, assocPath, assocInterface, "endpoints");
-
-            if (!endpoints.empty())
-            {
-                return endpoints[0];
-            }
-        }
-        catch (const DBusServiceError& e)
-        {
-            // The association doesn't exist
-            continue;
-        }
-    }
-
-    return std::string{};
-}
-
 void ThresholdAlarmLogger::powerStateChanged(bool powerStateOn)
 {
     if (powerStateOn)
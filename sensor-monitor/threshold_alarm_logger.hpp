@@ -15,11 +15,21 @@
  */
 #pragma once
 
+#include "alarm_snapshot.hpp"
+#include "association_cache.hpp"
 #include "power_state.hpp"
 
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/bus/match.hpp>
 #include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
 
 namespace sensor::monitor
 {
@@ -46,6 +56,13 @@ using InterfaceKey = std::tuple<ObjectPath, InterfaceName>;
  * xyz.openbmc_project.Sensor.Threshold.Error.TemperatureWarningHighClear
  *
  * Event logs are only created when the power is on.
+ *
+ * When an aggregation window is configured, alarms are collected for
+ * the length of the window first.  Alarms that have the same error name,
+ * and so the same sensor type and severity, are then reported with a
+ * single summary event log listing all of the sensors as long as there
+ * are enough of them, which keeps an alarm storm from creating an event
+ * log per sensor.
  */
 class ThresholdAlarmLogger
 {
@@ -65,9 +82,18 @@ class ThresholdAlarmLogger
      * @param[in] bus - The sdbusplus bus object
      * @param[in] event - The sdeventplus event object
      * @param[in] powerState - The PowerState object
+     * @param[in] snapshot - Snapshot of the current alarm values
      */
     ThresholdAlarmLogger(sdbusplus::bus::bus& bus, sdeventplus::Event& event,
-                         std::shared_ptr<phosphor::fan::PowerState> powerState);
+                         std::shared_ptr<phosphor::fan::PowerState> powerState,
+                         const AlarmSnapshot& snapshot);
+
+    /**
+     * @brief Get the threshold interfaces monitored
+     *
+     * @return The interface names
+     */
+    static std::vector<std::string> getInterfaces();
 
   private:
     /**
@@ -96,11 +122,11 @@ class ThresholdAlarmLogger
      *
      * @param[in] interface - The threshold interface
      * @param[in] sensorPath - The sensor D-Bus path
-     * @param[in] service - The D-Bus service that owns the interface
+     * @param[in] snapshot - Snapshot of the current alarm values
      */
     void checkThresholds(const std::string& interface,
                          const std::string& sensorPath,
-                         const std::string& service);
+                         const AlarmSnapshot& snapshot);
 
     /**
      * @brief Checks for all active alarms on all existing
@@ -110,7 +136,12 @@ class ThresholdAlarmLogger
     void checkThresholds();
 
     /**
-     * @brief Creates an event log for the alarm set/clear
+     * @brief Queues an event log for the alarm set/clear to be
+     *        created from the event loop.
+     *
+     * If the alarm already has an event log queued, a repeat of the
+     * same value is dropped, while the opposite value is queued after it
+     * so both transitions are logged.
      *
      * @param[in] sensorPath - The sensor object path
      * @param[in] interface - The threshold interface
@@ -121,6 +152,153 @@ class ThresholdAlarmLogger
                         const std::string& interface,
                         const std::string& alarmProperty, bool alarmValue);
 
+    /**
+     * @brief An event log waiting to be created
+     */
+    struct PendingLog
+    {
+        ObjectPath sensorPath;
+        InterfaceName interface;
+        PropertyName property;
+        bool value;
+    };
+
+    /**
+     * @brief Finds the latest event log queued for the same alarm as
+     *        a new one.
+     *
+     * @param[in] logs - The queued event logs
+     * @param[in] pendingLog - The new event log
+     *
+     * @return The queued event log, or logs.rend() if there isn't one
+     */
+    static std::deque<PendingLog>::const_reverse_iterator
+        findQueuedLog(const std::deque<PendingLog>& logs,
+                      const PendingLog& pendingLog);
+
+    /**
+     * @brief Coalesces an alarm set/clear with the latest one queued
+     *        for the same alarm, if it's for the same value.
+     *
+     * @param[in] logs - The queued event logs
+     * @param[in] pendingLog - The new event log
+     *
+     * @return If the new event log was coalesced and shouldn't be queued
+     */
+    static bool coalesceEventLog(const std::deque<PendingLog>& logs,
+                                 const PendingLog& pendingLog);
+
+    /**
+     * @brief Queues an event log to be created, and starts the event
+     *        source that creates them if necessary.
+     *
+     * Drops the event log if the queue is full and the alarm already
+     * has an event log queued.
+     *
+     * @param[in] pendingLog - The event log
+     */
+    void queueEventLog(PendingLog&& pendingLog);
+
+    /**
+     * @brief Handles the end of the aggregation window.
+     *
+     * Creates a summary event log for each group of alarms with the same
+     * error name that is large enough, and queues the others to be
+     * created individually.
+     */
+    void aggregateEventLogs();
+
+    /**
+     * @brief Creates a summary event log listing the sensors of alarms
+     *        with the same error name.
+     *
+     * @param[in] logs - The alarm sets/clears to summarize
+     */
+    void commitSummaryLog(const std::vector<PendingLog>& logs);
+
+    /**
+     * @brief Creates a batch of the queued event logs, stopping
+     *        the event source once the queue is empty.
+     *
+     * @param[in] source - The event source
+     */
+    void processEventLogs(sdeventplus::source::EventBase& source);
+
+    /**
+     * @brief Creates an event log for the alarm set/clear without
+     *        waiting for the sensor value to be read or for the
+     *        logging service to reply.
+     *
+     * @param[in] sensorPath - The sensor object path
+     * @param[in] interface - The threshold interface
+     * @param[in] alarmProperty - The alarm property name
+     * @param[in] alarmValue - The alarm value
+     */
+    void commitEventLog(const std::string& sensorPath,
+                        const std::string& interface,
+                        const std::string& alarmProperty, bool alarmValue);
+
+    /**
+     * @brief Sends the event log Create call without waiting for
+     *        the logging service to reply.
+     *
+     * @param[in] errorName - The error name
+     * @param[in] severity - The severity, as a D-Bus string
+     * @param[in] ad - The additional data
+     */
+    void sendEventLog(const std::string& errorName, const std::string& severity,
+                      const std::map<std::string, std::string>& ad);
+
+    /**
+     * @brief Called with a sensor's value, or std::nullopt if it
+     *        couldn't be read
+     */
+    using ValueCallback = std::function<void(std::optional<double>)>;
+
+    /**
+     * @brief A sensor value read waiting on a reply
+     */
+    struct ValueRead
+    {
+        ThresholdAlarmLogger* logger;
+        ObjectPath sensorPath;
+        ValueCallback callback;
+    };
+
+    /**
+     * @brief Reads the current value of a sensor without waiting on
+     *        the reply, first looking up the service providing it
+     *        when that isn't known yet.
+     *
+     * @param[in] sensorPath - The sensor object path
+     * @param[in] callback - Called with the value once it's read
+     */
+    void getSensorValue(const std::string& sensorPath,
+                        ValueCallback&& callback);
+
+    /**
+     * @brief Handles the reply of the mapper GetObject call for the
+     *        service providing a sensor's value, then reads the value.
+     *
+     * @param[in] reply - The reply message
+     * @param[in] userdata - The ValueRead, owned by the handler
+     *
+     * @return 0 so the reply is considered handled
+     */
+    static int valueServiceFound(sd_bus_message* reply, void* userdata,
+                                 sd_bus_error* error);
+
+    /**
+     * @brief Handles the reply of the Get call for a sensor's value.
+     *
+     * @param[in] reply - The reply message
+     * @param[in] userdata - The ValueRead, owned by the handler
+     *
+     * @return 0 so the reply is considered handled
+     */
+    static int sensorValueRead(sd_bus_message* reply, void* userdata,
+                               sd_bus_error* error);
+
     /**
      * @brief Returns the type of the sensor using the path segment
      *        that precedes the sensor name.
@@ -144,19 +322,6 @@ class ThresholdAlarmLogger
      */
     bool skipSensorType(const std::string& type);
 
-    /**
-     * @brief Returns the inventory path to use for a FRU callout
-     *        for the alarm exceeded errors.
-     *
-     * It finds the path by looking for 'inventory' or 'chassis'
-     * association objects on the sensor that point to a FRU.
-     *
-     * @param[in] std::string - The sensor object path
-     * @return std::string - The inventory path for the FRU callout.
-     *                       May be empty if none found.
-     */
-    std::string getCallout(const std::string& sensorPath);
-
     /**
      * @brief The power state changed handler.
      *
@@ -205,6 +370,43 @@ class ThresholdAlarmLogger
      * @brief The current alarm values
      */
     std::map<InterfaceKey, std::map<PropertyName, bool>> alarms;
+
+    /**
+     * @brief The sensors' FRU callout associations
+     */
+    AssociationCache associations;
+
+    /**
+     * @brief Map of sensor paths to the service providing their value
+     */
+    std::map<ObjectPath, std::string> valueServices;
+
+    /**
+     * @brief The alarm sets/clears collected in the current
+     *        aggregation window, oldest first
+     */
+    std::deque<PendingLog> windowLogs;
+
+    /**
+     * @brief The timer ending the aggregation window
+     */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>
+        aggregationTimer;
+
+    /**
+     * @brief The event logs waiting to be created, oldest first
+     */
+    std::deque<PendingLog> pendingLogs;
+
+    /**
+     * @brief Number of event logs dropped since the queue was full
+     */
+    size_t droppedLogs = 0;
+
+    /**
+     * @brief The event source creating the queued event logs
+     */
+    std::unique_ptr<sdeventplus::source::Defer> logSource;
 };
 
 } // namespace sensor::monitor